@@ -0,0 +1,98 @@
+#include "AsyncGame.hpp"
+#include "Random.hpp"
+
+AsyncGame::AsyncGame(const std::array<AsyncPlayer *, num_players> &players, int points_to_win,
+                     uint64_t seed, std::ostream &os)
+    : players(players), points({0, 0}), points_to_win(points_to_win), seed(seed), os(os),
+      hand_number(0), dealer(0), hand([this](const PlayerEvent &event) { notify(event); })
+{
+    for (int i = 0; i < num_players; i++)
+    {
+        names[i] = players[i]->get_name();
+    }
+    hand.narrate(os, names);
+}
+
+Task<Team_Number> AsyncGame::play()
+{
+    while (points[0] < points_to_win && points[1] < points_to_win)
+    {
+        os << "Hand " << hand_number << std::endl;
+        co_await play_hand();
+        os << team_names(0) << " have " << points[0] << " points" << std::endl;
+        os << team_names(1) << " have " << points[1] << " points" << std::endl;
+        os << std::endl;
+
+        hand_number++;
+        dealer = (dealer + 1) % num_players;
+    }
+
+    const Team_Number winner = points[0] >= points_to_win ? TEAM_ZERO_AND_TWO : TEAM_ONE_AND_THREE;
+    os << team_names(winner) << " win!" << std::endl;
+    co_return winner;
+}
+
+int AsyncGame::get_points(Team_Number team) const
+{
+    return points[team];
+}
+
+std::string AsyncGame::team_names(int team) const
+{
+    return players[team]->get_name() + " and " + players[team + 2]->get_name();
+}
+
+void AsyncGame::notify(const PlayerEvent &event)
+{
+    for (AsyncPlayer *player : players)
+    {
+        player->observe(event);
+    }
+}
+
+Task<void> AsyncGame::play_turn()
+{
+    const int seat = hand.to_act();
+    AsyncPlayer *player = players[seat];
+    const Card upcard = hand.get_upcard();
+    if (hand.get_phase() == Hand::BID)
+    {
+        Bid bid = co_await player->make_trump(upcard, seat == dealer, hand.get_round());
+        hand.bid(bid.order_up, bid.suit);
+    }
+    else if (hand.get_phase() == Hand::DISCARD)
+    {
+        // dealer picks up upcard and discards a card
+        co_await player->add_and_discard(upcard);
+        hand.discard();
+    }
+    else if (hand.get_num_in_trick() == 0)
+    {
+        hand.play(co_await player->lead_card(hand.get_trump()));
+    }
+    else
+    {
+        hand.play(co_await player->play_card(hand.get_led_card(), hand.get_trump()));
+    }
+}
+
+Task<void> AsyncGame::play_hand()
+{
+    pack.shuffle(derive_seed(seed, hand_number));
+    Hand::Deal cards;
+    const Card upcard = Hand::deal(pack, dealer, cards);
+    for (int i = 0; i < num_players; i++)
+    {
+        for (const Card &card : cards[i])
+        {
+            players[i]->add_card(card);
+        }
+    }
+
+    hand.start(dealer, upcard);
+    while (hand.get_phase() != Hand::OVER)
+    {
+        co_await play_turn();
+    }
+    hand.score(points);
+}
@@ -0,0 +1,61 @@
+#ifndef ASYNCGAME_HPP
+#define ASYNCGAME_HPP
+/* AsyncGame.hpp
+ *
+ * A game of euchre played as a coroutine over AsyncPlayers.  While a
+ * player is waiting for a decision the game is suspended, so one thread
+ * can run many games by resuming whichever ones are ready.
+ */
+
+#include <array>
+#include <cstdint>
+#include <iostream>
+#include "AsyncPlayer.hpp"
+#include "Game.hpp"
+#include "Hand.hpp"
+#include "Pack.hpp"
+#include "Task.hpp"
+
+class AsyncGame
+{
+public:
+    static const int num_players = 4;
+    static const int num_teams = 2;
+
+    // EFFECTS: Creates a game between players, which are not owned by the
+    //          game.  Each hand is dealt from a random shuffle drawn from
+    //          seed, as Game::use_random_shuffle does.  Output goes to os.
+    AsyncGame(const std::array<AsyncPlayer *, num_players> &players, int points_to_win,
+              uint64_t seed, std::ostream &os);
+
+    // EFFECTS: Plays hands until one team has points_to_win or more
+    //          points.  Returns the winning team.
+    Task<Team_Number> play();
+
+    // EFFECTS: returns the points team has so far
+    int get_points(Team_Number team) const;
+
+private:
+    std::array<AsyncPlayer *, num_players> players;
+    std::array<std::string, num_players> names;
+    std::array<int, num_teams> points;
+    Pack pack;
+    const int points_to_win;
+    const uint64_t seed;
+    std::ostream &os;
+    int hand_number;
+    int dealer;
+    Hand hand;
+
+    std::string team_names(int team) const;
+
+    // EFFECTS: shows event to every player
+    void notify(const PlayerEvent &event);
+
+    // EFFECTS: asks the player whose turn it is for the hand's next decision
+    Task<void> play_turn();
+
+    Task<void> play_hand();
+};
+
+#endif // ASYNCGAME_HPP
@@ -0,0 +1,103 @@
+#include "AsyncGame.hpp"
+#include "unit_test_framework.hpp"
+
+#include <memory>
+#include <sstream>
+
+using namespace std;
+
+static const array<string, 4> NAMES = {"Edsger", "Fran", "Gabriel", "Herb"};
+
+TEST(test_async_game_matches_game) {
+    array<unique_ptr<AsyncPlayer>, 4> owned;
+    array<AsyncPlayer *, 4> players;
+    for (int i = 0; i < 4; i++) {
+        owned[i].reset(new SyncPlayerAdapter(Player_factory(NAMES[i], "Simple")));
+        players[i] = owned[i].get();
+    }
+    ostringstream async_output;
+    AsyncGame async_game(players, 10, 3, async_output);
+    Task<Team_Number> task = async_game.play();
+    task.start();
+    ASSERT_TRUE(task.done());
+
+    istringstream no_pack;
+    ostringstream game_output;
+    Game game(no_pack, false, 10, NAMES, {"Simple", "Simple", "Simple", "Simple"}, game_output);
+    game.use_random_shuffle(3);
+    ASSERT_EQUAL(task.result(), game.play());
+    ASSERT_EQUAL(async_output.str(), game_output.str());
+}
+
+// EFFECTS: answers a remote player's pending decision with a legal move
+static void answer(RemotePlayer &player) {
+    const vector<Card> &hand = player.get_hand();
+    switch (player.pending()) {
+    case RemotePlayer::BID: {
+        Bid bid;
+        bid.order_up = player.get_round() == 2 && player.get_is_dealer();
+        bid.suit = Suit_next(player.get_upcard().get_suit());
+        player.answer_bid(bid);
+        break;
+    }
+    case RemotePlayer::DISCARD:
+        player.answer_card(player.get_upcard());
+        break;
+    case RemotePlayer::LEAD:
+        player.answer_card(hand[0]);
+        break;
+    case RemotePlayer::PLAY: {
+        Suit led = player.get_led_card().get_suit(player.get_trump());
+        Card choice = hand[0];
+        for (const Card &card : hand) {
+            if (card.get_suit(player.get_trump()) == led) {
+                choice = card;
+            }
+        }
+        player.answer_card(choice);
+        break;
+    }
+    case RemotePlayer::NONE:
+        break;
+    }
+}
+
+TEST(test_async_games_multiplexed_on_one_thread) {
+    const int NUM_TABLES = 1000;
+    Scheduler scheduler;
+    vector<unique_ptr<RemotePlayer>> remotes;
+    vector<unique_ptr<AsyncPlayer>> bots;
+    vector<unique_ptr<AsyncGame>> games;
+    vector<Task<Team_Number>> tasks;
+    ostream quiet(nullptr);
+
+    for (int t = 0; t < NUM_TABLES; t++) {
+        remotes.emplace_back(new RemotePlayer("Remote", scheduler));
+        array<AsyncPlayer *, 4> players = {remotes.back().get()};
+        for (int seat = 1; seat < 4; seat++) {
+            bots.emplace_back(new SyncPlayerAdapter(Player_factory(NAMES[seat], "Simple")));
+            players[seat] = bots.back().get();
+        }
+        games.emplace_back(new AsyncGame(players, 5, t, quiet));
+        tasks.push_back(games.back()->play());
+        tasks.back().start();
+    }
+
+    // every game is suspended on its remote player until answered
+    int finished = 0;
+    for (int rounds = 0; finished < NUM_TABLES && rounds < 100000; rounds++) {
+        finished = 0;
+        for (int t = 0; t < NUM_TABLES; t++) {
+            answer(*remotes[t]);
+            finished += tasks[t].done();
+        }
+        scheduler.run();
+    }
+    ASSERT_EQUAL(finished, NUM_TABLES);
+    for (int t = 0; t < NUM_TABLES; t++) {
+        Team_Number winner = tasks[t].result();
+        ASSERT_TRUE(games[t]->get_points(winner) >= 5);
+    }
+}
+
+TEST_MAIN()
@@ -0,0 +1,150 @@
+#include "AsyncPlayer.hpp"
+#include <algorithm>
+#include <cassert>
+
+SyncPlayerAdapter::SyncPlayerAdapter(Player *player) : player(player) {}
+
+const std::string &SyncPlayerAdapter::get_name() const
+{
+    return player->get_name();
+}
+
+void SyncPlayerAdapter::add_card(const Card &c)
+{
+    player->add_card(c);
+}
+
+Task<Bid> SyncPlayerAdapter::make_trump(Card upcard, bool is_dealer, int round)
+{
+    Bid bid;
+    bid.order_up = player->make_trump(upcard, is_dealer, round, bid.suit);
+    co_return bid;
+}
+
+Task<void> SyncPlayerAdapter::add_and_discard(Card upcard)
+{
+    player->add_and_discard(upcard);
+    co_return;
+}
+
+Task<Card> SyncPlayerAdapter::lead_card(Suit trump)
+{
+    co_return player->lead_card(trump);
+}
+
+Task<Card> SyncPlayerAdapter::play_card(Card led_card, Suit trump)
+{
+    co_return player->play_card(led_card, trump);
+}
+
+void SyncPlayerAdapter::observe(const PlayerEvent &event)
+{
+    player->observe(event);
+}
+
+RemotePlayer::RemotePlayer(const std::string &name, Scheduler &scheduler)
+    : name(name), request(NONE), is_dealer(false), round(0), trump(SPADES),
+      bid_decision(scheduler), card_decision(scheduler) {}
+
+RemotePlayer::Request RemotePlayer::pending() const
+{
+    return request;
+}
+
+const std::vector<Card> &RemotePlayer::get_hand() const
+{
+    return hand;
+}
+
+Card RemotePlayer::get_upcard() const
+{
+    return upcard;
+}
+
+bool RemotePlayer::get_is_dealer() const
+{
+    return is_dealer;
+}
+
+int RemotePlayer::get_round() const
+{
+    return round;
+}
+
+Card RemotePlayer::get_led_card() const
+{
+    return led_card;
+}
+
+Suit RemotePlayer::get_trump() const
+{
+    return trump;
+}
+
+void RemotePlayer::answer_bid(Bid bid)
+{
+    assert(request == BID);
+    request = NONE;
+    bid_decision.resolve(bid);
+}
+
+void RemotePlayer::answer_card(const Card &card)
+{
+    assert(request == DISCARD || request == LEAD || request == PLAY);
+    request = NONE;
+    card_decision.resolve(card);
+}
+
+const std::string &RemotePlayer::get_name() const
+{
+    return name;
+}
+
+void RemotePlayer::add_card(const Card &c)
+{
+    hand.push_back(c);
+}
+
+Task<Bid> RemotePlayer::make_trump(Card upcard_in, bool is_dealer_in, int round_in)
+{
+    upcard = upcard_in;
+    is_dealer = is_dealer_in;
+    round = round_in;
+    request = BID;
+    co_return co_await bid_decision;
+}
+
+Task<void> RemotePlayer::add_and_discard(Card upcard_in)
+{
+    upcard = upcard_in;
+    hand.push_back(upcard);
+    request = DISCARD;
+    Card discard = co_await card_decision;
+    remove_card(discard);
+}
+
+Task<Card> RemotePlayer::lead_card(Suit trump_in)
+{
+    trump = trump_in;
+    request = LEAD;
+    Card card = co_await card_decision;
+    remove_card(card);
+    co_return card;
+}
+
+Task<Card> RemotePlayer::play_card(Card led_card_in, Suit trump_in)
+{
+    led_card = led_card_in;
+    trump = trump_in;
+    request = PLAY;
+    Card card = co_await card_decision;
+    remove_card(card);
+    co_return card;
+}
+
+void RemotePlayer::remove_card(const Card &card)
+{
+    auto found = std::find(hand.begin(), hand.end(), card);
+    assert(found != hand.end());
+    hand.erase(found);
+}
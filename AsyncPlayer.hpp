@@ -0,0 +1,137 @@
+#ifndef ASYNCPLAYER_HPP
+#define ASYNCPLAYER_HPP
+/* AsyncPlayer.hpp
+ *
+ * Euchre player interface whose decisions are coroutines, so a player
+ * waiting on I/O or a remote decision suspends its game instead of
+ * blocking the thread.
+ */
+
+#include <memory>
+#include <string>
+#include <vector>
+#include "Card.hpp"
+#include "Player.hpp"
+#include "Task.hpp"
+
+// Result of a bidding decision
+struct Bid
+{
+    bool order_up = false;
+    Suit suit = SPADES;
+};
+
+class AsyncPlayer
+{
+public:
+    //EFFECTS returns player's name
+    virtual const std::string & get_name() const = 0;
+
+    //REQUIRES player has less than MAX_HAND_SIZE cards
+    //EFFECTS  adds Card c to Player's hand
+    virtual void add_card(const Card &c) = 0;
+
+    //REQUIRES round is 1 or 2
+    //EFFECTS  Returns whether the player orders up, and which suit
+    virtual Task<Bid> make_trump(Card upcard, bool is_dealer, int round) = 0;
+
+    //REQUIRES Player has at least one card
+    //EFFECTS  Player adds one card to hand and removes one card from hand.
+    virtual Task<void> add_and_discard(Card upcard) = 0;
+
+    //REQUIRES Player has at least one card
+    //EFFECTS  Leads one Card from Player's hand.  The card is removed.
+    virtual Task<Card> lead_card(Suit trump) = 0;
+
+    //REQUIRES Player has at least one card
+    //EFFECTS  Plays one Card from Player's hand.  The card is removed.
+    virtual Task<Card> play_card(Card led_card, Suit trump) = 0;
+
+    //EFFECTS  Tells the player about a public event in the hand
+    virtual void observe(const PlayerEvent &event) {}
+
+    virtual ~AsyncPlayer() {}
+};
+
+// Runs a synchronous Player through the asynchronous interface.  Each
+// decision completes without suspending.
+class SyncPlayerAdapter : public AsyncPlayer
+{
+public:
+    // EFFECTS: Adapts player and takes ownership of it
+    explicit SyncPlayerAdapter(Player *player);
+
+    const std::string & get_name() const override;
+    void add_card(const Card &c) override;
+    Task<Bid> make_trump(Card upcard, bool is_dealer, int round) override;
+    Task<void> add_and_discard(Card upcard) override;
+    Task<Card> lead_card(Suit trump) override;
+    Task<Card> play_card(Card led_card, Suit trump) override;
+    void observe(const PlayerEvent &event) override;
+
+private:
+    std::unique_ptr<Player> player;
+};
+
+// Player whose decisions are supplied from outside the game, for example
+// by a client over the network.  Each decision suspends the game until
+// the matching answer_ function is called.
+class RemotePlayer : public AsyncPlayer
+{
+public:
+    enum Request
+    {
+        NONE,
+        BID,
+        DISCARD,
+        LEAD,
+        PLAY,
+    };
+
+    // EFFECTS: Creates a player whose game resumes on scheduler
+    RemotePlayer(const std::string &name, Scheduler &scheduler);
+
+    // EFFECTS: returns the decision the game is waiting for, if any
+    Request pending() const;
+
+    // EFFECTS: returns the cards in the player's hand
+    const std::vector<Card> & get_hand() const;
+
+    // Context of the pending request
+    Card get_upcard() const;
+    bool get_is_dealer() const;
+    int get_round() const;
+    Card get_led_card() const;
+    Suit get_trump() const;
+
+    // REQUIRES: pending() == BID
+    void answer_bid(Bid bid);
+
+    // REQUIRES: pending() is DISCARD, LEAD or PLAY and card is in the hand
+    //           (for DISCARD, card may also be the upcard)
+    void answer_card(const Card &card);
+
+    const std::string & get_name() const override;
+    void add_card(const Card &c) override;
+    Task<Bid> make_trump(Card upcard, bool is_dealer, int round) override;
+    Task<void> add_and_discard(Card upcard) override;
+    Task<Card> lead_card(Suit trump) override;
+    Task<Card> play_card(Card led_card, Suit trump) override;
+
+private:
+    std::string name;
+    std::vector<Card> hand;
+    Request request;
+    Card upcard;
+    bool is_dealer;
+    int round;
+    Card led_card;
+    Suit trump;
+    Decision<Bid> bid_decision;
+    Decision<Card> card_decision;
+
+    // EFFECTS: removes card from the hand
+    void remove_card(const Card &card);
+};
+
+#endif // ASYNCPLAYER_HPP
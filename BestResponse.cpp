@@ -0,0 +1,701 @@
+#include "BestResponse.hpp"
+#include "CfrBidding.hpp"
+#include "DealPipeline.hpp"
+#include "DealSampler.hpp"
+#include "GameState.hpp"
+#include "Random.hpp"
+#include "SimpleTable.hpp"
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+
+using namespace std;
+
+namespace
+{
+    const int NUM_PLAYERS = 4;
+    const int NUM_CARDS = 24;
+    const int DEALER = 0;
+    const int LEADER = 1;
+    // two chances to bid for each player
+    const int BID_NODES = 2 * NUM_PLAYERS;
+
+    // Action codes, as the searching seat sees them
+    const int PASS = 0;
+    const int ORDER = 1;        // + suit
+    const int DISCARD = 8;      // + card, the seat's own discard as dealer
+    const int PLAY = 32;        // + card
+
+    typedef std::array<uint32_t, NUM_PLAYERS> Hands;
+
+    uint32_t bit(int card)
+    {
+        return uint32_t(1) << card;
+    }
+
+    bool simple_bid(uint32_t hand, int upcard, int position, int round, Suit &trump)
+    {
+        const Suit upcard_suit = Card_from_index(upcard).get_suit();
+        if (!simple_orders_up(hand, upcard_suit, position == NUM_PLAYERS - 1, round))
+        {
+            return false;
+        }
+        trump = round == 1 ? upcard_suit : Suit_next(upcard_suit);
+        return true;
+    }
+
+    bool cfr_bid(uint32_t hand, int upcard, int position, int round, Suit &trump)
+    {
+        return cfr_orders_up(cfr_strategy(), hand, upcard, position, round, trump);
+    }
+
+    // EFFECTS: returns the card Simple plays from the hand of the player to
+    //          move in state
+    int simple_move(const GameState &state)
+    {
+        const uint32_t hand = state.get_hand(state.to_move());
+        const Suit trump = state.get_trump();
+        const int played = state.get_num_played();
+        if (played % NUM_PLAYERS == 0)
+        {
+            return simple_lead(hand, trump);
+        }
+        const int led = state.get_play(played - played % NUM_PLAYERS);
+        return simple_play(hand, Card_from_index(led).get_suit(trump), trump);
+    }
+
+    // EFFECTS: returns the history after one more action
+    uint64_t extend(uint64_t history, int code)
+    {
+        return mix64(history + uint64_t(code) + 1);
+    }
+
+    enum Mode
+    {
+        BEST,       // try every choice and keep the best
+        FIXED,      // choose as the fixed strategy does
+        POLICY      // choose as a previous BEST search did
+    };
+
+    // One walk of a hand over a set of worlds, from the searching seat's
+    // point of view.  Every function returns the sum over its worlds of the
+    // points the seat's team scores.
+    class Search
+    {
+    public:
+        Search(uint32_t hand_in, int upcard_in, int position, BidPolicy bidding_in,
+               Mode mode_in, std::unordered_map<uint64_t, int> &policy_in)
+            : hand(hand_in), upcard(upcard_in), seat((position + 1) % NUM_PLAYERS),
+              bidding(bidding_in), mode(mode_in), policy(policy_in) {}
+
+        double run(std::vector<Hands> &worlds)
+        {
+            return bid(worlds, 0, 0);
+        }
+
+    private:
+        uint32_t hand;
+        int upcard;
+        int seat;
+        BidPolicy bidding;
+        Mode mode;
+        std::unordered_map<uint64_t, int> &policy;
+
+        // EFFECTS: returns the code of the fixed strategy's bid at node
+        int fixed_bid(uint32_t cards, int node) const
+        {
+            const int position = node % NUM_PLAYERS;
+            const int round = node / NUM_PLAYERS + 1;
+            Suit trump = SPADES;
+            if (bidding(cards, upcard, position, round, trump))
+            {
+                return ORDER + trump;
+            }
+            if (node == BID_NODES - 1)
+            {
+                // the dealer must name a suit in round two
+                return ORDER + Suit_next(Card_from_index(upcard).get_suit());
+            }
+            return PASS;
+        }
+
+        // EFFECTS: returns the value of the seat's choice at history among
+        //          options, fixed being the fixed strategy's choice
+        template <typename Value>
+        double decide(uint64_t history, const std::vector<int> &options, int fixed,
+                      const Value &value)
+        {
+            if (mode == FIXED)
+            {
+                return value(fixed);
+            }
+            if (mode == POLICY)
+            {
+                const auto found = policy.find(history);
+                return value(found == policy.end() ? fixed : found->second);
+            }
+            // ties go to the fixed strategy's choice
+            int choice = fixed;
+            double best = value(fixed);
+            for (int code : options)
+            {
+                if (code != fixed)
+                {
+                    const double v = value(code);
+                    if (v > best)
+                    {
+                        best = v;
+                        choice = code;
+                    }
+                }
+            }
+            policy[history] = choice;
+            return best;
+        }
+
+        double bid(std::vector<Hands> &worlds, int node, uint64_t history)
+        {
+            const int bidder = (node % NUM_PLAYERS + 1) % NUM_PLAYERS;
+            if (bidder == seat)
+            {
+                const Suit upcard_suit = Card_from_index(upcard).get_suit();
+                std::vector<int> options;
+                if (node < BID_NODES - 1)
+                {
+                    options.push_back(PASS);
+                }
+                for (int suit = 0; suit < 4; suit++)
+                {
+                    if ((node < NUM_PLAYERS) == (suit == upcard_suit))
+                    {
+                        options.push_back(ORDER + suit);
+                    }
+                }
+                return decide(history, options, fixed_bid(hand, node), [&](int code) {
+                    return after_bid(worlds, node, code, extend(history, code));
+                });
+            }
+
+            // the others' bids split the worlds
+            std::array<std::vector<Hands>, ORDER + 4> split;
+            for (const Hands &world : worlds)
+            {
+                split[fixed_bid(world[bidder], node)].push_back(world);
+            }
+            double total = 0;
+            for (int code = 0; code < int(split.size()); code++)
+            {
+                if (!split[code].empty())
+                {
+                    total += after_bid(split[code], node, code, extend(history, code));
+                }
+            }
+            return total;
+        }
+
+        double after_bid(std::vector<Hands> &worlds, int node, int code, uint64_t history)
+        {
+            if (code == PASS)
+            {
+                return bid(worlds, node + 1, history);
+            }
+            const Suit trump = Suit(code - ORDER);
+            const int makers = (node % NUM_PLAYERS + 1) % 2;
+            if (node >= NUM_PLAYERS)
+            {
+                return start_play(worlds, trump, makers, history);
+            }
+
+            // ordered up in round one: the dealer picks up the upcard
+            if (seat != DEALER)
+            {
+                std::vector<Hands> picked = worlds;
+                for (Hands &world : picked)
+                {
+                    const int discard = simple_discard(world[DEALER], upcard, trump);
+                    world[DEALER] = (world[DEALER] | bit(upcard)) & ~bit(discard);
+                }
+                return start_play(picked, trump, makers, history);
+            }
+            const uint32_t six = hand | bit(upcard);
+            std::vector<int> options;
+            for (uint32_t cards = six; cards; cards &= cards - 1)
+            {
+                options.push_back(DISCARD + __builtin_ctz(cards));
+            }
+            const int fixed = DISCARD + simple_discard(hand, upcard, trump);
+            return decide(history, options, fixed, [&](int discard) {
+                std::vector<Hands> picked = worlds;
+                for (Hands &world : picked)
+                {
+                    world[DEALER] = six & ~bit(discard - DISCARD);
+                }
+                return start_play(picked, trump, makers, extend(history, discard));
+            });
+        }
+
+        double start_play(const std::vector<Hands> &worlds, Suit trump, int makers,
+                          uint64_t history)
+        {
+            std::vector<GameState> states;
+            states.reserve(worlds.size());
+            for (const Hands &world : worlds)
+            {
+                states.emplace_back(world, trump, makers, LEADER);
+            }
+            return play(states, history);
+        }
+
+        // MODIFIES: states (restored before returning)
+        double play(std::vector<GameState> &states, uint64_t history)
+        {
+            const GameState &first = states.front();
+            if (first.is_terminal())
+            {
+                double total = 0;
+                for (const GameState &state : states)
+                {
+                    total += state.score();
+                }
+                return seat % 2 == 0 ? total : -total;
+            }
+
+            // the seat's own hand and what it has seen are the same in every world
+            if (first.to_move() == seat)
+            {
+                std::vector<int> options;
+                for (uint32_t cards = first.legal_moves(); cards; cards &= cards - 1)
+                {
+                    options.push_back(PLAY + __builtin_ctz(cards));
+                }
+                return decide(history, options, PLAY + simple_move(first), [&](int code) {
+                    for (GameState &state : states)
+                    {
+                        state.apply(code - PLAY);
+                    }
+                    const double total = play(states, extend(history, code));
+                    for (GameState &state : states)
+                    {
+                        state.undo();
+                    }
+                    return total;
+                });
+            }
+
+            std::vector<int> cards(states.size());
+            bool same = true;
+            for (size_t i = 0; i < states.size(); i++)
+            {
+                cards[i] = simple_move(states[i]);
+                same = same && cards[i] == cards[0];
+            }
+            if (same)
+            {
+                for (GameState &state : states)
+                {
+                    state.apply(cards[0]);
+                }
+                const double total = play(states, extend(history, PLAY + cards[0]));
+                for (GameState &state : states)
+                {
+                    state.undo();
+                }
+                return total;
+            }
+
+            // the card played splits the worlds
+            std::array<std::vector<GameState>, NUM_CARDS> split;
+            for (size_t i = 0; i < states.size(); i++)
+            {
+                split[cards[i]].push_back(states[i]);
+                split[cards[i]].back().apply(cards[i]);
+            }
+            double total = 0;
+            for (int card = 0; card < NUM_CARDS; card++)
+            {
+                if (!split[card].empty())
+                {
+                    total += play(split[card], extend(history, PLAY + card));
+                }
+            }
+            return total;
+        }
+    };
+
+    // EFFECTS: returns count deals of the cards the player at position
+    //          cannot see, consistent with holding hand
+    std::vector<Hands> sample_worlds(uint32_t hand, int upcard, int position, int count,
+                                     uint64_t seed)
+    {
+        const int seat = (position + 1) % NUM_PLAYERS;
+        DealConstraints constraints;
+        for (int player = 0; player < NUM_PLAYERS; player++)
+        {
+            constraints.need[player] = player == seat ? 0 : 5;
+        }
+        constraints.unseen = ((uint32_t(1) << NUM_CARDS) - 1) & ~hand & ~bit(upcard);
+        const DealSampler sampler(constraints);
+        Random random(seed);
+        std::vector<Hands> worlds(count);
+        sampler.sample(random, worlds.data(), count);
+        for (Hands &world : worlds)
+        {
+            world[seat] = hand;
+        }
+        return worlds;
+    }
+}
+
+BidPolicy best_response_bidding(const std::string &strategy)
+{
+    if (strategy == "Simple" || strategy == "SimpleTable")
+    {
+        return simple_bid;
+    }
+    if (strategy == "CFR")
+    {
+        return cfr_bid;
+    }
+    return nullptr;
+}
+
+uint64_t best_response_fingerprint(const std::string &strategy)
+{
+    return strategy == "CFR" ? cfr_fingerprint(cfr_strategy()) : 0;
+}
+
+BestResponseValue best_response(uint32_t hand, int upcard, int position,
+                                BidPolicy bidding, const BestResponseOptions &options)
+{
+    assert(options.worlds >= 1);
+    const uint64_t seed = derive_seed(options.seed,
+                                      BestResponseCache::key(hand, upcard, position));
+    return best_response(hand, upcard, position, bidding,
+                         sample_worlds(hand, upcard, position, options.worlds,
+                                       derive_seed(seed, 0)),
+                         sample_worlds(hand, upcard, position, options.worlds,
+                                       derive_seed(seed, 1)));
+}
+
+BestResponseValue best_response(uint32_t hand, int upcard, int position,
+                                BidPolicy bidding,
+                                const std::vector<std::array<uint32_t, 4>> &worlds,
+                                const std::vector<std::array<uint32_t, 4>> &fresh)
+{
+    assert(bidding && !worlds.empty() && !fresh.empty());
+    std::vector<Hands> searched = worlds;
+    std::vector<Hands> held_out = fresh;
+    std::unordered_map<uint64_t, int> policy;
+
+    BestResponseValue value;
+    Search best(hand, upcard, position, bidding, BEST, policy);
+    Search fixed(hand, upcard, position, bidding, FIXED, policy);
+    Search found(hand, upcard, position, bidding, POLICY, policy);
+    value.best = best.run(searched);
+    value.fixed = fixed.run(searched);
+    value.held_out = found.run(held_out);
+    value.held_out_fixed = fixed.run(held_out);
+    value.best /= double(worlds.size());
+    value.fixed /= double(worlds.size());
+    value.held_out /= double(fresh.size());
+    value.held_out_fixed /= double(fresh.size());
+    value.decisions = long(policy.size());
+    return value;
+}
+
+BestResponseCache::BestResponseCache(int num_shards)
+{
+    assert(num_shards >= 1);
+    for (int i = 0; i < num_shards; i++)
+    {
+        shards.emplace_back(new Shard);
+    }
+}
+
+uint64_t BestResponseCache::key(uint32_t hand, int upcard, int position)
+{
+    return uint64_t(hand) | uint64_t(upcard) << NUM_CARDS |
+           uint64_t(position) << (NUM_CARDS + 5);
+}
+
+BestResponseCache::Shard & BestResponseCache::shard_of(uint64_t key) const
+{
+    return *shards[mix64(key) % shards.size()];
+}
+
+bool BestResponseCache::lookup(uint64_t key, BestResponseValue &value)
+{
+    Shard &shard = shard_of(key);
+    lock_guard<mutex> lock(shard.mutex);
+    const auto found = shard.entries.find(key);
+    if (found == shard.entries.end())
+    {
+        shard.misses++;
+        return false;
+    }
+    shard.hits++;
+    value = found->second;
+    return true;
+}
+
+void BestResponseCache::insert(uint64_t key, const BestResponseValue &value)
+{
+    Shard &shard = shard_of(key);
+    lock_guard<mutex> lock(shard.mutex);
+    shard.entries.emplace(key, value);
+}
+
+size_t BestResponseCache::size() const
+{
+    size_t total = 0;
+    for (const auto &shard : shards)
+    {
+        lock_guard<mutex> lock(shard->mutex);
+        total += shard->entries.size();
+    }
+    return total;
+}
+
+long BestResponseCache::hits() const
+{
+    long total = 0;
+    for (const auto &shard : shards)
+    {
+        lock_guard<mutex> lock(shard->mutex);
+        total += shard->hits;
+    }
+    return total;
+}
+
+long BestResponseCache::misses() const
+{
+    long total = 0;
+    for (const auto &shard : shards)
+    {
+        lock_guard<mutex> lock(shard->mutex);
+        total += shard->misses;
+    }
+    return total;
+}
+
+// File layout, text: "best-response 2 STRATEGY FINGERPRINT WORLDS SEED COUNT",
+// then COUNT lines of key, best, fixed, held_out, held_out_fixed, decisions
+bool BestResponseCache::save(const std::string &path, const std::string &strategy,
+                             const BestResponseOptions &options) const
+{
+    // write the whole file under a temporary name, then atomically replace
+    const string tmp_path = path + ".tmp";
+    {
+        ofstream file(tmp_path, ios::trunc);
+        file << "best-response 2 " << strategy << " "
+             << best_response_fingerprint(strategy) << " " << options.worlds << " "
+             << options.seed << " " << size() << "\n";
+        file << setprecision(17);
+        for (const auto &shard : shards)
+        {
+            lock_guard<mutex> lock(shard->mutex);
+            for (const auto &[key, value] : shard->entries)
+            {
+                file << key << " " << value.best << " " << value.fixed << " "
+                     << value.held_out << " " << value.held_out_fixed << " "
+                     << value.decisions << "\n";
+            }
+        }
+        if (!file.flush())
+        {
+            return false;
+        }
+    }
+    return rename(tmp_path.c_str(), path.c_str()) == 0;
+}
+
+bool BestResponseCache::load(const std::string &path, const std::string &strategy,
+                             const BestResponseOptions &options)
+{
+    ifstream file(path);
+    string magic;
+    int version = 0;
+    string saved_strategy;
+    uint64_t fingerprint = 0;
+    int worlds = 0;
+    uint64_t seed = 0;
+    long count = -1;
+    if (!(file >> magic >> version >> saved_strategy >> fingerprint >> worlds >> seed
+               >> count) ||
+        magic != "best-response" || version != 2 || saved_strategy != strategy ||
+        fingerprint != best_response_fingerprint(strategy) ||
+        worlds != options.worlds || seed != options.seed || count < 0)
+    {
+        return false;
+    }
+    std::vector<std::pair<uint64_t, BestResponseValue>> entries(count);
+    for (auto &[key, value] : entries)
+    {
+        if (!(file >> key >> value.best >> value.fixed >> value.held_out >>
+              value.held_out_fixed >> value.decisions))
+        {
+            return false;
+        }
+    }
+    for (const auto &[key, value] : entries)
+    {
+        insert(key, value);
+    }
+    return true;
+}
+
+ExploitabilityStats measure_exploitability(const ExploitabilityOptions &options,
+                                           ThreadPool &pool, BestResponseCache &cache)
+{
+    const BidPolicy bidding = best_response_bidding(options.strategy);
+    assert(bidding);
+    // by deal: the four positions' values
+    std::vector<std::array<BestResponseValue, NUM_PLAYERS>> values(options.deals);
+    pool.parallel_for(int(options.deals), [&](int, int d) {
+        const DealRecord deal = make_deal(options.search.seed, uint64_t(d));
+        for (int position = 0; position < NUM_PLAYERS; position++)
+        {
+            const uint32_t hand = deal.hands[(position + 1) % NUM_PLAYERS];
+            const uint64_t key = BestResponseCache::key(hand, deal.upcard, position);
+            BestResponseValue &value = values[d][position];
+            if (!cache.lookup(key, value))
+            {
+                value = best_response(hand, deal.upcard, position, bidding,
+                                      options.search);
+                cache.insert(key, value);
+            }
+        }
+    });
+
+    ExploitabilityStats stats;
+    stats.deals = options.deals;
+    double gain_squares = 0;
+    double held_out_squares = 0;
+    for (const auto &deal : values)
+    {
+        double gain = 0;
+        double held_out_gain = 0;
+        for (int position = 0; position < NUM_PLAYERS; position++)
+        {
+            const BestResponseValue &value = deal[position];
+            stats.fixed += value.fixed / NUM_PLAYERS;
+            stats.position_gain[position] += value.best - value.fixed;
+            stats.decisions += value.decisions;
+            gain += (value.best - value.fixed) / NUM_PLAYERS;
+            held_out_gain += (value.held_out - value.held_out_fixed) / NUM_PLAYERS;
+        }
+        stats.gain += gain;
+        stats.held_out_gain += held_out_gain;
+        gain_squares += gain * gain;
+        held_out_squares += held_out_gain * held_out_gain;
+    }
+    const double n = double(std::max(1l, options.deals));
+    stats.fixed /= n;
+    stats.gain /= n;
+    stats.held_out_gain /= n;
+    for (double &gain : stats.position_gain)
+    {
+        gain /= n;
+    }
+    // the deals are independent; the four positions of one are not
+    const double gain_variance =
+        std::max(0.0, gain_squares / n - stats.gain * stats.gain);
+    const double held_out_variance =
+        std::max(0.0, held_out_squares / n - stats.held_out_gain * stats.held_out_gain);
+    stats.half_width = options.z * std::sqrt(gain_variance / n);
+    stats.held_out_half_width = options.z * std::sqrt(held_out_variance / n);
+    return stats;
+}
+
+static void print_exploitability_usage()
+{
+    cout << "Usage: euchre.exe --exploitability STRATEGY DEALS THREADS [--worlds N] "
+         << "[--seed N] [--cache FILE]" << endl;
+}
+
+int exploitability_main(int argc, char **argv)
+{
+    if (argc < 5)
+    {
+        print_exploitability_usage();
+        return 1;
+    }
+    ExploitabilityOptions options;
+    options.strategy = argv[2];
+    options.deals = atol(argv[3]);
+    const int threads = atoi(argv[4]);
+    string cache_path;
+    for (int i = 5; i < argc; i++)
+    {
+        const string option = argv[i];
+        if (option == "--worlds" && i + 1 < argc)
+        {
+            options.search.worlds = atoi(argv[++i]);
+        }
+        else if (option == "--seed" && i + 1 < argc)
+        {
+            options.search.seed = strtoull(argv[++i], nullptr, 10);
+        }
+        else if (option == "--cache" && i + 1 < argc)
+        {
+            cache_path = argv[++i];
+        }
+        else
+        {
+            print_exploitability_usage();
+            return 1;
+        }
+    }
+    if (options.deals < 1 || threads < 0 || options.search.worlds < 1)
+    {
+        print_exploitability_usage();
+        return 2;
+    }
+    if (!best_response_bidding(options.strategy))
+    {
+        cout << "Strategy " << options.strategy
+             << " does not play as Simple with deterministic bids" << endl;
+        return 3;
+    }
+
+    BestResponseCache cache;
+    if (!cache_path.empty() && ifstream(cache_path) &&
+        !cache.load(cache_path, options.strategy, options.search))
+    {
+        cout << "Cache " << cache_path << " is unreadable or was made with other "
+             << "options" << endl;
+        return 4;
+    }
+    ThreadPool pool(threads == 0 ? default_thread_count() : threads);
+    const auto start = chrono::steady_clock::now();
+    const ExploitabilityStats stats = measure_exploitability(options, pool, cache);
+    const chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+    if (!cache_path.empty() && !cache.save(cache_path, options.strategy, options.search))
+    {
+        cout << "Error writing " << cache_path << endl;
+        return 5;
+    }
+
+    cout << "Best response to " << options.strategy << ", " << stats.deals << " deals, "
+         << options.search.worlds << " worlds per information set" << endl;
+    cout << fixed << setprecision(4);
+    cout << "Strategy:       " << stats.fixed << " points per hand" << endl;
+    for (int position = 0; position < NUM_PLAYERS; position++)
+    {
+        cout << "Position " << position << ":     " << showpos
+             << stats.position_gain[position] << noshowpos << endl;
+    }
+    cout << "Exploitability: " << showpos << stats.gain << noshowpos << " +/- "
+         << stats.half_width << " points per hand (in sample)" << endl;
+    cout << "                " << showpos << stats.held_out_gain << noshowpos << " +/- "
+         << stats.held_out_half_width << " points per hand (held out)" << endl;
+    cout << setprecision(1) << double(stats.decisions) / (NUM_PLAYERS * stats.deals)
+         << " decisions per information set, " << cache.hits() << " cache hits, "
+         << elapsed.count() << " s" << endl;
+    return 0;
+}
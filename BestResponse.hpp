@@ -0,0 +1,177 @@
+#ifndef BESTRESPONSE_HPP
+#define BESTRESPONSE_HPP
+/* BestResponse.hpp
+ *
+ * Best response to a fixed deterministic strategy, and the exploitability
+ * it measures.  One seat plays to maximize its team's expected points
+ * while its partner and both opponents play the fixed strategy: Simple,
+ * or any strategy that plays its cards as Simple with its own bidding
+ * (SimpleTable, CFR).
+ *
+ * The seat knows its hand, the upcard and its position, and sees every
+ * bid and card played.  The others' choices are a known function of their
+ * cards, so each world (a deal of the unseen cards) it might be in plays
+ * out the same way for the same choices of its own.  The search samples
+ * worlds, then walks the hand once for all of them: at the others' turns
+ * the worlds split by the bid or card each would produce, which is what
+ * the seat observes; at its own turns every choice is tried across all
+ * the worlds still possible, and the best total is kept.  The result is
+ * the exact best response to the sampled worlds, a choice for every
+ * information set they reach.
+ *
+ * Maximizing over one sample overrates the best response a little, so the
+ * policy found is also played on a second, fresh sample of worlds, where
+ * it is scored fairly but falls back to the fixed strategy wherever the
+ * first sample never went.  The true best-response gain lies between the
+ * two estimates.
+ *
+ * Results are cached by information set (hand, upcard and position; the
+ * hidden cards do not enter it), so a deal's infosets are searched once
+ * per run, and a cache saved to a file carries over to later runs.
+ *
+ * Hands are bitmasks of Card_to_index bits, as in GameState.  Player 0
+ * deals and positions count bidders from the dealer's left, so the
+ * player at position p is player p + 1 mod 4 and the dealer is 3.
+ */
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "Card.hpp"
+#include "ThreadPool.hpp"
+
+// How a fixed strategy bids: returns true and sets trump to order up
+using BidPolicy = bool (*)(uint32_t hand, int upcard, int position, int round,
+                           Suit &trump);
+
+// EFFECTS: returns the bidding of strategy, or nullptr if strategy does not
+//          play its cards as Simple and decide deterministically
+BidPolicy best_response_bidding(const std::string &strategy);
+
+// EFFECTS: returns a fingerprint of the table strategy bids from, or 0 if
+//          its bidding is fixed by the code alone
+uint64_t best_response_fingerprint(const std::string &strategy);
+
+struct BestResponseOptions
+{
+    int worlds = 256;           // sampled for each information set
+    uint64_t seed = 0;
+};
+
+// Expected points per hand for the seat's team
+struct BestResponseValue
+{
+    double best = 0;            // best response, on the worlds it was found on
+    double fixed = 0;           // the fixed strategy in the seat, same worlds
+    double held_out = 0;        // the best response's choices on fresh worlds
+    double held_out_fixed = 0;  // the fixed strategy, on the fresh worlds
+    long decisions = 0;         // information sets the best response chose at
+
+    bool operator==(const BestResponseValue &other) const = default;
+};
+
+// REQUIRES: hand holds five cards, upcard is not in hand,
+//           0 <= position <= 3, bidding is not null, options.worlds >= 1
+// EFFECTS: returns the best response of the player at position holding hand
+//          to bidding and Simple card play.  The result depends only on the
+//          arguments.
+BestResponseValue best_response(uint32_t hand, int upcard, int position,
+                                BidPolicy bidding, const BestResponseOptions &options);
+
+// REQUIRES: as above, and every world is a deal holding hand at the
+//           player's seat, five cards for each other player and not upcard
+// EFFECTS: returns the best response found on worlds, with its choices
+//          also played on fresh
+BestResponseValue best_response(uint32_t hand, int upcard, int position,
+                                BidPolicy bidding,
+                                const std::vector<std::array<uint32_t, 4>> &worlds,
+                                const std::vector<std::array<uint32_t, 4>> &fresh);
+
+// Best-response values by information set, shared by worker threads
+class BestResponseCache
+{
+public:
+    // EFFECTS: Creates an empty cache spread over num_shards locks
+    explicit BestResponseCache(int num_shards = 16);
+
+    // EFFECTS: returns the key of an information set
+    static uint64_t key(uint32_t hand, int upcard, int position);
+
+    // MODIFIES: value
+    // EFFECTS: If key is cached, sets value and returns true; otherwise
+    //          returns false.  Counts a hit or a miss either way.
+    bool lookup(uint64_t key, BestResponseValue &value);
+
+    // EFFECTS: Stores value under key
+    void insert(uint64_t key, const BestResponseValue &value);
+
+    size_t size() const;
+    long hits() const;
+    long misses() const;
+
+    // EFFECTS: Writes every cached value to path, tagged with strategy, its
+    //          best_response_fingerprint() and options.  Returns false if
+    //          the file cannot be written.
+    bool save(const std::string &path, const std::string &strategy,
+              const BestResponseOptions &options) const;
+
+    // EFFECTS: Adds the values saved in path.  Returns false if the file
+    //          cannot be read, is not a cache, or was saved for another
+    //          strategy, another table of the same strategy, or other
+    //          options.
+    bool load(const std::string &path, const std::string &strategy,
+              const BestResponseOptions &options);
+
+private:
+    struct Shard
+    {
+        mutable std::mutex mutex;
+        std::unordered_map<uint64_t, BestResponseValue> entries;
+        long hits = 0;
+        long misses = 0;
+    };
+    std::vector<std::unique_ptr<Shard>> shards;
+
+    Shard & shard_of(uint64_t key) const;
+};
+
+struct ExploitabilityOptions
+{
+    std::string strategy = "Simple";
+    long deals = 1000;
+    BestResponseOptions search;
+    double z = 1.96;            // normal quantile of the intervals
+};
+
+// Points per hand a best-responding seat gains over the fixed strategy in
+// the same seat, averaged over all four positions of each deal
+struct ExploitabilityStats
+{
+    long deals = 0;
+    double fixed = 0;                   // the strategy's own points per hand
+    double gain = 0;                    // in sample, an overestimate
+    double half_width = 0;
+    double held_out_gain = 0;           // on fresh worlds, an underestimate
+    double held_out_half_width = 0;
+    std::array<double, 4> position_gain{};     // in sample, by position
+    long decisions = 0;
+};
+
+// REQUIRES: best_response_bidding(options.strategy) is not null
+// MODIFIES: cache
+// EFFECTS: Measures exploitability over options.deals seeded deals on
+//          pool's workers.  The result does not depend on the number of
+//          threads or on what cache held beforehand.
+ExploitabilityStats measure_exploitability(const ExploitabilityOptions &options,
+                                           ThreadPool &pool, BestResponseCache &cache);
+
+// EFFECTS: Measures exploitability from command line arguments STRATEGY
+//          DEALS THREADS [--worlds N] [--seed N] [--cache FILE] and prints
+//          it.  Returns the process exit status.
+int exploitability_main(int argc, char **argv);
+
+#endif // BESTRESPONSE_HPP
@@ -0,0 +1,176 @@
+#include "BestResponse.hpp"
+#include "DealPipeline.hpp"
+#include "SimpleTable.hpp"
+#include "unit_test_framework.hpp"
+
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+
+using namespace std;
+
+typedef array<uint32_t, 4> Hands;
+
+// EFFECTS: returns the points players 0 and 2 score when all four bid and
+//          play deal as Simple, player 0 dealing
+static int simple_points(const DealRecord &deal) {
+    const Suit upcard_suit = Card_from_index(deal.upcard).get_suit();
+    Hands hands = deal.hands;
+    for (int node = 0; node < 8; node++) {
+        const int position = node % 4;
+        const int player = (position + 1) % 4;
+        const int round = node / 4 + 1;
+        if (!simple_orders_up(hands[player], upcard_suit, position == 3, round)) {
+            continue;
+        }
+        Suit trump = upcard_suit;
+        if (round == 1) {
+            const int discard = simple_discard(hands[0], deal.upcard, trump);
+            hands[0] |= uint32_t(1) << deal.upcard;
+            hands[0] &= ~(uint32_t(1) << discard);
+        } else {
+            trump = Suit_next(upcard_suit);
+        }
+        const int makers = player % 2;
+        const int tricks = simple_tricks(hands, trump, 1);
+        const int made = makers == 0 ? tricks : 5 - tricks;
+        const int points = made == 5 ? 2 : made >= 3 ? 1 : -2;
+        return makers == 0 ? points : -points;
+    }
+    // Simple's dealer always names a suit in round two
+    return 0;
+}
+
+TEST(test_fixed_matches_simple_play) {
+    const BidPolicy simple = best_response_bidding("Simple");
+    for (uint64_t index = 0; index < 300; index++) {
+        const DealRecord deal = make_deal(3, index);
+        const int points = simple_points(deal);
+        for (int position = 0; position < 4; position++) {
+            const int player = (position + 1) % 4;
+            const vector<Hands> world = {deal.hands};
+            const BestResponseValue value = best_response(deal.hands[player], deal.upcard,
+                                                          position, simple, world, world);
+            ASSERT_EQUAL(value.fixed, double(player % 2 == 0 ? points : -points));
+            // seeing one world is seeing every card: the best response does
+            // at least as well, and replays its choices exactly
+            ASSERT_TRUE(value.best >= value.fixed);
+            ASSERT_EQUAL(value.held_out, value.best);
+            ASSERT_EQUAL(value.held_out_fixed, value.fixed);
+        }
+    }
+}
+
+TEST(test_best_response_is_deterministic_and_no_worse) {
+    BestResponseOptions options;
+    options.worlds = 64;
+    options.seed = 5;
+    const BidPolicy simple = best_response_bidding("Simple");
+    for (uint64_t index = 0; index < 20; index++) {
+        const DealRecord deal = make_deal(4, index);
+        const int position = int(index % 4);
+        const uint32_t hand = deal.hands[(position + 1) % 4];
+        const BestResponseValue value = best_response(hand, deal.upcard, position, simple,
+                                                      options);
+        ASSERT_TRUE(value.best >= value.fixed);
+        ASSERT_TRUE(value.decisions >= 5);
+        ASSERT_TRUE(value == best_response(hand, deal.upcard, position, simple, options));
+    }
+}
+
+TEST(test_bidding_lookup) {
+    ASSERT_TRUE(best_response_bidding("Simple") != nullptr);
+    ASSERT_TRUE(best_response_bidding("SimpleTable") == best_response_bidding("Simple"));
+    ASSERT_TRUE(best_response_bidding("CFR") != nullptr);
+    ASSERT_TRUE(best_response_bidding("Learned") == nullptr);
+    ASSERT_TRUE(best_response_bidding("Human") == nullptr);
+}
+
+TEST(test_cache_round_trip) {
+    const string path = "BestResponse_tests_cache.txt";
+    BestResponseOptions options;
+    options.worlds = 16;
+    BestResponseCache cache(4);
+    BestResponseValue value;
+    value.best = 1.0 / 3;
+    value.fixed = -0.125;
+    value.held_out = 0.1;
+    value.held_out_fixed = -2;
+    value.decisions = 17;
+    const uint64_t key = BestResponseCache::key(0x1f, 9, 3);
+    ASSERT_FALSE(cache.lookup(key, value));
+    cache.insert(key, value);
+    cache.insert(BestResponseCache::key(0x3e, 9, 0), BestResponseValue());
+    ASSERT_TRUE(cache.save(path, "Simple", options));
+
+    BestResponseCache loaded;
+    ASSERT_TRUE(loaded.load(path, "Simple", options));
+    ASSERT_EQUAL(loaded.size(), size_t(2));
+    BestResponseValue read;
+    ASSERT_TRUE(loaded.lookup(key, read));
+    ASSERT_TRUE(read == value);
+    ASSERT_EQUAL(loaded.hits(), 1l);
+
+    BestResponseCache other;
+    ASSERT_FALSE(other.load(path, "CFR", options));
+    options.worlds = 32;
+    ASSERT_FALSE(other.load(path, "Simple", options));
+    ASSERT_FALSE(other.load("no_such_best_response_cache.txt", "Simple", options));
+    ASSERT_EQUAL(other.size(), size_t(0));
+    remove(path.c_str());
+}
+
+TEST(test_cache_rejects_another_table) {
+    const string path = "BestResponse_tests_table.txt";
+    BestResponseOptions options;
+    BestResponseCache cache(4);
+    cache.insert(BestResponseCache::key(0x1f, 9, 3), BestResponseValue());
+    ASSERT_TRUE(cache.save(path, "CFR", options));
+    BestResponseCache same;
+    ASSERT_TRUE(same.load(path, "CFR", options));
+
+    // a cache saved while CFR read a different table
+    ifstream in(path);
+    string text((istreambuf_iterator<char>(in)), istreambuf_iterator<char>());
+    const string fingerprint = " " + to_string(best_response_fingerprint("CFR")) + " ";
+    ASSERT_TRUE(text.find(fingerprint) != string::npos);
+    text.replace(text.find(fingerprint), fingerprint.size(), " 12345 ");
+    ofstream(path) << text;
+
+    BestResponseCache other;
+    ASSERT_FALSE(other.load(path, "CFR", options));
+    ASSERT_EQUAL(other.size(), size_t(0));
+    remove(path.c_str());
+}
+
+TEST(test_simple_is_exploitable) {
+    ExploitabilityOptions options;
+    options.deals = 24;
+    options.search.worlds = 48;
+    options.search.seed = 2;
+    BestResponseCache cache;
+    ExploitabilityStats stats;
+    {
+        ThreadPool pool(1);
+        stats = measure_exploitability(options, pool, cache);
+    }
+    ASSERT_EQUAL(cache.size(), size_t(4 * 24));
+    ASSERT_TRUE(stats.gain > 0);
+    ASSERT_TRUE(stats.held_out_gain < stats.gain);
+    for (double gain : stats.position_gain) {
+        ASSERT_TRUE(gain >= 0);
+    }
+
+    // a second run on more threads finds everything cached
+    ExploitabilityStats again;
+    {
+        ThreadPool pool(3);
+        again = measure_exploitability(options, pool, cache);
+    }
+    ASSERT_EQUAL(cache.hits(), 4l * 24);
+    ASSERT_EQUAL(again.gain, stats.gain);
+    ASSERT_EQUAL(again.held_out_gain, stats.held_out_gain);
+    ASSERT_EQUAL(again.fixed, stats.fixed);
+}
+
+TEST_MAIN()
@@ -0,0 +1,424 @@
+#include "Bidding.hpp"
+#include "Hand.hpp"
+#include "Player.hpp"
+#include "SimpleTable.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <memory>
+#include <vector>
+
+using namespace std;
+
+namespace
+{
+    const int NUM_PLAYERS = 4;
+    const int BLOCK_DEALS = 4096;
+    const int LEARNED_CHUNK = 256;
+
+    uint32_t bit(int card)
+    {
+        return uint32_t(1) << card;
+    }
+
+    // EFFECTS: returns the player who makes a bid in position k, counting
+    //          from the player left of player 0, the dealer
+    int bidder(int k)
+    {
+        return (k + 1) % NUM_PLAYERS;
+    }
+}
+
+void bid_simple(const DealRecord *deals, int n, BidOutcome *outcomes)
+{
+    // first pass: which players would order up in each round, one bit per
+    // bidding position, with no branches so the loop vectorizes
+    std::vector<uint8_t> round_one(n);
+    std::vector<uint8_t> round_two(n);
+    for (int i = 0; i < n; i++)
+    {
+        const int upcard_suit = deals[i].upcard / 6;
+        const uint32_t good_one = simple_good_cards(Suit(upcard_suit));
+        const uint32_t good_two = simple_good_cards(Suit_next(Suit(upcard_suit)));
+        uint8_t one = 0;
+        uint8_t two = 1 << (NUM_PLAYERS - 1); // the dealer must name a suit
+        for (int k = 0; k < NUM_PLAYERS; k++)
+        {
+            const uint32_t hand = deals[i].hands[bidder(k)];
+            one |= uint8_t(__builtin_popcount(hand & good_one) >= 2) << k;
+            two |= uint8_t(__builtin_popcount(hand & good_two) >= 1) << k;
+        }
+        round_one[i] = one;
+        round_two[i] = two;
+    }
+
+    // second pass: the first willing bidder makes it, and after a round
+    // one order the dealer throws away its lowest card
+    for (int i = 0; i < n; i++)
+    {
+        BidOutcome &outcome = outcomes[i];
+        const Suit upcard_suit = Suit(deals[i].upcard / 6);
+        if (round_one[i])
+        {
+            outcome.round = 1;
+            outcome.maker = int8_t(bidder(__builtin_ctz(round_one[i])));
+            outcome.trump = int8_t(upcard_suit);
+            outcome.discard = int8_t(simple_discard(deals[i].hands[0], deals[i].upcard,
+                                                    upcard_suit));
+        }
+        else
+        {
+            outcome.round = 2;
+            outcome.maker = int8_t(bidder(__builtin_ctz(round_two[i])));
+            outcome.trump = int8_t(Suit_next(upcard_suit));
+            outcome.discard = -1;
+        }
+    }
+}
+
+void bid_learned(const LearnedModel &model, const DealRecord *deals, int n,
+                 BidOutcome *outcomes)
+{
+    // score every choice in the chunk as one batch: the dealer's six
+    // possible discards, then each bidder's round-one hand and three
+    // round-two suits
+    const int DISCARDS = 6;
+    const int BIDS = NUM_PLAYERS * NUM_PLAYERS;
+    std::vector<float> discard_rows(size_t(LEARNED_CHUNK) * DISCARDS * LEARNED_INPUTS);
+    std::vector<float> discard_scores(size_t(LEARNED_CHUNK) * DISCARDS);
+    std::vector<float> bid_rows(size_t(LEARNED_CHUNK) * BIDS * LEARNED_INPUTS);
+    std::vector<float> bid_scores(size_t(LEARNED_CHUNK) * BIDS);
+    std::vector<int> discards(LEARNED_CHUNK);
+    for (int start = 0; start < n; start += LEARNED_CHUNK)
+    {
+        const int count = std::min(LEARNED_CHUNK, n - start);
+        for (int i = 0; i < count; i++)
+        {
+            const DealRecord &deal = deals[start + i];
+            const Suit upcard_suit = Suit(deal.upcard / 6);
+            const uint32_t held = deal.hands[0] | bit(deal.upcard);
+            int d = 0;
+            for (uint32_t rest = held; rest; rest &= rest - 1, d++)
+            {
+                float *row = &discard_rows[(i * DISCARDS + d) * LEARNED_INPUTS];
+                learned_bid_inputs(held & ~bit(__builtin_ctz(rest)), deal.upcard, 3, 1,
+                                   upcard_suit, row);
+            }
+        }
+        model.bid.evaluate(discard_rows.data(), size_t(count) * DISCARDS,
+                           discard_scores.data());
+
+        for (int i = 0; i < count; i++)
+        {
+            const DealRecord &deal = deals[start + i];
+            const Suit upcard_suit = Suit(deal.upcard / 6);
+            const uint32_t held = deal.hands[0] | bit(deal.upcard);
+            const float *options = &discard_scores[size_t(i) * DISCARDS];
+            int choice = 0;
+            for (int d = 1; d < DISCARDS; d++)
+            {
+                if (options[d] > options[choice])
+                {
+                    choice = d;
+                }
+            }
+            uint32_t rest = held;
+            for (int d = 0; d < choice; d++)
+            {
+                rest &= rest - 1;
+            }
+            discards[i] = __builtin_ctz(rest);
+
+            float *rows = &bid_rows[size_t(i) * BIDS * LEARNED_INPUTS];
+            for (int k = 0; k < NUM_PLAYERS; k++)
+            {
+                const uint32_t hand = k == NUM_PLAYERS - 1 ? held & ~bit(discards[i])
+                                                           : deal.hands[bidder(k)];
+                learned_bid_inputs(hand, deal.upcard, k, 1, upcard_suit,
+                                   rows + (k * NUM_PLAYERS) * LEARNED_INPUTS);
+                int column = 1;
+                for (int suit = 0; suit < NUM_PLAYERS; suit++)
+                {
+                    if (suit != upcard_suit)
+                    {
+                        float *row = rows + (k * NUM_PLAYERS + column++) * LEARNED_INPUTS;
+                        learned_bid_inputs(deal.hands[bidder(k)], deal.upcard, k, 2,
+                                           Suit(suit), row);
+                    }
+                }
+            }
+        }
+        model.bid.evaluate(bid_rows.data(), size_t(count) * BIDS, bid_scores.data());
+
+        // the same choices learned_orders_up makes, in bidding order
+        for (int i = 0; i < count; i++)
+        {
+            const DealRecord &deal = deals[start + i];
+            const Suit upcard_suit = Suit(deal.upcard / 6);
+            const float *scores = &bid_scores[size_t(i) * BIDS];
+            BidOutcome &outcome = outcomes[start + i];
+            outcome = BidOutcome();
+            for (int k = 0; k < NUM_PLAYERS && !outcome.round; k++)
+            {
+                if (scores[k * NUM_PLAYERS] > 0.0f)
+                {
+                    outcome.round = 1;
+                    outcome.maker = int8_t(bidder(k));
+                    outcome.trump = int8_t(upcard_suit);
+                    outcome.discard = int8_t(discards[i]);
+                }
+            }
+            for (int k = 0; k < NUM_PLAYERS && !outcome.round; k++)
+            {
+                const float *suits = scores + k * NUM_PLAYERS;
+                int choice = 1;
+                for (int column = 2; column < NUM_PLAYERS; column++)
+                {
+                    if (suits[column] > suits[choice])
+                    {
+                        choice = column;
+                    }
+                }
+                if (suits[choice] > 0.0f || k == NUM_PLAYERS - 1)
+                {
+                    // the choice'th suit other than the upcard's
+                    const int suit = choice - 1 + (choice - 1 >= upcard_suit);
+                    outcome.round = 2;
+                    outcome.maker = int8_t(bidder(k));
+                    outcome.trump = int8_t(suit);
+                    outcome.discard = -1;
+                }
+            }
+        }
+    }
+}
+
+BidOutcome bid_with_players(const DealRecord &deal,
+                            const std::array<std::string, 4> &strategies)
+{
+    std::array<std::unique_ptr<Player>, NUM_PLAYERS> players;
+    for (int player = 0; player < NUM_PLAYERS; player++)
+    {
+        players[player].reset(Player_factory("Player " + to_string(player),
+                                             strategies[player]));
+        for (uint32_t cards = deal.hands[player]; cards; cards &= cards - 1)
+        {
+            players[player]->add_card(Card_from_index(__builtin_ctz(cards)));
+        }
+    }
+
+    // players hear the bidding as they would in a Game
+    Hand hand([&players](const PlayerEvent &event) {
+        for (const std::unique_ptr<Player> &player : players)
+        {
+            player->observe(event);
+        }
+    });
+    const Card upcard = Card_from_index(deal.upcard);
+    hand.start(0, upcard);
+
+    BidOutcome outcome;
+    while (hand.get_phase() == Hand::BID && hand.get_round() <= 2)
+    {
+        const int player = hand.to_act();
+        const int round = hand.get_round();
+        Suit trump = upcard.get_suit();
+        const bool order_up = players[player]->make_trump(upcard, player == 0, round,
+                                                          trump);
+        if (order_up)
+        {
+            outcome.round = int8_t(round);
+            outcome.maker = int8_t(player);
+            outcome.trump = int8_t(trump);
+        }
+        hand.bid(order_up, trump);
+    }
+    if (outcome.round == 1)
+    {
+        // the discard is whichever card the dealer no longer holds
+        players[0]->add_and_discard(upcard);
+        uint32_t kept = deal.hands[0] | bit(deal.upcard);
+        for (int i = 0; i < 5; i++)
+        {
+            kept &= ~bit(Card_to_index(players[0]->lead_card(Suit(outcome.trump))));
+        }
+        outcome.discard = int8_t(__builtin_ctz(kept));
+    }
+    return outcome;
+}
+
+void BiddingSummary::add(const BidOutcome &outcome)
+{
+    deals++;
+    orders[outcome.round - 1][(outcome.maker + NUM_PLAYERS - 1) % NUM_PLAYERS]++;
+    dealer_team_makes[outcome.round - 1] += outcome.maker % 2 == 0;
+    if (outcome.discard >= 0)
+    {
+        discarded_ranks[Card_from_index(outcome.discard).get_rank() - NINE]++;
+    }
+}
+
+void BiddingSummary::add(const BiddingSummary &other)
+{
+    deals += other.deals;
+    for (int round = 0; round < 2; round++)
+    {
+        for (int seat = 0; seat < NUM_PLAYERS; seat++)
+        {
+            orders[round][seat] += other.orders[round][seat];
+        }
+        dealer_team_makes[round] += other.dealer_team_makes[round];
+    }
+    for (size_t rank = 0; rank < discarded_ranks.size(); rank++)
+    {
+        discarded_ranks[rank] += other.discarded_ranks[rank];
+    }
+}
+
+BiddingSummary run_bidding(const BiddingOptions &options, ThreadPool &pool)
+{
+    const bool simple = options.strategy == "Simple" || options.strategy == "SimpleTable";
+    const bool learned = options.strategy == "Learned";
+    const bool fast = options.fast_path && (simple || learned);
+    const std::array<std::string, NUM_PLAYERS> strategies = {
+        options.strategy, options.strategy, options.strategy, options.strategy};
+    const int num_blocks = int((options.deals + BLOCK_DEALS - 1) / BLOCK_DEALS);
+    std::vector<BiddingSummary> blocks(num_blocks);
+    pool.parallel_for(num_blocks, [&](int, int b) {
+        const long first = long(b) * BLOCK_DEALS;
+        const int n = int(std::min<long>(BLOCK_DEALS, options.deals - first));
+        std::vector<DealRecord> deals(n);
+        std::vector<BidOutcome> outcomes(n);
+        generate_deals(options.seed, first, n, deals.data());
+        if (fast && simple)
+        {
+            bid_simple(deals.data(), n, outcomes.data());
+        }
+        else if (fast)
+        {
+            bid_learned(learned_model(), deals.data(), n, outcomes.data());
+        }
+        else
+        {
+            for (int i = 0; i < n; i++)
+            {
+                outcomes[i] = bid_with_players(deals[i], strategies);
+            }
+        }
+        for (int i = 0; i < n; i++)
+        {
+            blocks[b].add(outcomes[i]);
+        }
+    });
+
+    // add up in block order so results are the same for any thread count
+    BiddingSummary summary;
+    for (const BiddingSummary &block : blocks)
+    {
+        summary.add(block);
+    }
+    return summary;
+}
+
+void print_bidding(const BiddingSummary &summary, std::ostream &os)
+{
+    const char *const seats[NUM_PLAYERS] = {"left", "across", "right", "dealer"};
+    const double deals = double(std::max(1L, summary.deals));
+    os << summary.deals << " deals" << endl;
+    os << fixed << setprecision(2);
+    for (int round = 0; round < 2; round++)
+    {
+        long total = 0;
+        os << "Round " << round + 1 << ":";
+        for (int seat = 0; seat < NUM_PLAYERS; seat++)
+        {
+            os << " " << seats[seat] << " " << 100 * summary.orders[round][seat] / deals << "%";
+            total += summary.orders[round][seat];
+        }
+        os << ", total " << 100 * total / deals << "%, dealer's team "
+           << 100 * summary.dealer_team_makes[round] / deals << "%" << endl;
+    }
+    os << "Dealer discards:";
+    for (int rank = 0; rank < int(summary.discarded_ranks.size()); rank++)
+    {
+        os << " " << Rank(NINE + rank) << " " << summary.discarded_ranks[rank];
+    }
+    os << endl;
+    os.unsetf(ios::floatfield);
+}
+
+static void print_bidding_usage()
+{
+    cout << "Usage: euchre.exe --bidding DEALS THREADS [--strategy S] [--seed N] [--check]"
+         << endl;
+}
+
+int bidding_main(int argc, char **argv)
+{
+    if (argc < 4)
+    {
+        print_bidding_usage();
+        return 1;
+    }
+    BiddingOptions options;
+    options.deals = atol(argv[2]);
+    const int threads = atoi(argv[3]);
+    bool check = false;
+    for (int i = 4; i < argc; i++)
+    {
+        const string option = argv[i];
+        if (option == "--strategy" && i + 1 < argc)
+        {
+            options.strategy = argv[++i];
+        }
+        else if (option == "--seed" && i + 1 < argc)
+        {
+            options.seed = strtoull(argv[++i], nullptr, 10);
+        }
+        else if (option == "--check")
+        {
+            check = true;
+        }
+        else
+        {
+            print_bidding_usage();
+            return 1;
+        }
+    }
+    if (options.deals < 1 || threads < 0)
+    {
+        print_bidding_usage();
+        return 2;
+    }
+    if (!Player_strategy_exists(options.strategy) ||
+        Player_strategy_is_interactive(options.strategy))
+    {
+        cout << "Unknown or interactive strategy " << options.strategy << endl;
+        return 3;
+    }
+
+    ThreadPool pool(threads == 0 ? default_thread_count() : threads);
+    auto start = chrono::steady_clock::now();
+    const BiddingSummary summary = run_bidding(options, pool);
+    const chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+    print_bidding(summary, cout);
+    cout << fixed << setprecision(0) << "Bid " << options.deals / elapsed.count()
+         << " deals/s" << endl;
+
+    if (check)
+    {
+        options.fast_path = false;
+        start = chrono::steady_clock::now();
+        const BiddingSummary slow = run_bidding(options, pool);
+        const chrono::duration<double> slow_elapsed = chrono::steady_clock::now() - start;
+        cout << "Through players: " << options.deals / slow_elapsed.count() << " deals/s, "
+             << setprecision(1) << slow_elapsed.count() / elapsed.count() << "x slower" << endl;
+        if (!(slow == summary))
+        {
+            cout << "Fast path and players disagree" << endl;
+            return 4;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,90 @@
+#ifndef BIDDING_HPP
+#define BIDDING_HPP
+/* Bidding.hpp
+ *
+ * Runs only the deal and the two rounds of making trump, including the
+ * dealer's pickup and discard, without playing any tricks.  For the Simple
+ * strategy the decisions reduce to popcounts of each hand against fixed
+ * card masks, so whole batches of deals are bid without creating players
+ * or branching per player.  For the Learned strategy every option of a
+ * batch of deals is scored in one batched model evaluation.  Other
+ * strategies go through Player objects.
+ */
+
+#include <array>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include "DealPipeline.hpp"
+#include "Learned.hpp"
+#include "ThreadPool.hpp"
+
+// What happened in the bidding of one deal dealt by player 0
+struct BidOutcome
+{
+    int8_t round = 0;           // 1 or 2
+    int8_t maker = 0;           // player who ordered up
+    int8_t trump = 0;           // Suit ordered up
+    int8_t discard = -1;        // Card_to_index of the dealer's discard
+                                // after a round-one pickup, or -1
+
+    bool operator==(const BidOutcome &other) const = default;
+};
+
+// MODIFIES: outcomes
+// EFFECTS: Bids deals[0 .. n) as four Simple players would and writes the
+//          results to outcomes[0 .. n)
+void bid_simple(const DealRecord *deals, int n, BidOutcome *outcomes);
+
+// MODIFIES: outcomes
+// EFFECTS: Bids deals[0 .. n) as four Learned players using model would
+//          and writes the results to outcomes[0 .. n)
+void bid_learned(const LearnedModel &model, const DealRecord *deals, int n,
+                 BidOutcome *outcomes);
+
+// REQUIRES: every strategy is non-interactive
+// EFFECTS: returns the bidding of deal by Player objects with the given
+//          strategies, seated by player number
+BidOutcome bid_with_players(const DealRecord &deal,
+                            const std::array<std::string, 4> &strategies);
+
+// Counts of bidding outcomes over many deals
+struct BiddingSummary
+{
+    long deals = 0;
+    // [round - 1][seat counted left from the dealer, dealer last]
+    std::array<std::array<long, 4>, 2> orders{};
+    std::array<long, 2> dealer_team_makes{};    // by round
+    std::array<long, 6> discarded_ranks{};      // NINE .. ACE, round one
+
+    void add(const BidOutcome &outcome);
+    void add(const BiddingSummary &other);
+
+    bool operator==(const BiddingSummary &other) const = default;
+};
+
+struct BiddingOptions
+{
+    std::string strategy = "Simple";
+    long deals = 1000000;
+    uint64_t seed = 0;
+    bool fast_path = true;      // false always bids through Player objects
+};
+
+// REQUIRES: options.strategy is non-interactive
+// EFFECTS: Deals and bids options.deals deals on pool, taking the Simple
+//          or Learned fast path when it applies.  Results do not depend on the number
+//          of threads.
+BiddingSummary run_bidding(const BiddingOptions &options, ThreadPool &pool);
+
+// EFFECTS: Prints summary as a short report
+void print_bidding(const BiddingSummary &summary, std::ostream &os);
+
+// EFFECTS: Runs bidding from command line arguments DEALS THREADS
+//          [--strategy S] [--seed N] [--check] and prints the report.
+//          --check also bids every deal through Player objects, reports
+//          both rates and fails if any outcome differs.  Returns the
+//          process exit status.
+int bidding_main(int argc, char **argv);
+
+#endif // BIDDING_HPP
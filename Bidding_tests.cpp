@@ -0,0 +1,91 @@
+#include "Bidding.hpp"
+#include "Card.hpp"
+#include "unit_test_framework.hpp"
+
+#include <vector>
+
+using namespace std;
+
+TEST(test_fast_path_matches_players) {
+    vector<DealRecord> deals(5000);
+    generate_deals(21, 0, int(deals.size()), deals.data());
+    vector<BidOutcome> outcomes(deals.size());
+    bid_simple(deals.data(), int(deals.size()), outcomes.data());
+    const array<string, 4> simple = {"Simple", "Simple", "Simple", "Simple"};
+    int round_one = 0;
+    for (size_t i = 0; i < deals.size(); i++) {
+        const BidOutcome expected = bid_with_players(deals[i], simple);
+        ASSERT_TRUE(outcomes[i] == expected);
+        round_one += outcomes[i].round == 1;
+    }
+    // both rounds and the discard are exercised
+    ASSERT_TRUE(round_one > 1000);
+    ASSERT_TRUE(round_one < 4900);
+}
+
+TEST(test_learned_fast_path_matches_players) {
+    vector<DealRecord> deals(3000);
+    generate_deals(5, 0, int(deals.size()), deals.data());
+    vector<BidOutcome> outcomes(deals.size());
+    bid_learned(learned_default_model(), deals.data(), int(deals.size()), outcomes.data());
+    const array<string, 4> learned = {"Learned", "Learned", "Learned", "Learned"};
+    array<int, 2> rounds{};
+    array<int, 4> makers{};
+    for (size_t i = 0; i < deals.size(); i++) {
+        const BidOutcome expected = bid_with_players(deals[i], learned);
+        ASSERT_TRUE(outcomes[i] == expected);
+        rounds[outcomes[i].round - 1]++;
+        makers[outcomes[i].maker]++;
+    }
+    // both rounds and every seat are exercised
+    ASSERT_TRUE(rounds[0] > 300);
+    ASSERT_TRUE(rounds[1] > 300);
+    for (int count : makers) {
+        ASSERT_TRUE(count > 30);
+    }
+}
+
+TEST(test_discard_is_lowest_card) {
+    vector<DealRecord> deals(2000);
+    generate_deals(8, 0, int(deals.size()), deals.data());
+    vector<BidOutcome> outcomes(deals.size());
+    bid_simple(deals.data(), int(deals.size()), outcomes.data());
+    for (size_t i = 0; i < deals.size(); i++) {
+        if (outcomes[i].round != 1) {
+            ASSERT_EQUAL(outcomes[i].discard, -1);
+            continue;
+        }
+        const Suit trump = Suit(outcomes[i].trump);
+        const Card discard = Card_from_index(outcomes[i].discard);
+        const uint32_t held = deals[i].hands[0] | (uint32_t(1) << deals[i].upcard);
+        ASSERT_TRUE(held & (uint32_t(1) << outcomes[i].discard));
+        for (uint32_t cards = held; cards; cards &= cards - 1) {
+            const Card card = Card_from_index(__builtin_ctz(cards));
+            ASSERT_TRUE(card == discard || Card_less(discard, card, trump));
+        }
+    }
+}
+
+TEST(test_run_bidding_is_reproducible) {
+    BiddingOptions options;
+    options.deals = 10000;
+    options.seed = 3;
+    ThreadPool one(1);
+    ThreadPool three(3);
+    const BiddingSummary fast = run_bidding(options, three);
+    ASSERT_EQUAL(fast.deals, 10000);
+    ASSERT_TRUE(fast == run_bidding(options, one));
+
+    options.fast_path = false;
+    ASSERT_TRUE(fast == run_bidding(options, three));
+
+    long total = 0;
+    for (const array<long, 4> &round : fast.orders) {
+        for (long count : round) {
+            total += count;
+        }
+    }
+    ASSERT_EQUAL(total, 10000);
+}
+
+TEST_MAIN()
@@ -93,37 +93,81 @@ std::istream & operator>>(std::istream &is, Suit &suit) {
 
 /////////////// Write your implementation for Card below ///////////////
 
-Card::Card() : rank(TWO), suit(SPADES) {}
+static_assert(sizeof(Card) == 1, "Card should be a single byte");
 
-Card::Card(Rank rank_in, Suit suit_in) : rank(rank_in), suit(suit_in) {}
+namespace {
+  const int EUCHRE_CARDS = 24;
+  const int EUCHRE_RANKS = 6;
+  const int LOW_RANKS = 7; // Two through Eight
 
-Rank Card::get_rank() const {return rank;}
+  constexpr int make_id(Rank rank, Suit suit) {
+    return rank >= NINE ? suit * EUCHRE_RANKS + (rank - NINE)
+                        : EUCHRE_CARDS + suit * LOW_RANKS + rank;
+  }
+
+  // rank, suit and trump-free order of every id
+  struct IdTables {
+    Rank rank[Card::NUM_IDS];
+    Suit suit[Card::NUM_IDS];
+    uint8_t order[Card::NUM_IDS];
+  };
+
+  constexpr IdTables make_id_tables() {
+    IdTables tables{};
+    for (int r = TWO; r <= ACE; ++r) {
+      for (int s = SPADES; s <= DIAMONDS; ++s) {
+        const int id = make_id(Rank(r), Suit(s));
+        tables.rank[id] = Rank(r);
+        tables.suit[id] = Suit(s);
+        tables.order[id] = uint8_t(r * 4 + s);
+      }
+    }
+    return tables;
+  }
+
+  constexpr IdTables ID_TABLES = make_id_tables();
+}
 
-Suit Card::get_suit() const {return suit;}
+Card::Card() : id(make_id(TWO, SPADES)) {}
+
+Card::Card(Rank rank_in, Suit suit_in) : id(make_id(rank_in, suit_in)) {}
+
+Rank Card::get_rank() const {return ID_TABLES.rank[id];}
+
+Suit Card::get_suit() const {return ID_TABLES.suit[id];}
+
+uint8_t Card::get_id() const {return id;}
+
+Card Card::from_id(int id_in) {
+  assert(0 <= id_in && id_in < NUM_IDS);
+  Card card;
+  card.id = uint8_t(id_in);
+  return card;
+}
 
 Suit Card::get_suit(Suit trump) const {
   if(Card::is_left_bower(trump)){
     return trump;
   } else{
-    return suit;
+    return get_suit();
   }
 }
 
 bool Card::is_face_or_ace() const {
-  return rank >= 9;
+  return get_rank() >= 9;
 }
 
 bool Card::is_right_bower(Suit trump) const {
-  return rank == JACK && suit == trump;
+  return id == make_id(JACK, trump);
 }
 
 bool Card::is_left_bower(Suit trump) const {
   Suit same_color_suit = Suit_next(trump); // suit of same color as trump suit
-  return rank == JACK && suit == same_color_suit;
+  return id == make_id(JACK, same_color_suit);
 }
 
 bool Card::is_trump(Suit trump) const {
-  return (suit == trump) || is_left_bower(trump);
+  return (get_suit() == trump) || is_left_bower(trump);
 }
 
 std::ostream & operator<<(std::ostream &os, const Card &card){
@@ -140,22 +184,18 @@ std::istream & operator>>(std::istream &is, Card &card){
   is >> rank_in;
   is >> of; 
   is >> suit_in;
-  card.rank = string_to_rank(rank_in);
-  card.suit = string_to_suit(suit_in);
+  card.id = make_id(string_to_rank(rank_in), string_to_suit(suit_in));
   return is;
 }
 
 bool operator<(const Card &lhs, const Card &rhs){
-  if(lhs.get_rank() == rhs.get_rank()){
-    // suits in order of value
-    // DIAMONDS(3) > CLUBS(2) > HEARTS(1) > SPADES(0)
-    return lhs.get_suit() < rhs.get_suit();
-  }
-  return lhs.get_rank() < rhs.get_rank();
+  // by rank, then suits in order of value
+  // DIAMONDS(3) > CLUBS(2) > HEARTS(1) > SPADES(0)
+  return ID_TABLES.order[lhs.get_id()] < ID_TABLES.order[rhs.get_id()];
 }
 
 bool operator==(const Card &lhs, const Card &rhs){
-  return (lhs.get_rank() == rhs.get_rank()) && (lhs.get_suit() == rhs.get_suit());
+  return lhs.get_id() == rhs.get_id();
 }
 
 bool operator<=(const Card &lhs, const Card &rhs){
@@ -205,13 +245,12 @@ bool Card_less(const Card &a, const Card &b, const Card &led_card, Suit trump){
   return a < b; 
 }
 
+int Card_to_index(const Card &card){
+  assert(card.get_id() < EUCHRE_CARDS);
+  return card.get_id();
+}
 
-
-
-
-
-
-
-
-
-
+Card Card_from_index(int index){
+  assert(0 <= index && index < EUCHRE_CARDS);
+  return Card::from_id(index);
+}
@@ -9,6 +9,7 @@
  * 2014-12-21
  */
 
+#include <cstdint>
 #include <iostream>
 
 // Represent a Card's Rank.
@@ -105,9 +106,21 @@ public:
   // suit are trump cards.  The left bower is also a trump card.
   bool is_trump(Suit trump) const;
 
+  // Number of distinct card ids: the 24 euchre cards come first, then the
+  // Twos through Eights
+  static const int NUM_IDS = 52;
+
+  //EFFECTS Returns the card's id.  A euchre card's id is its bitboard
+  // position, suit * 6 + (rank - NINE).
+  uint8_t get_id() const;
+
+  //REQUIRES 0 <= id < NUM_IDS
+  //EFFECTS Returns the card with the given id
+  static Card from_id(int id);
+
 private:
-  Rank rank;
-  Suit suit;
+  // a single byte, so packs and hands stay compact
+  uint8_t id;
 
   // This "friend declaration" allows the implementation of operator>>
   // to access private member variables of the Card class.
@@ -157,4 +170,13 @@ bool Card_less(const Card &a, const Card &b, Suit trump);
 //  and the suit led to determine order, as described in the spec.
 bool Card_less(const Card &a, const Card &b, const Card &led_card, Suit trump);
 
+//REQUIRES card's rank is NINE or higher
+//EFFECTS Returns a dense index from 0 to 23 for a euchre card, in the
+//  standard pack order (suit major, then rank)
+int Card_to_index(const Card &card);
+
+//REQUIRES 0 <= index < 24
+//EFFECTS Returns the euchre card with the given index
+Card Card_from_index(int index);
+
 #endif // CARD_HPP
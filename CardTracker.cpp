@@ -0,0 +1,257 @@
+#include "CardTracker.hpp"
+#include "HandFeatures.hpp"
+#include <cassert>
+
+using namespace std;
+
+namespace
+{
+    const int NUM_CARDS = 24;
+
+    uint32_t bit(int card)
+    {
+        return uint32_t(1) << card;
+    }
+}
+
+CardTracker::CardTracker()
+    : dealer(0), trump_made(false), trump(SPADES), maker(0), num_passes(0),
+      upcard_taken(false), discard(0), num_played(0), leader(0), tricks{},
+      played_cards(0), player_cards{}, voids{}, trick{}, trick_winner(0),
+      effective_suits(&suit_masks(SPADES)) {}
+
+void CardTracker::observe(const PlayerEvent &event)
+{
+    switch (event.type)
+    {
+    case PlayerEvent::HAND_STARTED:
+        *this = CardTracker();
+        dealer = event.player;
+        upcard = event.card;
+        leader = (dealer + 1) % NUM_PLAYERS;
+        break;
+
+    case PlayerEvent::PASSED:
+        num_passes++;
+        break;
+
+    case PlayerEvent::ORDERED_UP:
+        trump_made = true;
+        trump = event.trump;
+        maker = event.player;
+        upcard_taken = event.round == 1;
+        effective_suits = &suit_masks(trump);
+        break;
+
+    case PlayerEvent::CARD_PLAYED:
+    {
+        assert(trump_made && event.player == to_move());
+        const int card = Card_to_index(event.card);
+        const int in_trick = num_played % NUM_PLAYERS;
+        played_cards |= bit(card);
+        player_cards[event.player] |= bit(card);
+        trick[in_trick] = card;
+        if (in_trick == 0)
+        {
+            trick_winner = event.player;
+        }
+        else
+        {
+            const Card led = Card_from_index(trick[0]);
+            const Suit led_suit = led.get_suit(trump);
+            if (!((*effective_suits)[led_suit] & bit(card)))
+            {
+                voids[event.player] |= 1u << led_suit;
+            }
+            if (Card_less(get_trick_high(), event.card, led, trump))
+            {
+                trick_winner = event.player;
+            }
+        }
+        num_played++;
+        if (in_trick == NUM_PLAYERS - 1)
+        {
+            leader = trick_winner;
+            tricks[leader % 2]++;
+        }
+        break;
+    }
+
+    case PlayerEvent::TRICK_WON:
+        assert(num_played % NUM_PLAYERS == 0 && event.player == leader);
+        break;
+    }
+}
+
+int CardTracker::get_dealer() const
+{
+    return dealer;
+}
+
+Card CardTracker::get_upcard() const
+{
+    return upcard;
+}
+
+int CardTracker::get_num_passes() const
+{
+    return num_passes;
+}
+
+int CardTracker::bid_position(const Card &card, bool is_dealer) const
+{
+    if (is_dealer)
+    {
+        return 3;
+    }
+    return upcard == card ? num_passes % NUM_PLAYERS : 0;
+}
+
+bool CardTracker::is_trump_made() const
+{
+    return trump_made;
+}
+
+Suit CardTracker::get_trump() const
+{
+    assert(trump_made);
+    return trump;
+}
+
+int CardTracker::get_maker() const
+{
+    assert(trump_made);
+    return maker;
+}
+
+bool CardTracker::is_upcard_taken() const
+{
+    assert(trump_made);
+    return upcard_taken;
+}
+
+int CardTracker::get_num_played() const
+{
+    return num_played;
+}
+
+int CardTracker::get_leader() const
+{
+    assert(trump_made);
+    return leader;
+}
+
+int CardTracker::to_move() const
+{
+    assert(trump_made);
+    return (leader + num_played % NUM_PLAYERS) % NUM_PLAYERS;
+}
+
+Card CardTracker::get_led_card() const
+{
+    assert(num_played % NUM_PLAYERS != 0);
+    return Card_from_index(trick[0]);
+}
+
+int CardTracker::get_trick_winner() const
+{
+    assert(num_played % NUM_PLAYERS != 0);
+    return trick_winner;
+}
+
+Card CardTracker::get_trick_high() const
+{
+    assert(num_played % NUM_PLAYERS != 0);
+    return Card_from_index(trick[(trick_winner - leader + NUM_PLAYERS) % NUM_PLAYERS]);
+}
+
+int CardTracker::get_tricks(int team) const
+{
+    return tricks[team];
+}
+
+uint32_t CardTracker::played() const
+{
+    return played_cards;
+}
+
+uint32_t CardTracker::played_by(int player) const
+{
+    return player_cards[player];
+}
+
+uint32_t CardTracker::current_trick() const
+{
+    uint32_t result = 0;
+    for (int i = 0; i < num_played % NUM_PLAYERS; i++)
+    {
+        result |= bit(trick[i]);
+    }
+    return result;
+}
+
+unsigned CardTracker::void_suits(int player) const
+{
+    return voids[player];
+}
+
+bool CardTracker::is_void(int player, Suit suit) const
+{
+    return voids[player] & (1u << suit);
+}
+
+uint32_t CardTracker::suit_cards(Suit suit) const
+{
+    assert(trump_made);
+    return (*effective_suits)[suit];
+}
+
+uint32_t CardTracker::remaining_trump() const
+{
+    return suit_cards(trump) & ~played_cards;
+}
+
+uint32_t CardTracker::known(int player) const
+{
+    const uint32_t upcard_bit = bit(Card_to_index(upcard));
+    if (trump_made && upcard_taken && player == dealer &&
+        !(player_cards[player] & upcard_bit))
+    {
+        return upcard_bit;
+    }
+    return 0;
+}
+
+void CardTracker::observe_discard(const Card &card)
+{
+    assert(trump_made && upcard_taken);
+    discard = bit(Card_to_index(card));
+}
+
+DealConstraints CardTracker::constraints(int seat, uint32_t hand) const
+{
+    assert(trump_made);
+    DealConstraints result;
+    uint32_t seen = hand | played_cards | bit(Card_to_index(upcard));
+    if (seat == dealer)
+    {
+        seen |= discard;
+    }
+    for (int player = 0; player < NUM_PLAYERS; player++)
+    {
+        if (player == seat)
+        {
+            continue;
+        }
+        const uint32_t held = known(player);
+        seen |= held;
+        result.need[player] = Player::MAX_HAND_SIZE -
+                              __builtin_popcount(player_cards[player] | held);
+        for (unsigned suits = voids[player]; suits; suits &= suits - 1)
+        {
+            result.excluded[player] |= (*effective_suits)[__builtin_ctz(suits)];
+        }
+    }
+    result.unseen = ((uint32_t(1) << NUM_CARDS) - 1) & ~seen;
+    return result;
+}
@@ -0,0 +1,148 @@
+#ifndef CARDTRACKER_HPP
+#define CARDTRACKER_HPP
+/* CardTracker.hpp
+ *
+ * Everything the public events of a hand reveal, kept as card bitmasks in
+ * the GameState convention (bit Card_to_index(card)).  Each event updates
+ * the tracker in constant time: which cards are gone and who played them,
+ * which suits each seat has shown void in, and what trump is still out.
+ * A search player asks it for the constraints on the hidden cards instead
+ * of working them out from the play history.
+ */
+
+#include <array>
+#include <cstdint>
+#include "Card.hpp"
+#include "DealSampler.hpp"
+#include "Player.hpp"
+
+class CardTracker
+{
+public:
+    static const int NUM_PLAYERS = 4;
+
+    // EFFECTS: Creates a tracker waiting for a hand to start
+    CardTracker();
+
+    // REQUIRES: events arrive in the order a Game sends them, starting with
+    //           HAND_STARTED
+    // MODIFIES: this
+    // EFFECTS: Records event.  HAND_STARTED forgets the previous hand.
+    void observe(const PlayerEvent &event);
+
+    int get_dealer() const;
+    Card get_upcard() const;
+
+    // EFFECTS: returns the number of passes so far this hand
+    int get_num_passes() const;
+
+    // EFFECTS: returns the position, counted from the dealer's left, of a
+    //          player bidding on upcard now: 3 for the dealer, otherwise
+    //          from the passes seen this hand, or 0 if the tracker is not
+    //          following the hand upcard belongs to
+    int bid_position(const Card &upcard, bool is_dealer) const;
+
+    // EFFECTS: returns true once someone has ordered up
+    bool is_trump_made() const;
+
+    // REQUIRES: is_trump_made()
+    Suit get_trump() const;
+    int get_maker() const;
+
+    // REQUIRES: is_trump_made()
+    // EFFECTS: returns true if trump was ordered up in round one, so the
+    //          dealer picked up the upcard
+    bool is_upcard_taken() const;
+
+    // EFFECTS: returns the number of cards played this hand
+    int get_num_played() const;
+
+    // REQUIRES: is_trump_made()
+    // EFFECTS: returns the player who led the current trick, or who leads
+    //          next if it is complete
+    int get_leader() const;
+
+    // REQUIRES: is_trump_made()
+    // EFFECTS: returns the player whose turn it is to play
+    int to_move() const;
+
+    // REQUIRES: a trick is in progress
+    // EFFECTS: returns the first card of the trick
+    Card get_led_card() const;
+
+    // REQUIRES: a trick is in progress
+    // EFFECTS: returns the player whose card is winning the trick so far
+    int get_trick_winner() const;
+
+    // REQUIRES: a trick is in progress
+    // EFFECTS: returns the card winning the trick so far
+    Card get_trick_high() const;
+
+    // EFFECTS: returns the tricks taken so far by team
+    int get_tricks(int team) const;
+
+    // EFFECTS: returns the cards played this hand
+    uint32_t played() const;
+
+    // EFFECTS: returns the cards player has played this hand
+    uint32_t played_by(int player) const;
+
+    // EFFECTS: returns the cards played to the current trick
+    uint32_t current_trick() const;
+
+    // EFFECTS: returns a mask with bit s set when player has failed to
+    //          follow suit s (by effective suit, so the left bower is trump)
+    unsigned void_suits(int player) const;
+
+    // EFFECTS: returns true if player has shown void in suit
+    bool is_void(int player, Suit suit) const;
+
+    // REQUIRES: is_trump_made()
+    // EFFECTS: returns the cards whose effective suit is suit
+    uint32_t suit_cards(Suit suit) const;
+
+    // REQUIRES: is_trump_made()
+    // EFFECTS: returns the trump cards not yet played
+    uint32_t remaining_trump() const;
+
+    // EFFECTS: returns the cards every other seat knows player holds: the
+    //          upcard, for a dealer who picked it up and has not played it.
+    //          The dealer is assumed to have kept it.
+    uint32_t known(int player) const;
+
+    // REQUIRES: is_upcard_taken(), and this tracker is the dealer's
+    // MODIFIES: this
+    // EFFECTS: Records the card the dealer put down.  No other seat sees
+    //          it, so it is not a PlayerEvent.
+    void observe_discard(const Card &card);
+
+    // REQUIRES: is_trump_made(), hand is what seat holds now, and if seat is
+    //           the dealer who picked up, observe_discard() has been told
+    //           its discard
+    // EFFECTS: returns the constraints on the cards seat cannot see: each
+    //          other player's hidden card count, the cards of the suits they
+    //          are void in, and every card not in hand, played, known or,
+    //          for the dealer, discarded
+    DealConstraints constraints(int seat, uint32_t hand) const;
+
+private:
+    int dealer;
+    Card upcard;
+    bool trump_made;
+    Suit trump;
+    int maker;
+    int num_passes;
+    bool upcard_taken;
+    uint32_t discard;     // the dealer's own discard, if observed
+    int num_played;
+    int leader;
+    std::array<int, 2> tricks;
+    uint32_t played_cards;
+    std::array<uint32_t, NUM_PLAYERS> player_cards;
+    std::array<unsigned, NUM_PLAYERS> voids;
+    std::array<int, NUM_PLAYERS> trick;   // card indices of the current trick
+    int trick_winner;
+    const std::array<uint32_t, 4> *effective_suits;   // suit_masks(trump)
+};
+
+#endif // CARDTRACKER_HPP
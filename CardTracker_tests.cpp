@@ -0,0 +1,241 @@
+#include "CardTracker.hpp"
+#include "AsyncGame.hpp"
+#include "unit_test_framework.hpp"
+
+#include <memory>
+#include <sstream>
+#include <vector>
+
+using namespace std;
+
+static uint32_t bit(const Card &card) {
+    return uint32_t(1) << Card_to_index(card);
+}
+
+static PlayerEvent event(PlayerEvent::Type type, int player) {
+    PlayerEvent result{type};
+    result.player = player;
+    return result;
+}
+
+static PlayerEvent played(int player, const Card &card) {
+    PlayerEvent result = event(PlayerEvent::CARD_PLAYED, player);
+    result.card = card;
+    return result;
+}
+
+// dealer 0 turns up the Nine of Hearts and player 1 orders it up
+static CardTracker hearts_ordered_up() {
+    CardTracker tracker;
+    PlayerEvent started = event(PlayerEvent::HAND_STARTED, 0);
+    started.card = Card(NINE, HEARTS);
+    tracker.observe(started);
+    PlayerEvent ordered = event(PlayerEvent::ORDERED_UP, 1);
+    ordered.trump = HEARTS;
+    ordered.round = 1;
+    tracker.observe(ordered);
+    return tracker;
+}
+
+TEST(test_tracker_follows_the_bidding) {
+    CardTracker tracker = hearts_ordered_up();
+    ASSERT_EQUAL(tracker.get_dealer(), 0);
+    ASSERT_EQUAL(tracker.get_upcard(), Card(NINE, HEARTS));
+    ASSERT_TRUE(tracker.is_trump_made());
+    ASSERT_EQUAL(tracker.get_trump(), HEARTS);
+    ASSERT_EQUAL(tracker.get_maker(), 1);
+    ASSERT_TRUE(tracker.is_upcard_taken());
+    ASSERT_EQUAL(tracker.to_move(), 1);
+    ASSERT_EQUAL(tracker.known(0), bit(Card(NINE, HEARTS)));
+    ASSERT_EQUAL(tracker.known(1), 0u);
+    ASSERT_EQUAL(__builtin_popcount(tracker.remaining_trump()), 7);
+}
+
+TEST(test_tracker_records_a_trick) {
+    CardTracker tracker = hearts_ordered_up();
+    // the left bower is led, so the Ace of Diamonds fails to follow trump
+    tracker.observe(played(1, Card(JACK, DIAMONDS)));
+    tracker.observe(played(2, Card(ACE, DIAMONDS)));
+    tracker.observe(played(3, Card(JACK, HEARTS)));
+    ASSERT_EQUAL(tracker.current_trick(), bit(Card(JACK, DIAMONDS)) |
+                                              bit(Card(ACE, DIAMONDS)) | bit(Card(JACK, HEARTS)));
+    tracker.observe(played(0, Card(NINE, HEARTS)));
+    tracker.observe(event(PlayerEvent::TRICK_WON, 3));
+
+    ASSERT_EQUAL(tracker.get_num_played(), 4);
+    ASSERT_EQUAL(tracker.get_leader(), 3);
+    ASSERT_EQUAL(tracker.to_move(), 3);
+    ASSERT_EQUAL(tracker.get_tricks(1), 1);
+    ASSERT_EQUAL(tracker.get_tricks(0), 0);
+    ASSERT_EQUAL(tracker.current_trick(), 0u);
+    ASSERT_EQUAL(tracker.played_by(2), bit(Card(ACE, DIAMONDS)));
+    ASSERT_EQUAL(__builtin_popcount(tracker.played()), 4);
+
+    ASSERT_TRUE(tracker.is_void(2, HEARTS));
+    ASSERT_EQUAL(tracker.void_suits(2), 1u << HEARTS);
+    ASSERT_EQUAL(tracker.void_suits(0), 0u);
+    ASSERT_EQUAL(tracker.void_suits(3), 0u);
+
+    // the dealer played the upcard, so it is no longer known to be held
+    ASSERT_EQUAL(tracker.known(0), 0u);
+    ASSERT_EQUAL(tracker.remaining_trump(),
+                 tracker.suit_cards(HEARTS) & ~(bit(Card(JACK, DIAMONDS)) |
+                                                bit(Card(JACK, HEARTS)) |
+                                                bit(Card(NINE, HEARTS))));
+    ASSERT_EQUAL(__builtin_popcount(tracker.remaining_trump()), 4);
+}
+
+TEST(test_tracker_constraints) {
+    CardTracker tracker = hearts_ordered_up();
+    tracker.observe(played(1, Card(KING, SPADES)));
+    tracker.observe(played(2, Card(TEN, CLUBS)));
+
+    const uint32_t hand = bit(Card(ACE, HEARTS)) | bit(Card(KING, HEARTS)) |
+                          bit(Card(QUEEN, HEARTS)) | bit(Card(TEN, HEARTS)) |
+                          bit(Card(NINE, CLUBS));
+    const DealConstraints constraints = tracker.constraints(3, hand);
+    ASSERT_EQUAL(constraints.need[0], 4);
+    ASSERT_EQUAL(constraints.need[1], 4);
+    ASSERT_EQUAL(constraints.need[2], 4);
+    ASSERT_EQUAL(constraints.need[3], 0);
+    ASSERT_EQUAL(constraints.excluded[2], tracker.suit_cards(SPADES));
+    ASSERT_EQUAL(constraints.excluded[0], 0u);
+    // 24 cards less the hand, two played and the upcard
+    ASSERT_EQUAL(__builtin_popcount(constraints.unseen), 16);
+    ASSERT_EQUAL(constraints.unseen & (hand | bit(Card(NINE, HEARTS))), 0u);
+}
+
+TEST(test_tracker_keeps_dealer_discard_out) {
+    CardTracker tracker = hearts_ordered_up();
+    tracker.observe_discard(Card(QUEEN, CLUBS));
+
+    // the dealer knows where its discard went
+    const uint32_t hand = bit(Card(NINE, HEARTS)) | bit(Card(ACE, HEARTS)) |
+                          bit(Card(KING, SPADES)) | bit(Card(TEN, CLUBS)) |
+                          bit(Card(ACE, DIAMONDS));
+    DealConstraints constraints = tracker.constraints(0, hand);
+    ASSERT_EQUAL(__builtin_popcount(constraints.unseen), 18);
+    ASSERT_EQUAL(constraints.unseen & bit(Card(QUEEN, CLUBS)), 0u);
+
+    // to anyone else it could be in any hidden hand
+    constraints = tracker.constraints(1, bit(Card(JACK, CLUBS)));
+    ASSERT_TRUE(constraints.unseen & bit(Card(QUEEN, CLUBS)));
+}
+
+TEST(test_tracker_starts_a_new_hand) {
+    CardTracker tracker = hearts_ordered_up();
+    tracker.observe(played(1, Card(KING, SPADES)));
+    tracker.observe(played(2, Card(TEN, CLUBS)));
+    PlayerEvent started = event(PlayerEvent::HAND_STARTED, 1);
+    started.card = Card(ACE, CLUBS);
+    tracker.observe(started);
+    ASSERT_FALSE(tracker.is_trump_made());
+    ASSERT_EQUAL(tracker.get_dealer(), 1);
+    ASSERT_EQUAL(tracker.played(), 0u);
+    ASSERT_EQUAL(tracker.void_suits(2), 0u);
+
+    PlayerEvent ordered = event(PlayerEvent::ORDERED_UP, 3);
+    ordered.trump = SPADES;
+    ordered.round = 2;
+    tracker.observe(ordered);
+    ASSERT_FALSE(tracker.is_upcard_taken());
+    ASSERT_EQUAL(tracker.known(1), 0u);
+    ASSERT_EQUAL(tracker.to_move(), 2);
+}
+
+// A Simple player that tracks the hand and keeps a copy of its tracker
+// after every card, to check against the cards really held
+class TrackingPlayer : public Player {
+public:
+    TrackingPlayer(const string &name, vector<CardTracker> &snapshots)
+        : player(Player_factory(name, "Simple")), snapshots(snapshots) {}
+
+    const string & get_name() const override {
+        return player->get_name();
+    }
+    void add_card(const Card &c) override {
+        player->add_card(c);
+    }
+    bool make_trump(const Card &upcard, bool is_dealer, int round,
+                    Suit &order_up_suit) const override {
+        return player->make_trump(upcard, is_dealer, round, order_up_suit);
+    }
+    void add_and_discard(const Card &upcard) override {
+        player->add_and_discard(upcard);
+    }
+    Card lead_card(Suit trump) override {
+        return player->lead_card(trump);
+    }
+    Card play_card(const Card &led_card, Suit trump) override {
+        return player->play_card(led_card, trump);
+    }
+    void observe(const PlayerEvent &event) override {
+        tracker.observe(event);
+        if (event.type == PlayerEvent::ORDERED_UP || event.type == PlayerEvent::CARD_PLAYED) {
+            snapshots.push_back(tracker);
+        }
+    }
+
+private:
+    unique_ptr<Player> player;
+    CardTracker tracker;
+    vector<CardTracker> &snapshots;
+};
+
+// REQUIRES: snapshots are one complete hand
+// EFFECTS: checks that the cards each player really held satisfy the
+//          constraints every seat's tracker gave at every point
+static void check_hand(const vector<CardTracker> &snapshots) {
+    const CardTracker &end = snapshots.back();
+    ASSERT_EQUAL(end.get_num_played(), 20);
+    ASSERT_EQUAL(end.get_tricks(0) + end.get_tricks(1), 5);
+    for (const CardTracker &tracker : snapshots) {
+        for (int seat = 0; seat < 4; seat++) {
+            const uint32_t hand = end.played_by(seat) & ~tracker.played_by(seat);
+            const DealConstraints constraints = tracker.constraints(seat, hand);
+            for (int player = 0; player < 4; player++) {
+                const uint32_t held = end.played_by(player) & ~tracker.played_by(player);
+                if (player == seat || (tracker.known(player) & ~held)) {
+                    // the dealer discarded the upcard, against the assumption
+                    continue;
+                }
+                const uint32_t hidden = held & ~tracker.known(player);
+                ASSERT_EQUAL(__builtin_popcount(hidden), constraints.need[player]);
+                ASSERT_EQUAL(hidden & ~constraints.unseen, 0u);
+                ASSERT_EQUAL(hidden & constraints.excluded[player], 0u);
+            }
+        }
+    }
+}
+
+TEST(test_tracker_agrees_with_played_games) {
+    for (uint64_t seed = 1; seed <= 3; seed++) {
+        array<vector<CardTracker>, 4> snapshots;
+        array<unique_ptr<AsyncPlayer>, 4> owned;
+        array<AsyncPlayer *, 4> players;
+        for (int i = 0; i < 4; i++) {
+            owned[i].reset(new SyncPlayerAdapter(
+                new TrackingPlayer("Player " + to_string(i), snapshots[i])));
+            players[i] = owned[i].get();
+        }
+        ostringstream output;
+        AsyncGame game(players, 10, seed, output);
+        Task<Team_Number> task = game.play();
+        task.start();
+        ASSERT_TRUE(task.done());
+
+        // every seat sees the same public events
+        for (int i = 1; i < 4; i++) {
+            ASSERT_EQUAL(snapshots[i].size(), snapshots[0].size());
+        }
+        // split the snapshots into hands: one order-up and 20 cards each
+        const size_t per_hand = 21;
+        ASSERT_EQUAL(snapshots[0].size() % per_hand, 0u);
+        for (size_t start = 0; start < snapshots[0].size(); start += per_hand) {
+            check_hand(vector<CardTracker>(snapshots[0].begin() + start,
+                                           snapshots[0].begin() + start + per_hand));
+        }
+    }
+}
+
+TEST_MAIN()
@@ -24,4 +24,36 @@ TEST(card_less_with_trump_and_led) {
     ASSERT_TRUE(Card_less(Card(KING,SPADES), Card(JACK,CLUBS), qOfD, trump));
 }
 
+TEST(test_card_index_round_trip) {
+    for (int index = 0; index < 24; index++) {
+        ASSERT_EQUAL(Card_to_index(Card_from_index(index)), index);
+    }
+    ASSERT_EQUAL(Card_to_index(Card(NINE, SPADES)), 0);
+    ASSERT_EQUAL(Card_to_index(Card(ACE, DIAMONDS)), 23);
+}
+
+TEST(test_card_is_one_byte_id) {
+    ASSERT_EQUAL(sizeof(Card), size_t(1));
+    for (int r = TWO; r <= ACE; ++r) {
+        for (int s = SPADES; s <= DIAMONDS; ++s) {
+            Card c(static_cast<Rank>(r), static_cast<Suit>(s));
+            ASSERT_TRUE(c.get_id() < Card::NUM_IDS);
+            ASSERT_EQUAL(Card::from_id(c.get_id()), c);
+            ASSERT_EQUAL(c.get_rank(), r);
+            ASSERT_EQUAL(c.get_suit(), s);
+            ASSERT_EQUAL(c.get_id() < 24, r >= NINE);
+        }
+    }
+    // order is by rank, then suit, for every pair
+    for (int a = 0; a < Card::NUM_IDS; ++a) {
+        for (int b = 0; b < Card::NUM_IDS; ++b) {
+            Card x = Card::from_id(a);
+            Card y = Card::from_id(b);
+            bool expected = x.get_rank() < y.get_rank() ||
+                (x.get_rank() == y.get_rank() && x.get_suit() < y.get_suit());
+            ASSERT_EQUAL(x < y, expected);
+        }
+    }
+}
+
 TEST_MAIN()
@@ -0,0 +1,176 @@
+#include "CfrBidding.hpp"
+#include "HandFeatures.hpp"
+#include "Random.hpp"
+#include "SimpleTable.hpp"
+#include <algorithm>
+#include <bit>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+
+using namespace std;
+
+namespace
+{
+    const int NUM_PLAYERS = 4;
+    const int NUM_SUITS = 4;
+
+    uint32_t bit(int card)
+    {
+        return uint32_t(1) << card;
+    }
+
+    // EFFECTS: returns the other suit hand is longest in, then strongest
+    Suit round_two_candidate(uint32_t hand, Suit upcard_suit)
+    {
+        Suit best = upcard_suit;
+        int best_score = -1;
+        for (int suit = 0; suit < NUM_SUITS; suit++)
+        {
+            if (suit == upcard_suit)
+            {
+                continue;
+            }
+            const HandFeatures features = hand_features(hand, Suit(suit));
+            const int score = features.trumps * 64 + features.trump_rank_sum;
+            if (score > best_score)
+            {
+                best = Suit(suit);
+                best_score = score;
+            }
+        }
+        return best;
+    }
+}
+
+int cfr_infoset(uint32_t hand, int upcard, int position, int round, Suit &candidate)
+{
+    const Card up = Card_from_index(upcard);
+    const Suit upcard_suit = up.get_suit();
+    bool flag = false;
+    if (round == 1)
+    {
+        candidate = upcard_suit;
+        flag = up.get_rank() == JACK;
+        if (position == NUM_PLAYERS - 1)
+        {
+            hand = (hand | bit(upcard)) & ~bit(simple_discard(hand, upcard, upcard_suit));
+        }
+    }
+    else
+    {
+        candidate = round_two_candidate(hand, upcard_suit);
+        flag = candidate == Suit_next(upcard_suit);
+    }
+    const HandFeatures f = hand_features(hand, candidate);
+    const int bowers = f.right_bower + 2 * f.left_bower;
+    const int other_good = std::min(f.good_trumps - f.right_bower - f.left_bower, 3);
+    int index = round - 1;
+    index = index * 4 + position;
+    index = index * 6 + f.trumps;
+    index = index * 4 + bowers;
+    index = index * 4 + other_good;
+    index = index * 4 + std::min<int>(f.off_aces, 3);
+    index = index * 4 + std::min<int>(f.voids, 3);
+    return index * 2 + flag;
+}
+
+void write_cfr_strategy(std::ostream &os, const CfrStrategy &strategy)
+{
+    const long count = std::count_if(strategy.order.begin(), strategy.order.end(),
+                                     [](float p) { return p >= 0; });
+    os << "cfr 1 " << CFR_INFOSETS << " " << count << "\n";
+    os << setprecision(6);
+    for (int infoset = 0; infoset < CFR_INFOSETS; infoset++)
+    {
+        if (strategy.order[infoset] >= 0)
+        {
+            os << infoset << " " << strategy.order[infoset] << "\n";
+        }
+    }
+}
+
+bool read_cfr_strategy(std::istream &is, CfrStrategy &strategy)
+{
+    string magic;
+    int version = 0;
+    int infosets = 0;
+    long count = -1;
+    if (!(is >> magic >> version >> infosets >> count) || magic != "cfr" ||
+        version != 1 || infosets != CFR_INFOSETS || count < 0 || count > CFR_INFOSETS)
+    {
+        return false;
+    }
+    CfrStrategy read;
+    for (long i = 0; i < count; i++)
+    {
+        int infoset = -1;
+        float p = -1;
+        if (!(is >> infoset >> p) || infoset < 0 || infoset >= CFR_INFOSETS ||
+            !(p >= 0 && p <= 1))
+        {
+            return false;
+        }
+        read.order[infoset] = p;
+    }
+    strategy = read;
+    return true;
+}
+
+const CfrStrategy & cfr_strategy()
+{
+    static const CfrStrategy strategy = [] {
+        CfrStrategy loaded;
+        const char *path = getenv("EUCHRE_CFR_TABLE");
+        if (!path)
+        {
+            return loaded;
+        }
+        ifstream file(path);
+        if (!file || !read_cfr_strategy(file, loaded))
+        {
+            cerr << "Error reading CFR table " << path << endl;
+            exit(1);
+        }
+        return loaded;
+    }();
+    return strategy;
+}
+
+uint64_t cfr_fingerprint(const CfrStrategy &strategy)
+{
+    // FNV-1a over the bits of each probability
+    uint64_t hash = 0xcbf29ce484222325ull;
+    for (float p : strategy.order)
+    {
+        hash = (hash ^ std::bit_cast<uint32_t>(p)) * 0x100000001b3ull;
+    }
+    return mix64(hash);
+}
+
+bool cfr_orders_up(const CfrStrategy &strategy, uint32_t hand, int upcard, int position,
+                   int round, Suit &trump)
+{
+    const Suit upcard_suit = Card_from_index(upcard).get_suit();
+    Suit candidate;
+    const float p = strategy.order[cfr_infoset(hand, upcard, position, round, candidate)];
+    if (p < 0)
+    {
+        // never reached in training: bid as Simple
+        if (!simple_orders_up(hand, upcard_suit, position == NUM_PLAYERS - 1, round))
+        {
+            return false;
+        }
+        trump = round == 1 ? upcard_suit : Suit_next(upcard_suit);
+        return true;
+    }
+    const uint64_t context = hand | uint64_t(upcard) << 24 | uint64_t(position) << 29 |
+                             uint64_t(round) << 31;
+    const double draw = (mix64(context) >> 11) * (1.0 / 9007199254740992.0);
+    if (draw >= p && !(round == 2 && position == NUM_PLAYERS - 1))
+    {
+        return false;
+    }
+    trump = candidate;
+    return true;
+}
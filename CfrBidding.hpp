@@ -0,0 +1,75 @@
+#ifndef CFRBIDDING_HPP
+#define CFRBIDDING_HPP
+/* CfrBidding.hpp
+ *
+ * Bidding learned by counterfactual regret minimization.  The two rounds
+ * of make_trump form a small imperfect-information game: eight chances
+ * to order up, in turn, each seeing only its own hand, the upcard and
+ * the passes before it.  Hands are abstracted into information sets by
+ * their HandFeatures for one candidate trump suit (the upcard's suit in
+ * round one; in round two the other suit the hand is longest and
+ * strongest in), so the choice at each is just pass or order up, and the
+ * dealer must name a suit in round two.
+ *
+ * The strategy is the average strategy trained by CfrTrainer.hpp: for each
+ * information set reached in training, the probability of ordering up.
+ * CFR players read it from the file named by EUCHRE_CFR_TABLE, fall back
+ * to Simple's choice for information sets the table lacks, and play their
+ * cards as Simple.
+ *
+ * Hands are bitmasks of Card_to_index bits, as in GameState.  Positions
+ * count bidders from the dealer's left, so the dealer is 3.
+ */
+
+#include <cstdint>
+#include <iostream>
+#include <vector>
+#include "Card.hpp"
+
+// Information sets: round, position, trumps, bowers, other good trumps,
+// off aces, voids, and whether the upcard is a jack (round one) or the
+// candidate is the upcard's color (round two)
+const int CFR_INFOSETS = 2 * 4 * 6 * 4 * 4 * 4 * 4 * 2;
+
+// REQUIRES: hand holds five cards, 0 <= position <= 3, round is 1 or 2
+// MODIFIES: candidate
+// EFFECTS: returns the information set of the bidder at position holding
+//          hand, and sets candidate to the suit it would name.  A dealer
+//          is judged in round one on the hand it keeps after picking up
+//          the upcard and discarding as Simple does.
+int cfr_infoset(uint32_t hand, int upcard, int position, int round, Suit &candidate);
+
+// The average strategy: probability of ordering up by information set,
+// -1 where training never reached
+struct CfrStrategy
+{
+    std::vector<float> order = std::vector<float>(CFR_INFOSETS, -1.0f);
+};
+
+// EFFECTS: Writes strategy as "cfr 1 INFOSETS COUNT", then COUNT lines of
+//          information set and probability for those reached
+void write_cfr_strategy(std::ostream &os, const CfrStrategy &strategy);
+
+// MODIFIES: strategy, is
+// EFFECTS: Reads a strategy written by write_cfr_strategy.  Returns false
+//          and leaves strategy unchanged if the input is malformed.
+bool read_cfr_strategy(std::istream &is, CfrStrategy &strategy);
+
+// EFFECTS: returns the strategy CFR players use: read from the file named
+//          by EUCHRE_CFR_TABLE when it is set, otherwise an empty one.
+//          Exits with a message if the file is unreadable.
+const CfrStrategy & cfr_strategy();
+
+// EFFECTS: returns a hash of every probability in strategy, so files built
+//          from one table can tell it from another
+uint64_t cfr_fingerprint(const CfrStrategy &strategy);
+
+// REQUIRES: hand holds five cards, 0 <= position <= 3, round is 1 or 2
+// MODIFIES: trump
+// EFFECTS: returns true and sets trump if the bidder orders up.  Where
+//          strategy mixes, the choice is a fixed pseudo-random function of
+//          the hand and upcard, so a player always bids a deal the same way.
+bool cfr_orders_up(const CfrStrategy &strategy, uint32_t hand, int upcard, int position,
+                   int round, Suit &trump);
+
+#endif // CFRBIDDING_HPP
@@ -0,0 +1,192 @@
+#include "CfrBidding.hpp"
+#include "HandIndex.hpp"
+#include "Player.hpp"
+#include "Random.hpp"
+#include "SimpleTable.hpp"
+#include "unit_test_framework.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <sstream>
+
+using namespace std;
+
+// EFFECTS: returns a random five-card hand and sets upcard to another card
+static uint32_t random_hand(Random &random, int &upcard) {
+    const uint32_t hand = unrank_hand(random.below(NUM_HANDS));
+    do {
+        upcard = int(random.below(24));
+    } while (hand & (uint32_t(1) << upcard));
+    return hand;
+}
+
+TEST(test_infosets_in_range) {
+    Random random(1);
+    vector<bool> seen(CFR_INFOSETS);
+    for (int i = 0; i < 20000; i++) {
+        int upcard = 0;
+        const uint32_t hand = random_hand(random, upcard);
+        const Suit upcard_suit = Card_from_index(upcard).get_suit();
+        for (int round = 1; round <= 2; round++) {
+            for (int position = 0; position < 4; position++) {
+                Suit candidate = SPADES;
+                const int infoset = cfr_infoset(hand, upcard, position, round, candidate);
+                ASSERT_TRUE(infoset >= 0 && infoset < CFR_INFOSETS);
+                ASSERT_EQUAL(candidate == upcard_suit, round == 1);
+                seen[infoset] = true;
+            }
+        }
+    }
+    // the abstraction is small enough for most of it to turn up
+    ASSERT_TRUE(count(seen.begin(), seen.end(), true) > 2000);
+}
+
+TEST(test_infoset_separates_round_and_position) {
+    // ace, king and queen of spades, ace of hearts, nine of clubs
+    const uint32_t hand = (uint32_t(1) << Card_to_index(Card(ACE, SPADES))) |
+                          (uint32_t(1) << Card_to_index(Card(KING, SPADES))) |
+                          (uint32_t(1) << Card_to_index(Card(QUEEN, SPADES))) |
+                          (uint32_t(1) << Card_to_index(Card(ACE, HEARTS))) |
+                          (uint32_t(1) << Card_to_index(Card(NINE, CLUBS)));
+    const int upcard = Card_to_index(Card(TEN, SPADES));
+    Suit candidate = HEARTS;
+    const int first = cfr_infoset(hand, upcard, 0, 1, candidate);
+    ASSERT_EQUAL(candidate, SPADES);
+    ASSERT_NOT_EQUAL(cfr_infoset(hand, upcard, 1, 1, candidate), first);
+    // positions are 3072 apart; the dealer is judged after picking up the
+    // ten and throwing the nine of clubs, so its features differ too
+    ASSERT_EQUAL(cfr_infoset(hand, upcard, 2, 1, candidate), first + 2 * 3072);
+    ASSERT_NOT_EQUAL(cfr_infoset(hand, upcard, 3, 1, candidate), first + 3 * 3072);
+    ASSERT_NOT_EQUAL(cfr_infoset(hand, upcard, 0, 2, candidate), first);
+    ASSERT_NOT_EQUAL(candidate, SPADES);
+}
+
+TEST(test_strategy_round_trip) {
+    CfrStrategy strategy;
+    strategy.order[0] = 0.25f;
+    strategy.order[17] = 1.0f;
+    strategy.order[CFR_INFOSETS - 1] = 0;
+    stringstream stream;
+    write_cfr_strategy(stream, strategy);
+    CfrStrategy read;
+    ASSERT_TRUE(read_cfr_strategy(stream, read));
+    ASSERT_TRUE(read.order == strategy.order);
+}
+
+TEST(test_fingerprint_tells_tables_apart) {
+    CfrStrategy strategy;
+    CfrStrategy copy = strategy;
+    ASSERT_EQUAL(cfr_fingerprint(strategy), cfr_fingerprint(copy));
+    copy.order[CFR_INFOSETS / 2] = 0.5f;
+    ASSERT_NOT_EQUAL(cfr_fingerprint(strategy), cfr_fingerprint(copy));
+    strategy.order[CFR_INFOSETS / 2] = 0.5000001f;
+    ASSERT_NOT_EQUAL(cfr_fingerprint(strategy), cfr_fingerprint(copy));
+}
+
+TEST(test_read_rejects_malformed) {
+    CfrStrategy strategy;
+    strategy.order[5] = 0.5f;
+    const string size = " " + to_string(CFR_INFOSETS) + " ";
+    for (const string &text : vector<string>{"cfr 2" + size + "0", "cfr 1 100 0",
+                              "cfr 1" + size + "2\n1 0.5\n",
+                              "cfr 1" + size + "1\n1 1.5\n",
+                              "cfr 1" + size + "1\n" + size + "0.5\n", "learned 1"}) {
+        istringstream stream(text);
+        ASSERT_FALSE(read_cfr_strategy(stream, strategy));
+        ASSERT_EQUAL(strategy.order[5], 0.5f);
+    }
+}
+
+TEST(test_empty_strategy_bids_as_simple) {
+    const CfrStrategy empty;
+    Random random(2);
+    for (int i = 0; i < 5000; i++) {
+        int upcard = 0;
+        const uint32_t hand = random_hand(random, upcard);
+        const Suit upcard_suit = Card_from_index(upcard).get_suit();
+        for (int round = 1; round <= 2; round++) {
+            for (int position = 0; position < 4; position++) {
+                Suit trump = SPADES;
+                const bool ordered = cfr_orders_up(empty, hand, upcard, position, round,
+                                                   trump);
+                ASSERT_EQUAL(ordered,
+                             simple_orders_up(hand, upcard_suit, position == 3, round));
+                if (ordered) {
+                    ASSERT_EQUAL(trump,
+                                 round == 1 ? upcard_suit : Suit_next(upcard_suit));
+                }
+            }
+        }
+    }
+}
+
+TEST(test_pure_strategies) {
+    Random random(3);
+    for (int i = 0; i < 1000; i++) {
+        int upcard = 0;
+        const uint32_t hand = random_hand(random, upcard);
+        for (float p : {0.0f, 1.0f}) {
+            CfrStrategy strategy;
+            strategy.order.assign(CFR_INFOSETS, p);
+            for (int round = 1; round <= 2; round++) {
+                for (int position = 0; position < 4; position++) {
+                    Suit candidate = SPADES;
+                    cfr_infoset(hand, upcard, position, round, candidate);
+                    Suit trump = Suit(3 - candidate);
+                    const bool forced = round == 2 && position == 3;
+                    ASSERT_EQUAL(cfr_orders_up(strategy, hand, upcard, position, round,
+                                               trump), p == 1 || forced);
+                    ASSERT_EQUAL(trump,
+                                 p == 1 || forced ? candidate : Suit(3 - candidate));
+                }
+            }
+        }
+    }
+}
+
+TEST(test_mixed_strategy_is_fixed_per_hand) {
+    CfrStrategy strategy;
+    strategy.order.assign(CFR_INFOSETS, 0.3f);
+    Random random(4);
+    int ordered = 0;
+    const int hands = 10000;
+    for (int i = 0; i < hands; i++) {
+        int upcard = 0;
+        const uint32_t hand = random_hand(random, upcard);
+        Suit trump = SPADES;
+        const bool once = cfr_orders_up(strategy, hand, upcard, 0, 1, trump);
+        ASSERT_EQUAL(cfr_orders_up(strategy, hand, upcard, 0, 1, trump), once);
+        ordered += once;
+    }
+    ASSERT_TRUE(ordered > hands / 4 && ordered < hands * 35 / 100);
+}
+
+TEST(test_factory_makes_cfr_player) {
+    // without EUCHRE_CFR_TABLE the CFR player bids and plays as Simple
+    unique_ptr<Player> cfr(Player_factory("Carl", "CFR"));
+    unique_ptr<Player> simple(Player_factory("Simon", "Simple"));
+    ASSERT_EQUAL(cfr->get_name(), "Carl");
+    ASSERT_TRUE(Player_strategy_exists("CFR"));
+    Random random(5);
+    int upcard = 0;
+    const uint32_t hand = random_hand(random, upcard);
+    for (uint32_t cards = hand; cards; cards &= cards - 1) {
+        cfr->add_card(Card_from_index(__builtin_ctz(cards)));
+        simple->add_card(Card_from_index(__builtin_ctz(cards)));
+    }
+    const Card up = Card_from_index(upcard);
+    for (int round = 1; round <= 2; round++) {
+        for (bool dealer : {false, true}) {
+            Suit cfr_suit = SPADES;
+            Suit simple_suit = SPADES;
+            ASSERT_EQUAL(cfr->make_trump(up, dealer, round, cfr_suit),
+                         simple->make_trump(up, dealer, round, simple_suit));
+            ASSERT_EQUAL(cfr_suit, simple_suit);
+        }
+    }
+    for (int trick = 0; trick < 5; trick++) {
+        ASSERT_EQUAL(cfr->lead_card(up.get_suit()), simple->lead_card(up.get_suit()));
+    }
+}
+
+TEST_MAIN()
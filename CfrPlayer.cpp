@@ -0,0 +1,42 @@
+#include "CardTracker.hpp"
+#include "CfrBidding.hpp"
+#include "SimpleTablePlayer.hpp"
+
+// Bids with the CFR strategy table and plays its cards as Simple does,
+// keeping track of the passes through observe() to know its position
+class CfrPlayer : public SimpleTablePlayer
+{
+public:
+    CfrPlayer(std::string name_in)
+        : SimpleTablePlayer(name_in), strategy(cfr_strategy()) {}
+
+    // REQUIRES round is 1 or 2
+    // MODIFIES order_up_suit
+    // EFFECTS If Player wishes to order up a trump suit then return true and
+    //   change order_up_suit to desired suit.  If Player wishes to pass, then do
+    //   not modify order_up_suit and return false.
+    bool make_trump(const Card &upcard, bool is_dealer,
+                    int round, Suit &order_up_suit) const override
+    {
+        return cfr_orders_up(strategy, hand, Card_to_index(upcard),
+                             tracker.bid_position(upcard, is_dealer), round,
+                             order_up_suit);
+    }
+
+    void observe(const PlayerEvent &event) override
+    {
+        tracker.observe(event);
+    }
+
+private:
+    const CfrStrategy &strategy;
+    CardTracker tracker;
+};
+
+// EFFECTS: returns a new CfrPlayer called name
+static Player * make_cfr_player(const std::string &name)
+{
+    return new CfrPlayer(name);
+}
+
+static const bool registered = Player_register("CFR", make_cfr_player, false);
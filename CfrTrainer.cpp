@@ -0,0 +1,252 @@
+#include "CfrTrainer.hpp"
+#include "SimpleTable.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+
+using namespace std;
+
+namespace
+{
+    const int NUM_PLAYERS = 4;
+    const int NUM_SUITS = 4;
+    const int TRICKS = 5;
+    // two chances to bid for each player
+    const int NODES = 2 * NUM_PLAYERS;
+    // deals per task
+    const int CHUNK_DEALS = 64;
+
+    uint32_t bit(int card)
+    {
+        return uint32_t(1) << card;
+    }
+
+    // EFFECTS: returns the points team 0 wins when makers take tricks
+    //          between players 0 and 2
+    int points(int makers, int team0_tricks)
+    {
+        const int tricks = makers == 0 ? team0_tricks : TRICKS - team0_tricks;
+        const int won = tricks == TRICKS ? 2 : tricks >= 3 ? 1 : -2;
+        return makers == 0 ? won : -won;
+    }
+}
+
+CfrTable::CfrTable()
+    : regrets(2 * CFR_INFOSETS), strategy_sums(2 * CFR_INFOSETS)
+{
+    for (size_t i = 0; i < regrets.size(); i++)
+    {
+        regrets[i].store(0, memory_order_relaxed);
+        strategy_sums[i].store(0, memory_order_relaxed);
+    }
+}
+
+float CfrTable::current(int infoset) const
+{
+    // regret matching
+    const double order = std::max(regrets[2 * infoset].load(memory_order_relaxed), 0.0);
+    const double pass = std::max(regrets[2 * infoset + 1].load(memory_order_relaxed),
+                                 0.0);
+    return order + pass > 0 ? float(order / (order + pass)) : 0.5f;
+}
+
+float CfrTable::average(int infoset) const
+{
+    const double order = strategy_sums[2 * infoset].load(memory_order_relaxed);
+    const double pass = strategy_sums[2 * infoset + 1].load(memory_order_relaxed);
+    return order + pass > 0 ? float(order / (order + pass)) : -1.0f;
+}
+
+void CfrTable::update(int infoset, float order_regret, float pass_regret, float reach,
+                      float order)
+{
+    // lock-free: concurrent updates to one information set all land, in
+    // some order, and readers see regrets a few updates stale at worst
+    regrets[2 * infoset].fetch_add(order_regret, memory_order_relaxed);
+    regrets[2 * infoset + 1].fetch_add(pass_regret, memory_order_relaxed);
+    strategy_sums[2 * infoset].fetch_add(double(reach) * order, memory_order_relaxed);
+    strategy_sums[2 * infoset + 1].fetch_add(double(reach) * (1 - order),
+                                             memory_order_relaxed);
+}
+
+int CfrTable::visited() const
+{
+    int count = 0;
+    for (int infoset = 0; infoset < CFR_INFOSETS; infoset++)
+    {
+        count += average(infoset) >= 0;
+    }
+    return count;
+}
+
+void cfr_train_deal(const DealRecord &deal, CfrTable &table)
+{
+    const Suit upcard_suit = Card_from_index(deal.upcard).get_suit();
+    const int dealer = 0;
+    const int leader = 1;
+
+    // tricks players 0 and 2 take with each suit trump, found once per suit
+    std::array<int, NUM_SUITS> suit_tricks;
+    suit_tricks.fill(-1);
+    const auto round_two_tricks = [&](Suit trump) {
+        if (suit_tricks[trump] < 0)
+        {
+            suit_tricks[trump] = simple_tricks(deal.hands, trump, leader);
+        }
+        return suit_tricks[trump];
+    };
+    std::array<uint32_t, NUM_PLAYERS> picked_up = deal.hands;
+    const int discard = simple_discard(deal.hands[dealer], deal.upcard, upcard_suit);
+    picked_up[dealer] = (picked_up[dealer] | bit(deal.upcard)) & ~bit(discard);
+    const int round_one_tricks = simple_tricks(picked_up, upcard_suit, leader);
+
+    // node k is the bidder at position k % 4 in round k / 4 + 1
+    std::array<int, NODES> infoset;
+    std::array<float, NODES> order;         // probability of ordering up
+    std::array<float, NODES + 1> value;     // to team 0, from node k on
+    std::array<float, NODES> ordered;       // to team 0, if node k orders
+    for (int k = 0; k < NODES; k++)
+    {
+        const int position = k % NUM_PLAYERS;
+        const int seat = (dealer + 1 + position) % NUM_PLAYERS;
+        const int round = k / NUM_PLAYERS + 1;
+        Suit candidate;
+        infoset[k] = cfr_infoset(deal.hands[seat], deal.upcard, position, round,
+                                 candidate);
+        // the dealer must name a suit in round two
+        order[k] = k == NODES - 1 ? 1.0f : table.current(infoset[k]);
+        const int tricks = round == 1 ? round_one_tricks : round_two_tricks(candidate);
+        ordered[k] = float(points(seat % 2, tricks));
+    }
+    value[NODES] = 0;
+    for (int k = NODES - 1; k >= 0; k--)
+    {
+        value[k] = order[k] * ordered[k] + (1 - order[k]) * value[k + 1];
+    }
+
+    for (int k = 0; k < NODES; k++)
+    {
+        const int position = k % NUM_PLAYERS;
+        const float own_pass = k >= NUM_PLAYERS ? 1 - order[k - NUM_PLAYERS] : 1.0f;
+        // the chance the others all pass to this node
+        float others = 1;
+        for (int j = 0; j < k; j++)
+        {
+            others *= j % NUM_PLAYERS == position ? 1.0f : 1 - order[j];
+        }
+        const float sign = position % 2 == 0 ? -1.0f : 1.0f;     // seats 1, 3 are team 1
+        if (k == NODES - 1)
+        {
+            table.update(infoset[k], 0, 0, own_pass, 1.0f);
+        }
+        else
+        {
+            table.update(infoset[k], others * sign * (ordered[k] - value[k]),
+                         others * sign * (value[k + 1] - value[k]), own_pass, order[k]);
+        }
+    }
+}
+
+void cfr_train(const CfrOptions &options, long first, long count, ThreadPool &pool,
+               CfrTable &table)
+{
+    const int num_chunks = int((count + CHUNK_DEALS - 1) / CHUNK_DEALS);
+    pool.parallel_for(num_chunks, [&](int, int c) {
+        const long start = first + long(c) * CHUNK_DEALS;
+        const int n = int(std::min<long>(CHUNK_DEALS, first + count - start));
+        std::array<DealRecord, CHUNK_DEALS> deals;
+        generate_deals(options.seed, start, n, deals.data());
+        for (int i = 0; i < n; i++)
+        {
+            cfr_train_deal(deals[i], table);
+        }
+    });
+}
+
+CfrStrategy cfr_average(const CfrTable &table)
+{
+    CfrStrategy strategy;
+    for (int infoset = 0; infoset < CFR_INFOSETS; infoset++)
+    {
+        strategy.order[infoset] = table.average(infoset);
+    }
+    return strategy;
+}
+
+static void print_cfr_usage()
+{
+    cout << "Usage: euchre.exe --cfr FILE DEALS THREADS [--seed N]" << endl;
+}
+
+// EFFECTS: Writes strategy to path, replacing the file only once it is
+//          complete, so a reader never sees half a table.  Returns false
+//          on error.
+static bool save_cfr_strategy(const std::string &path, const CfrStrategy &strategy)
+{
+    const string tmp_path = path + ".tmp";
+    {
+        ofstream file(tmp_path, ios::trunc);
+        write_cfr_strategy(file, strategy);
+        if (!file.flush())
+        {
+            return false;
+        }
+    }
+    return rename(tmp_path.c_str(), path.c_str()) == 0;
+}
+
+int cfr_main(int argc, char **argv)
+{
+    if (argc < 5)
+    {
+        print_cfr_usage();
+        return 1;
+    }
+    const string path = argv[2];
+    CfrOptions options;
+    options.deals = atol(argv[3]);
+    const int threads = atoi(argv[4]);
+    for (int i = 5; i < argc; i++)
+    {
+        const string option = argv[i];
+        if (option == "--seed" && i + 1 < argc)
+        {
+            options.seed = strtoull(argv[++i], nullptr, 10);
+        }
+        else
+        {
+            print_cfr_usage();
+            return 1;
+        }
+    }
+    if (options.deals < 1 || threads < 0)
+    {
+        print_cfr_usage();
+        return 2;
+    }
+
+    ThreadPool pool(threads == 0 ? default_thread_count() : threads);
+    CfrTable table;
+    const int passes = 10;
+    const auto start = chrono::steady_clock::now();
+    long done = 0;
+    for (int pass = 1; pass <= passes; pass++)
+    {
+        const long next = options.deals * pass / passes;
+        cfr_train(options, done, next - done, pool, table);
+        done = next;
+        const chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+        if (!save_cfr_strategy(path, cfr_average(table)))
+        {
+            cout << "Error writing " << path << endl;
+            return 4;
+        }
+        cout << "Trained " << done << " deals, " << table.visited() << " of "
+             << CFR_INFOSETS << " information sets reached, " << fixed
+             << setprecision(0) << done / elapsed.count() << " deals/s" << endl;
+    }
+    return 0;
+}
@@ -0,0 +1,84 @@
+#ifndef CFRTRAINER_HPP
+#define CFRTRAINER_HPP
+/* CfrTrainer.hpp
+ *
+ * Trains the CFR bidding strategy of CfrBidding.hpp by chance-sampled
+ * MCCFR.  Each iteration deals a hand, values every way the bidding can
+ * end by playing the hand out with the Simple tables (one playout for the
+ * upcard's suit and one for each suit named in round two), and updates
+ * the regrets and strategy sums of the eight information sets met.
+ *
+ * Worker threads share one CfrTable and update it without locks: each
+ * entry is an atomic double updated with relaxed fetch_add, so no update
+ * is lost, but a worker may compute its strategy from regrets a few
+ * updates stale.  A run's result therefore depends slightly on the
+ * thread schedule.  The sums grow with the number of deals, and a double
+ * still adds a single deal's weight to them after billions of deals,
+ * where a float stops changing once a sum passes 2^24.
+ */
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+#include "CfrBidding.hpp"
+#include "DealPipeline.hpp"
+#include "ThreadPool.hpp"
+
+// Regrets and strategy sums for every information set, shared by threads
+class CfrTable
+{
+public:
+    // EFFECTS: Creates a table with no regrets, so every information set
+    //          orders up half the time
+    CfrTable();
+
+    // EFFECTS: returns the probability of ordering up at infoset under
+    //          regret matching
+    float current(int infoset) const;
+
+    // EFFECTS: returns the probability of ordering up at infoset averaged
+    //          over training, or -1 if infoset was never reached
+    float average(int infoset) const;
+
+    // MODIFIES: this
+    // EFFECTS: Adds regrets for ordering up and passing at infoset, and adds
+    //          reach times order, the probability of ordering up played, to
+    //          the strategy sums.  Safe to call from several threads at once.
+    void update(int infoset, float order_regret, float pass_regret, float reach,
+                float order);
+
+    // EFFECTS: returns the number of information sets reached so far
+    int visited() const;
+
+private:
+    // [infoset][order, pass]
+    std::vector<std::atomic<double>> regrets;
+    std::vector<std::atomic<double>> strategy_sums;
+};
+
+// MODIFIES: table
+// EFFECTS: Runs one CFR iteration over the bidding of deal, player 0
+//          dealing
+void cfr_train_deal(const DealRecord &deal, CfrTable &table);
+
+struct CfrOptions
+{
+    long deals = 10000000;
+    uint64_t seed = 0;
+};
+
+// MODIFIES: table
+// EFFECTS: Trains table on deals first .. first + count - 1 of
+//          options.seed, spread over pool's workers
+void cfr_train(const CfrOptions &options, long first, long count, ThreadPool &pool,
+               CfrTable &table);
+
+// EFFECTS: returns table's average strategy
+CfrStrategy cfr_average(const CfrTable &table);
+
+// EFFECTS: Trains from command line arguments FILE DEALS THREADS
+//          [--seed N], writing the average strategy to FILE after each
+//          tenth of the deals.  Returns the process exit status.
+int cfr_main(int argc, char **argv);
+
+#endif // CFRTRAINER_HPP
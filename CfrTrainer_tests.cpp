@@ -0,0 +1,127 @@
+#include "CfrTrainer.hpp"
+#include "unit_test_framework.hpp"
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+using namespace std;
+
+static uint32_t hand_of(const vector<Card> &cards) {
+    uint32_t hand = 0;
+    for (const Card &card : cards) {
+        hand |= uint32_t(1) << Card_to_index(card);
+    }
+    return hand;
+}
+
+TEST(test_regret_matching) {
+    CfrTable table;
+    ASSERT_EQUAL(table.current(7), 0.5f);
+    ASSERT_EQUAL(table.average(7), -1.0f);
+    ASSERT_EQUAL(table.visited(), 0);
+
+    table.update(7, 3, 1, 1, 0.5f);
+    ASSERT_EQUAL(table.current(7), 0.75f);
+    table.update(7, -4, 1, 1, 0.0f);
+    ASSERT_EQUAL(table.current(7), 0.0f);
+    table.update(7, 0, -10, 2, 1.0f);
+    // no positive regret left
+    ASSERT_EQUAL(table.current(7), 0.5f);
+    // strategy sums weight 0.5, 0 and 1 by reach 1, 1 and 2
+    ASSERT_EQUAL(table.average(7), 0.625f);
+    ASSERT_EQUAL(table.visited(), 1);
+}
+
+TEST(test_small_updates_still_count_after_many_deals) {
+    // regrets as large as a long run builds, where a float no longer
+    // changes by 1
+    CfrTable table;
+    table.update(3, 3e7f, 3e7f, 1, 0.5f);
+    ASSERT_EQUAL(table.current(3), 0.5f);
+    for (int i = 0; i < 1000; i++) {
+        table.update(3, 1, 0, 1, 0.5f);
+    }
+    ASSERT_TRUE(table.current(3) > 0.500008f);
+}
+
+TEST(test_concurrent_updates_all_land) {
+    CfrTable table;
+    ThreadPool pool(4);
+    pool.parallel_for(40000, [&table](int, int i) {
+        table.update(i % 2, 1, 0, 1, 1.0f);
+    });
+    // with pass regret zero, any ordering up regret makes the current
+    // strategy pure; the sums show every update arrived
+    ASSERT_EQUAL(table.current(0), 1.0f);
+    table.update(0, 0, 19999, 0, 0);
+    ASSERT_EQUAL(table.current(0), 20000.0f / 39999);
+    ASSERT_EQUAL(table.average(1), 1.0f);
+}
+
+TEST(test_training_learns_the_obvious) {
+    CfrTable table;
+    CfrOptions options;
+    options.seed = 11;
+    ThreadPool pool(2);
+    cfr_train(options, 0, 40000, pool, table);
+    ASSERT_TRUE(table.visited() > 1000);
+    const CfrStrategy strategy = cfr_average(table);
+
+    // both bowers and the ace: order it up from the first seat
+    const int upcard = Card_to_index(Card(NINE, HEARTS));
+    const uint32_t strong = hand_of({Card(JACK, HEARTS), Card(JACK, DIAMONDS),
+                                     Card(ACE, HEARTS), Card(ACE, SPADES),
+                                     Card(KING, SPADES)});
+    Suit candidate = SPADES;
+    const int strong_infoset = cfr_infoset(strong, upcard, 0, 1, candidate);
+    ASSERT_TRUE(strategy.order[strong_infoset] > 0.9f);
+
+    // no hearts and no aces: pass
+    const uint32_t weak = hand_of({Card(NINE, SPADES), Card(TEN, SPADES),
+                                   Card(NINE, CLUBS), Card(TEN, CLUBS),
+                                   Card(QUEEN, DIAMONDS)});
+    const int weak_infoset = cfr_infoset(weak, upcard, 0, 1, candidate);
+    ASSERT_TRUE(strategy.order[weak_infoset] >= 0 && strategy.order[weak_infoset] < 0.1f);
+
+    stringstream stream;
+    write_cfr_strategy(stream, strategy);
+    CfrStrategy read;
+    ASSERT_TRUE(read_cfr_strategy(stream, read));
+    for (int infoset = 0; infoset < CFR_INFOSETS; infoset++) {
+        ASSERT_ALMOST_EQUAL(read.order[infoset], strategy.order[infoset], 1e-5);
+    }
+}
+
+TEST(test_dealer_always_names_in_round_two) {
+    CfrTable table;
+    CfrOptions options;
+    ThreadPool pool(1);
+    cfr_train(options, 0, 2000, pool, table);
+    const CfrStrategy strategy = cfr_average(table);
+    for (int infoset = 0; infoset < CFR_INFOSETS; infoset++) {
+        const int position = infoset / 3072 % 4;
+        const bool round_two = infoset >= CFR_INFOSETS / 2;
+        if (round_two && position == 3 && strategy.order[infoset] >= 0) {
+            ASSERT_EQUAL(strategy.order[infoset], 1.0f);
+        }
+    }
+}
+
+TEST(test_main_writes_a_complete_table) {
+    const string path = "CfrTrainer_tests_table.txt";
+    string args[] = {"euchre.exe", "--cfr", path, "400", "1", "--seed", "3"};
+    char *argv[7];
+    for (int i = 0; i < 7; i++) {
+        argv[i] = args[i].data();
+    }
+    ASSERT_EQUAL(cfr_main(7, argv), 0);
+    ifstream file(path);
+    CfrStrategy strategy;
+    ASSERT_TRUE(read_cfr_strategy(file, strategy));
+    // the table is written beside the file and renamed into place
+    ASSERT_FALSE(ifstream(path + ".tmp").good());
+    remove(path.c_str());
+}
+
+TEST_MAIN()
@@ -0,0 +1,109 @@
+#include "Checkpoint.hpp"
+#include <cstdio>
+#include <fstream>
+#include <algorithm>
+
+using namespace std;
+
+// File layout, all integers little endian:
+//   magic "EUCK", u32 version,
+//   i32 points_to_win, u8 shuffle, u8 random_shuffle, u64 seed,
+//   i32 hand_number, i32 dealer, i32 points[2],
+//   i32 pack_next, 24 x u8 card id
+static const char CHECKPOINT_MAGIC[4] = {'E', 'U', 'C', 'K'};
+static const uint32_t CHECKPOINT_VERSION = 3;
+static const size_t CHECKPOINT_SIZE = 4 + 4 + 4 + 1 + 1 + 8 + 4 * 5 + Checkpoint::PACK_SIZE;
+
+static void put_u32(string &out, uint32_t value)
+{
+    for (int i = 0; i < 4; i++)
+    {
+        out.push_back(char((value >> (8 * i)) & 0xff));
+    }
+}
+
+static uint32_t get_u32(const unsigned char *in)
+{
+    uint32_t value = 0;
+    for (int i = 0; i < 4; i++)
+    {
+        value |= uint32_t(in[i]) << (8 * i);
+    }
+    return value;
+}
+
+bool write_checkpoint(const std::string &path, const Checkpoint &checkpoint)
+{
+    string out(CHECKPOINT_MAGIC, sizeof(CHECKPOINT_MAGIC));
+    put_u32(out, CHECKPOINT_VERSION);
+    put_u32(out, checkpoint.points_to_win);
+    out.push_back(char(checkpoint.shuffle));
+    out.push_back(char(checkpoint.random_shuffle));
+    put_u32(out, uint32_t(checkpoint.seed));
+    put_u32(out, uint32_t(checkpoint.seed >> 32));
+    put_u32(out, checkpoint.hand_number);
+    put_u32(out, checkpoint.dealer);
+    put_u32(out, checkpoint.points[0]);
+    put_u32(out, checkpoint.points[1]);
+    put_u32(out, checkpoint.pack_next);
+    for (const Card &card : checkpoint.pack_cards)
+    {
+        out.push_back(char(card.get_id()));
+    }
+
+    // write the whole file under a temporary name, then atomically replace
+    const string tmp_path = path + ".tmp";
+    {
+        ofstream file(tmp_path, ios::binary | ios::trunc);
+        if (!file.write(out.data(), out.size()) || !file.flush())
+        {
+            return false;
+        }
+    }
+    return rename(tmp_path.c_str(), path.c_str()) == 0;
+}
+
+bool read_checkpoint(const std::string &path, Checkpoint &checkpoint)
+{
+    ifstream file(path, ios::binary);
+    unsigned char in[CHECKPOINT_SIZE];
+    if (!file.read(reinterpret_cast<char *>(in), CHECKPOINT_SIZE))
+    {
+        return false;
+    }
+    if (!equal(CHECKPOINT_MAGIC, CHECKPOINT_MAGIC + 4, in) ||
+        get_u32(in + 4) != CHECKPOINT_VERSION)
+    {
+        return false;
+    }
+
+    Checkpoint result;
+    const unsigned char *p = in + 8;
+    result.points_to_win = int32_t(get_u32(p));
+    result.shuffle = p[4] != 0;
+    result.random_shuffle = p[5] != 0;
+    result.seed = get_u32(p + 6) | (uint64_t(get_u32(p + 10)) << 32);
+    p += 14;
+    result.hand_number = int32_t(get_u32(p));
+    result.dealer = int32_t(get_u32(p + 4));
+    result.points[0] = int32_t(get_u32(p + 8));
+    result.points[1] = int32_t(get_u32(p + 12));
+    result.pack_next = int32_t(get_u32(p + 16));
+    p += 20;
+    for (int i = 0; i < Checkpoint::PACK_SIZE; i++, p++)
+    {
+        if (p[0] >= Card::NUM_IDS)
+        {
+            return false;
+        }
+        result.pack_cards[i] = Card::from_id(p[0]);
+    }
+    if (result.dealer < 0 || result.dealer > 3 ||
+        result.pack_next < 0 || result.pack_next > Checkpoint::PACK_SIZE)
+    {
+        return false;
+    }
+
+    checkpoint = result;
+    return true;
+}
@@ -0,0 +1,46 @@
+#ifndef CHECKPOINT_HPP
+#define CHECKPOINT_HPP
+/* Checkpoint.hpp
+ *
+ * Saved state of a game between hands, so that a long run can be resumed
+ * after it is interrupted.
+ */
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include "Card.hpp"
+
+struct Checkpoint
+{
+    static const int PACK_SIZE = 24;
+
+    // settings the game was started with, checked on resume
+    int32_t points_to_win = 0;
+    bool shuffle = false;
+    bool random_shuffle = false;
+    uint64_t seed = 0;
+
+    // game state
+    int32_t hand_number = 0;
+    int32_t dealer = 0;
+    std::array<int32_t, 2> points = {0, 0};
+
+    // pack state
+    int32_t pack_next = 0;
+    std::array<Card, PACK_SIZE> pack_cards;
+};
+
+// EFFECTS: Writes checkpoint to path.  The file is first written to a
+//          temporary file next to path and then renamed over path, so a
+//          reader never sees a partially written checkpoint.  Returns false
+//          if the file could not be written.
+bool write_checkpoint(const std::string &path, const Checkpoint &checkpoint);
+
+// MODIFIES: checkpoint
+// EFFECTS: Reads a checkpoint written by write_checkpoint.  Returns false
+//          and leaves checkpoint unchanged if the file is missing or is not
+//          a valid checkpoint.
+bool read_checkpoint(const std::string &path, Checkpoint &checkpoint);
+
+#endif // CHECKPOINT_HPP
@@ -0,0 +1,411 @@
+#include "Daemon.hpp"
+#include "Game.hpp"
+#include "ThreadPool.hpp"
+#include <cctype>
+#include <cerrno>
+#include <condition_variable>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <streambuf>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+using namespace std;
+
+bool parse_job(const std::string &line, Job &job, std::string &error)
+{
+    istringstream fields(line);
+    std::string shuffle_field;
+    std::string points_field;
+    if (!(fields >> job.id))
+    {
+        error = "empty job";
+        return false;
+    }
+    if (!(fields >> job.pack_source >> shuffle_field >> points_field))
+    {
+        error = "missing fields";
+        return false;
+    }
+
+    job.shuffle = false;
+    job.random_shuffle = false;
+    if (shuffle_field == "shuffle")
+    {
+        job.shuffle = true;
+    }
+    else if (shuffle_field.compare(0, 7, "random:") == 0 && shuffle_field.size() > 7)
+    {
+        char *end;
+        job.seed = strtoull(shuffle_field.c_str() + 7, &end, 10);
+        job.random_shuffle = *end == '\0';
+    }
+    if (!job.shuffle && !job.random_shuffle && shuffle_field != "noshuffle")
+    {
+        error = "bad shuffle " + shuffle_field;
+        return false;
+    }
+
+    job.points_to_win = atoi(points_field.c_str());
+    if (job.points_to_win < 1 || job.points_to_win > 100)
+    {
+        error = "bad points_to_win " + points_field;
+        return false;
+    }
+
+    for (int i = 0; i < 4; i++)
+    {
+        if (!(fields >> job.names[i] >> job.strategies[i]))
+        {
+            error = "missing players";
+            return false;
+        }
+        if (!Player_strategy_exists(job.strategies[i]) ||
+            Player_strategy_is_interactive(job.strategies[i]))
+        {
+            error = "bad strategy " + job.strategies[i];
+            return false;
+        }
+    }
+
+    std::string format = "summary";
+    fields >> format;
+    if (format != "summary" && format != "full")
+    {
+        error = "bad format " + format;
+        return false;
+    }
+    job.full_output = format == "full";
+    std::string extra;
+    if (fields >> extra)
+    {
+        error = "unexpected " + extra;
+        return false;
+    }
+    return true;
+}
+
+// Packs read from files, loaded once and shared by all workers
+class Daemon::PackCache
+{
+public:
+    // MODIFIES: pack
+    // EFFECTS: Sets pack to the pack named by source.  Returns false if
+    //          the file cannot be opened.
+    bool get(const std::string &source, Pack &pack)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto found = packs.find(source);
+        if (found == packs.end())
+        {
+            if (source == "default")
+            {
+                found = packs.emplace(source, Pack()).first;
+            }
+            else
+            {
+                ifstream file(source);
+                if (!file.is_open())
+                {
+                    return false;
+                }
+                found = packs.emplace(source, Pack(file)).first;
+            }
+        }
+        pack = found->second;
+        return true;
+    }
+
+private:
+    std::mutex mutex;
+    std::map<std::string, Pack> packs;
+};
+
+// State kept by each worker between jobs
+struct Daemon::Worker
+{
+    std::unique_ptr<Game> game;
+    std::stringbuf transcript;
+    std::ostream out;
+
+    Worker() : out(nullptr) {}
+};
+
+Daemon::Daemon(int num_threads) : pool(num_threads), packs(new PackCache)
+{
+    for (int i = 0; i < pool.size(); i++)
+    {
+        workers.emplace_back(new Worker);
+    }
+}
+
+Daemon::~Daemon()
+{
+    pool.wait();
+}
+
+std::string Daemon::play_job(const Job &job, Worker &worker)
+{
+    Pack pack;
+    if (!packs->get(job.pack_source, pack))
+    {
+        return job.id + " error cannot open " + job.pack_source + "\n";
+    }
+
+    // full output is collected in the transcript, otherwise discarded
+    if (job.full_output)
+    {
+        worker.transcript.str("");
+        worker.out.rdbuf(&worker.transcript);
+        worker.out.clear();
+    }
+    else
+    {
+        worker.out.rdbuf(nullptr);
+    }
+
+    if (!worker.game)
+    {
+        istringstream no_pack;
+        worker.game.reset(new Game(no_pack, job.shuffle, job.points_to_win,
+                                   job.names, job.strategies, worker.out));
+    }
+    Game &game = *worker.game;
+    game.reset(pack, job.shuffle, job.points_to_win, job.names, job.strategies);
+    if (job.random_shuffle)
+    {
+        game.use_random_shuffle(job.seed);
+    }
+    Team_Number winner = game.play();
+
+    ostringstream result;
+    result << job.id << " ok " << winner << " " << game.get_points(TEAM_ZERO_AND_TWO)
+           << " " << game.get_points(TEAM_ONE_AND_THREE) << " " << game.get_hands_played();
+    if (job.full_output)
+    {
+        const std::string text = worker.transcript.str();
+        long lines = 0;
+        for (char c : text)
+        {
+            lines += c == '\n';
+        }
+        result << " " << lines << "\n" << text;
+    }
+    else
+    {
+        result << "\n";
+    }
+    return result.str();
+}
+
+long Daemon::serve(std::istream &input, std::ostream &output)
+{
+    std::mutex output_mutex;
+
+    // bound the number of queued jobs so a fast producer cannot run us
+    // out of memory
+    const int max_in_flight = 4 * pool.size();
+    int in_flight = 0;
+    std::mutex flight_mutex;
+    std::condition_variable slot_free;
+
+    long count = 0;
+    std::string line;
+    while (std::getline(input, line))
+    {
+        if (line.find_first_not_of(" \t\r") == std::string::npos)
+        {
+            continue;
+        }
+        count++;
+        Job job;
+        std::string error;
+        if (!parse_job(line, job, error))
+        {
+            std::lock_guard<std::mutex> lock(output_mutex);
+            output << (job.id.empty() ? "-" : job.id) << " error " << error << std::endl;
+            continue;
+        }
+
+        {
+            std::unique_lock<std::mutex> lock(flight_mutex);
+            slot_free.wait(lock, [&] { return in_flight < max_in_flight; });
+            in_flight++;
+        }
+        pool.submit([this, job, &output, &output_mutex,
+                     &flight_mutex, &in_flight, &slot_free](int worker) {
+            const std::string result = play_job(job, *workers[worker]);
+            {
+                std::lock_guard<std::mutex> lock(output_mutex);
+                output << result << std::flush;
+            }
+            {
+                std::lock_guard<std::mutex> lock(flight_mutex);
+                in_flight--;
+            }
+            slot_free.notify_one();
+        });
+    }
+    pool.wait();
+    return count;
+}
+
+// Stream buffer over a connected socket.  Not safe to read and write from
+// different threads; use one buffer for each direction.
+class SocketBuf : public std::streambuf
+{
+public:
+    explicit SocketBuf(int fd) : fd(fd)
+    {
+        setg(in_buffer, in_buffer, in_buffer);
+        setp(out_buffer, out_buffer + sizeof(out_buffer));
+    }
+
+    ~SocketBuf()
+    {
+        sync();
+    }
+
+protected:
+    int_type underflow() override
+    {
+        ssize_t n = read(fd, in_buffer, sizeof(in_buffer));
+        if (n <= 0)
+        {
+            return traits_type::eof();
+        }
+        setg(in_buffer, in_buffer, in_buffer + n);
+        return traits_type::to_int_type(in_buffer[0]);
+    }
+
+    int_type overflow(int_type c) override
+    {
+        if (sync() != 0)
+        {
+            return traits_type::eof();
+        }
+        if (!traits_type::eq_int_type(c, traits_type::eof()))
+        {
+            *pptr() = traits_type::to_char_type(c);
+            pbump(1);
+        }
+        return traits_type::not_eof(c);
+    }
+
+    int sync() override
+    {
+        for (char *p = pbase(); p < pptr();)
+        {
+            // a client that hung up gives EPIPE rather than SIGPIPE, which
+            // would end the daemon
+            ssize_t n = send(fd, p, pptr() - p, MSG_NOSIGNAL);
+            if (n < 0 && errno == EINTR)
+            {
+                continue;
+            }
+            if (n <= 0)
+            {
+                return -1;
+            }
+            p += n;
+        }
+        setp(out_buffer, out_buffer + sizeof(out_buffer));
+        return 0;
+    }
+
+private:
+    int fd;
+    char in_buffer[4096];
+    char out_buffer[4096];
+};
+
+int Daemon::serve_socket(const std::string &path)
+{
+    sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(address.sun_path))
+    {
+        std::cerr << "Socket path too long: " << path << std::endl;
+        return 1;
+    }
+    strcpy(address.sun_path, path.c_str());
+
+    int listener = socket(AF_UNIX, SOCK_STREAM, 0);
+    unlink(path.c_str());
+    if (listener < 0 ||
+        bind(listener, reinterpret_cast<sockaddr *>(&address), sizeof(address)) != 0 ||
+        listen(listener, 16) != 0)
+    {
+        std::cerr << "Cannot listen on " << path << ": " << strerror(errno) << std::endl;
+        return 1;
+    }
+
+    while (true)
+    {
+        int connection = accept(listener, nullptr, nullptr);
+        if (connection < 0)
+        {
+            // a signal, or a client that hung up while queued
+            if (errno == EINTR || errno == ECONNABORTED)
+            {
+                continue;
+            }
+            std::cerr << "accept failed: " << strerror(errno) << std::endl;
+            close(listener);
+            return 1;
+        }
+        {
+            // serve() reads on this thread while workers write, so each
+            // direction gets its own buffer and stream state
+            SocketBuf in_buffer(connection);
+            SocketBuf out_buffer(connection);
+            std::istream input(&in_buffer);
+            std::ostream output(&out_buffer);
+            serve(input, output);
+        }
+        close(connection);
+    }
+}
+
+int daemon_main(int argc, char **argv)
+{
+    int threads = 0;
+    std::string socket_path;
+    for (int i = 2; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        if (arg == "--socket" && i + 1 < argc)
+        {
+            socket_path = argv[++i];
+        }
+        else if (isdigit(arg[0]))
+        {
+            threads = atoi(arg.c_str());
+        }
+        else
+        {
+            std::cout << "Usage: euchre.exe --daemon [THREADS] [--socket PATH]" << std::endl;
+            return 1;
+        }
+    }
+    if (threads == 0)
+    {
+        threads = default_thread_count();
+    }
+
+    std::ios::sync_with_stdio(false);
+    Daemon daemon(threads);
+    if (!socket_path.empty())
+    {
+        return daemon.serve_socket(socket_path);
+    }
+    daemon.serve(std::cin, std::cout);
+    return 0;
+}
@@ -0,0 +1,87 @@
+#ifndef DAEMON_HPP
+#define DAEMON_HPP
+/* Daemon.hpp
+ *
+ * Long-running server that plays games described by job lines, so that
+ * many short games can be played without starting a process for each.
+ *
+ * Each job is one line of whitespace separated fields:
+ *   ID PACK SHUFFLE POINTS_TO_WIN NAME1 TYPE1 NAME2 TYPE2 NAME3 TYPE3
+ *   NAME4 TYPE4 [FORMAT]
+ * PACK is a pack file name, or "default" for the standard order.
+ * SHUFFLE is "shuffle", "noshuffle" or "random:SEED".
+ * FORMAT is "summary" (the default) or "full".
+ *
+ * Each job produces one result:
+ *   ID ok WINNING_TEAM TEAM0_POINTS TEAM1_POINTS HANDS      (summary)
+ *   ID ok WINNING_TEAM TEAM0_POINTS TEAM1_POINTS HANDS LINES
+ *   followed by LINES lines of game output                   (full)
+ *   ID error MESSAGE
+ * Results are written as games finish, which may not be the order the
+ * jobs arrived in.
+ */
+
+#include <array>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+#include "ThreadPool.hpp"
+
+struct Job
+{
+    std::string id;
+    std::string pack_source;
+    bool shuffle = false;
+    bool random_shuffle = false;
+    uint64_t seed = 0;
+    int points_to_win = 0;
+    std::array<std::string, 4> names;
+    std::array<std::string, 4> strategies;
+    bool full_output = false;
+};
+
+// MODIFIES: job, error
+// EFFECTS: Parses a job line.  Returns false and sets error if the line is
+//          not a valid job.  job.id is set whenever the line has an id.
+bool parse_job(const std::string &line, Job &job, std::string &error);
+
+class Daemon
+{
+public:
+    // REQUIRES: num_threads >= 1
+    // EFFECTS: Starts num_threads workers.  Workers keep their Game, players
+    //          and loaded packs from one job to the next.
+    explicit Daemon(int num_threads);
+
+    ~Daemon();
+
+    // REQUIRES: input and output do not share a stream buffer; workers
+    //           write results while this thread is still reading
+    // EFFECTS: Reads job lines from input until end of input, plays them
+    //          and writes one result per job to output.  Returns the number
+    //          of jobs read.
+    long serve(std::istream &input, std::ostream &output);
+
+    // EFFECTS: Listens on the Unix socket at path and serves connections
+    //          one after another.  Returns only on error.
+    int serve_socket(const std::string &path);
+
+private:
+    struct Worker;
+    class PackCache;
+
+    ThreadPool pool;
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::unique_ptr<PackCache> packs;
+
+    // EFFECTS: plays job on worker and returns its result text
+    std::string play_job(const Job &job, Worker &worker);
+};
+
+// EFFECTS: Runs the daemon from command line arguments
+//          --daemon [THREADS] [--socket PATH].  Returns the exit status.
+int daemon_main(int argc, char **argv);
+
+#endif // DAEMON_HPP
@@ -0,0 +1,69 @@
+#include "Daemon.hpp"
+#include "unit_test_framework.hpp"
+
+#include <fstream>
+#include <sstream>
+
+using namespace std;
+
+TEST(test_parse_job) {
+    Job job;
+    string error;
+    ASSERT_TRUE(parse_job("j1 pack.in random:42 10 A Simple B Simple C Simple D Simple",
+                          job, error));
+    ASSERT_EQUAL(job.id, "j1");
+    ASSERT_TRUE(job.random_shuffle);
+    ASSERT_EQUAL(job.seed, 42u);
+    ASSERT_EQUAL(job.points_to_win, 10);
+    ASSERT_EQUAL(job.names[3], "D");
+    ASSERT_FALSE(job.full_output);
+
+    ASSERT_FALSE(parse_job("j2 pack.in noshuffle 10 A Simple B Human C Simple D Simple",
+                           job, error));
+    ASSERT_EQUAL(job.id, "j2");
+    ASSERT_FALSE(parse_job("j3 pack.in sometimes 10 A Simple B Simple C Simple D Simple",
+                           job, error));
+    ASSERT_FALSE(parse_job("j4 pack.in shuffle 10 A Simple B Simple", job, error));
+}
+
+TEST(test_daemon_full_output_matches_game) {
+    // the transcript of a full job is the game output without the
+    // command line that euchre.exe prints first
+    ifstream correct_file("euchre_test00.out.correct");
+    string command_line;
+    getline(correct_file, command_line);
+    ostringstream correct;
+    correct << correct_file.rdbuf();
+
+    istringstream input(
+        "a pack.in noshuffle 1 Adi Simple Barbara Simple Chi-Chih Simple Dabbala Simple full\n"
+        "\n"
+        "b default shuffle 10 Edsger Simple Fran Simple Gabriel Simple Herb Simple\n"
+        "c missing.in shuffle 10 Edsger Simple Fran Simple Gabriel Simple Herb Simple\n");
+    ostringstream output;
+    Daemon daemon(1);
+    ASSERT_EQUAL(daemon.serve(input, output), 3);
+
+    istringstream results(output.str());
+    string id, status;
+    int winner, points0, points1, hands, lines;
+    results >> id >> status >> winner >> points0 >> points1 >> hands >> lines;
+    ASSERT_EQUAL(id, "a");
+    ASSERT_EQUAL(status, "ok");
+    results.ignore();
+    string transcript;
+    for (int i = 0; i < lines; i++) {
+        string line;
+        getline(results, line);
+        transcript += line + "\n";
+    }
+    ASSERT_EQUAL(transcript, correct.str());
+
+    string rest;
+    getline(results, rest);
+    ASSERT_EQUAL(rest.substr(0, 5), "b ok ");
+    getline(results, rest);
+    ASSERT_EQUAL(rest, "c error cannot open missing.in");
+}
+
+TEST_MAIN()
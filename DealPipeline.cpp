@@ -0,0 +1,269 @@
+#include "DealPipeline.hpp"
+#include "Pack.hpp"
+#include "Player.hpp"
+#include "Random.hpp"
+#include "RingBuffer.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+namespace
+{
+    const int NUM_PLAYERS = 4;
+    const int NUM_CARDS = Pack::PACK_SIZE;
+    const int UPCARD_POSITION = 20;
+    const int LANES = 8;
+    const uint64_t GOLDEN_GAMMA = 0x9e3779b97f4a7c15ull;
+
+    // the player that receives each pack position when player 0 deals
+    constexpr std::array<int8_t, NUM_CARDS> make_receivers()
+    {
+        const int pattern[2 * NUM_PLAYERS] = {3, 2, 3, 2, 2, 3, 2, 3};
+        std::array<int8_t, NUM_CARDS> receivers{};
+        int position = 0;
+        for (int i = 0; i < 2 * NUM_PLAYERS; i++)
+        {
+            for (int j = 0; j < pattern[i]; j++)
+            {
+                receivers[position++] = int8_t((i + 1) % NUM_PLAYERS);
+            }
+        }
+        for (; position < NUM_CARDS; position++)
+        {
+            receivers[position] = -1; // the upcard and the kitty
+        }
+        return receivers;
+    }
+
+    constexpr std::array<int8_t, NUM_CARDS> RECEIVERS = make_receivers();
+
+    // MODIFIES: record
+    // EFFECTS: fills record's hands and upcard from a pack of card indices
+    void deal_from(const uint8_t *cards, DealRecord &record)
+    {
+        record.hands = {};
+        for (int position = 0; position < UPCARD_POSITION; position++)
+        {
+            record.hands[RECEIVERS[position]] |= uint32_t(1) << cards[position];
+        }
+        record.upcard = cards[UPCARD_POSITION];
+    }
+}
+
+void generate_deals(uint64_t seed, uint64_t first, int count, DealRecord *records)
+{
+    for (int start = 0; start < count; start += LANES)
+    {
+        const int lanes = std::min(LANES, count - start);
+
+        // one SplitMix64 stream per lane, laid out so each step works on
+        // every lane at once; Random::next() is mix64 of the old state
+        uint64_t state[LANES];
+        uint8_t cards[LANES][NUM_CARDS];
+        for (int lane = 0; lane < LANES; lane++)
+        {
+            state[lane] = derive_seed(seed, first + start + lane);
+            for (int i = 0; i < NUM_CARDS; i++)
+            {
+                cards[lane][i] = uint8_t(i);
+            }
+        }
+
+        // Fisher-Yates in the same order as Pack::shuffle(seed)
+        for (int i = NUM_CARDS - 1; i > 0; i--)
+        {
+            uint64_t bits[LANES];
+            for (int lane = 0; lane < LANES; lane++)
+            {
+                bits[lane] = mix64(state[lane]);
+                state[lane] += GOLDEN_GAMMA;
+            }
+            for (int lane = 0; lane < LANES; lane++)
+            {
+                const uint64_t j = ((bits[lane] >> 32) * uint64_t(i + 1)) >> 32;
+                std::swap(cards[lane][i], cards[lane][j]);
+            }
+        }
+
+        for (int lane = 0; lane < lanes; lane++)
+        {
+            DealRecord &record = records[start + lane];
+            record.index = first + start + lane;
+            deal_from(cards[lane], record);
+        }
+    }
+}
+
+DealRecord make_deal(uint64_t seed, uint64_t index)
+{
+    Pack pack;
+    pack.shuffle(derive_seed(seed, index));
+    uint8_t cards[NUM_CARDS];
+    for (int i = 0; i < NUM_CARDS; i++)
+    {
+        cards[i] = uint8_t(Card_to_index(pack.deal_one()));
+    }
+    DealRecord record;
+    record.index = index;
+    deal_from(cards, record);
+    return record;
+}
+
+DealPipelineStats run_deal_pipeline(const DealPipelineOptions &options, ThreadPool &pool,
+                                    const std::function<void(int worker,
+                                                             const DealRecord &deal)> &consume)
+{
+    const auto start_time = chrono::steady_clock::now();
+    const long num_batches = (options.deals + DEAL_BATCH_SIZE - 1) / DEAL_BATCH_SIZE;
+    RingBuffer<DealBatch> ring(options.ring_batches);
+    std::atomic<long> next_produced(0);
+    std::atomic<long> next_consumed(0);
+    std::atomic<long> producer_waits(0);
+    std::atomic<long> consumer_waits(0);
+
+    // producers claim batches in turn; a full ring means the workers are
+    // the bottleneck, so the producer steps aside until they catch up
+    std::vector<std::thread> producers;
+    for (int p = 0; p < options.producers; p++)
+    {
+        producers.emplace_back([&]() {
+            DealBatch batch;
+            for (long b = next_produced++; b < num_batches; b = next_produced++)
+            {
+                batch.first = uint64_t(b) * DEAL_BATCH_SIZE;
+                batch.count = int(std::min<long>(DEAL_BATCH_SIZE,
+                                                 options.deals - long(batch.first)));
+                generate_deals(options.seed, batch.first, batch.count, batch.records.data());
+                while (!ring.try_push(batch))
+                {
+                    producer_waits++;
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    // each worker claims a batch before popping, so it knows one is coming
+    pool.parallel_for(pool.size(), [&](int worker, int) {
+        DealBatch batch;
+        for (long b = next_consumed++; b < num_batches; b = next_consumed++)
+        {
+            while (!ring.try_pop(batch))
+            {
+                consumer_waits++;
+                std::this_thread::yield();
+            }
+            for (int i = 0; i < batch.count; i++)
+            {
+                consume(worker, batch.records[i]);
+            }
+        }
+    });
+    for (std::thread &producer : producers)
+    {
+        producer.join();
+    }
+
+    DealPipelineStats stats;
+    stats.deals = options.deals;
+    stats.seconds = chrono::duration<double>(chrono::steady_clock::now() - start_time).count();
+    stats.producer_waits = producer_waits;
+    stats.consumer_waits = consumer_waits;
+    return stats;
+}
+
+static void print_stats(const string &label, const DealPipelineStats &stats, ostream &os)
+{
+    os << label << ": " << stats.deals << " deals in " << fixed << setprecision(3)
+       << stats.seconds << " s (" << setprecision(0)
+       << stats.deals / std::max(stats.seconds, 1e-9) << " deals/s), "
+       << stats.producer_waits << " producer waits, " << stats.consumer_waits
+       << " worker waits" << endl;
+    os.unsetf(ios::floatfield);
+}
+
+static void print_deal_pipeline_usage()
+{
+    cout << "Usage: euchre.exe --deal-pipeline DEALS PRODUCERS WORKERS [--seed N]" << endl;
+}
+
+int deal_pipeline_main(int argc, char **argv)
+{
+    if (argc < 5)
+    {
+        print_deal_pipeline_usage();
+        return 1;
+    }
+    DealPipelineOptions options;
+    options.deals = atol(argv[2]);
+    options.producers = atoi(argv[3]);
+    const int workers = atoi(argv[4]);
+    for (int i = 5; i < argc; i++)
+    {
+        const string option = argv[i];
+        if (option == "--seed" && i + 1 < argc)
+        {
+            options.seed = strtoull(argv[++i], nullptr, 10);
+        }
+        else
+        {
+            print_deal_pipeline_usage();
+            return 1;
+        }
+    }
+    if (options.deals < 1 || options.producers < 1 || workers < 0)
+    {
+        print_deal_pipeline_usage();
+        return 2;
+    }
+    ThreadPool pool(workers == 0 ? default_thread_count() : workers);
+
+    // generation alone
+    std::vector<long> received(pool.size());
+    print_stats("deal only", run_deal_pipeline(options, pool, [&](int worker,
+                                                                  const DealRecord &) {
+                    received[worker]++;
+                }),
+                cout);
+
+    // generation overlapped with Simple players bidding the first round
+    std::vector<long> ordered_up(pool.size());
+    const DealPipelineStats stats = run_deal_pipeline(options, pool, [&](int worker,
+                                                                         const DealRecord &deal) {
+        const Card upcard = Card_from_index(deal.upcard);
+        Suit trump = upcard.get_suit();
+        for (int offset = 1; offset <= NUM_PLAYERS; offset++)
+        {
+            const int player = offset % NUM_PLAYERS;
+            std::unique_ptr<Player> bidder(Player_factory("Player " + to_string(player),
+                                                          "Simple"));
+            for (uint32_t cards = deal.hands[player]; cards; cards &= cards - 1)
+            {
+                bidder->add_card(Card_from_index(__builtin_ctz(cards)));
+            }
+            if (bidder->make_trump(upcard, player == 0, 1, trump))
+            {
+                ordered_up[worker]++;
+                break;
+            }
+        }
+    });
+    print_stats("deal + bid", stats, cout);
+    long total = 0;
+    for (long count : ordered_up)
+    {
+        total += count;
+    }
+    cout << "upcard ordered up in " << fixed << setprecision(1) << 100.0 * total / options.deals
+         << "% of deals" << endl;
+    return 0;
+}
@@ -0,0 +1,79 @@
+#ifndef DEALPIPELINE_HPP
+#define DEALPIPELINE_HPP
+/* DealPipeline.hpp
+ *
+ * A producer stage that generates seeded deals in bulk and hands them to
+ * simulation workers through a lock-free ring buffer, so dealing and
+ * playing overlap and each can be measured and scaled on its own.
+ *
+ * A deal is four hands as bitmasks of Card_to_index bits plus the upcard.
+ * Deal number i is the sorted pack shuffled with Pack::shuffle(
+ * derive_seed(seed, i)) and dealt 3-2-3-2 / 2-3-2-3 by player 0, so the
+ * player left of the dealer (player 1) receives the first cards.
+ */
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include "ThreadPool.hpp"
+
+struct DealRecord
+{
+    uint64_t index = 0;
+    std::array<uint32_t, 4> hands{};
+    uint8_t upcard = 0;
+};
+
+// Deals travel through the ring in batches to keep contention low
+const int DEAL_BATCH_SIZE = 64;
+
+struct DealBatch
+{
+    uint64_t first = 0;
+    int count = 0;
+    std::array<DealRecord, DEAL_BATCH_SIZE> records;
+};
+
+struct DealPipelineOptions
+{
+    uint64_t seed = 0;
+    long deals = 100000;
+    int producers = 1;
+    int ring_batches = 64;          // ring capacity, a power of two
+};
+
+struct DealPipelineStats
+{
+    long deals = 0;
+    double seconds = 0;
+    long producer_waits = 0;        // pushes that found the ring full
+    long consumer_waits = 0;        // pops that found the ring empty
+};
+
+// REQUIRES: count >= 0
+// MODIFIES: records
+// EFFECTS: Writes deals first, first + 1, ... first + count - 1 from seed
+//          into records[0 .. count).  Several deals are shuffled in
+//          lockstep, one random stream each.
+void generate_deals(uint64_t seed, uint64_t first, int count, DealRecord *records);
+
+// EFFECTS: returns deal index from seed, dealt one card at a time from a
+//          Pack; generate_deals gives the same deals
+DealRecord make_deal(uint64_t seed, uint64_t index);
+
+// REQUIRES: options.producers >= 1, options.ring_batches is a power of two
+// EFFECTS: Generates options.deals deals on options.producers threads and
+//          calls consume(worker, deal) for each one exactly once on pool's
+//          workers.  Deals arrive in no particular order; use deal.index
+//          to tally results deterministically.
+DealPipelineStats run_deal_pipeline(const DealPipelineOptions &options, ThreadPool &pool,
+                                    const std::function<void(int worker,
+                                                             const DealRecord &deal)> &consume);
+
+// EFFECTS: Benchmarks the pipeline from command line arguments
+//          DEALS PRODUCERS WORKERS [--seed N] and prints the deal rate
+//          with no work per deal and with Simple players bidding each
+//          deal.  Returns the process exit status.
+int deal_pipeline_main(int argc, char **argv);
+
+#endif // DEALPIPELINE_HPP
@@ -0,0 +1,150 @@
+#include "DealPipeline.hpp"
+#include "Pack.hpp"
+#include "Random.hpp"
+#include "RingBuffer.hpp"
+#include "unit_test_framework.hpp"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+TEST(test_generate_deals_matches_pack)
+{
+    // 21 is not a multiple of the lane count, so the last block is partial
+    vector<DealRecord> records(21);
+    generate_deals(42, 1000, int(records.size()), records.data());
+    for (size_t i = 0; i < records.size(); i++)
+    {
+        const DealRecord expected = make_deal(42, 1000 + i);
+        ASSERT_EQUAL(expected.index, records[i].index);
+        ASSERT_EQUAL(expected.upcard, records[i].upcard);
+        for (int player = 0; player < 4; player++)
+        {
+            ASSERT_EQUAL(expected.hands[player], records[i].hands[player]);
+        }
+    }
+}
+
+TEST(test_deals_are_valid)
+{
+    vector<DealRecord> records(500);
+    generate_deals(7, 0, int(records.size()), records.data());
+    for (const DealRecord &deal : records)
+    {
+        uint32_t all = uint32_t(1) << deal.upcard;
+        for (int player = 0; player < 4; player++)
+        {
+            ASSERT_EQUAL(__builtin_popcount(deal.hands[player]), 5);
+            ASSERT_EQUAL(all & deal.hands[player], 0u);
+            all |= deal.hands[player];
+        }
+    }
+}
+
+TEST(test_first_cards_go_left_of_dealer)
+{
+    const DealRecord deal = make_deal(5, 3);
+    Pack pack;
+    pack.shuffle(derive_seed(5, 3));
+    for (int i = 0; i < 3; i++)
+    {
+        ASSERT_TRUE(deal.hands[1] & (uint32_t(1) << Card_to_index(pack.deal_one())));
+    }
+    ASSERT_TRUE(deal.hands[2] & (uint32_t(1) << Card_to_index(pack.deal_one())));
+}
+
+TEST(test_ring_buffer_fifo)
+{
+    RingBuffer<int> ring(4);
+    int value = 0;
+    ASSERT_FALSE(ring.try_pop(value));
+    for (int i = 0; i < 4; i++)
+    {
+        ASSERT_TRUE(ring.try_push(i));
+    }
+    ASSERT_FALSE(ring.try_push(4));
+    for (int lap = 0; lap < 3; lap++)
+    {
+        ASSERT_TRUE(ring.try_pop(value));
+        ASSERT_EQUAL(value, lap);
+        ASSERT_TRUE(ring.try_push(4 + lap));
+    }
+    for (int i = 3; i < 7; i++)
+    {
+        ASSERT_TRUE(ring.try_pop(value));
+        ASSERT_EQUAL(value, i);
+    }
+    ASSERT_FALSE(ring.try_pop(value));
+}
+
+TEST(test_ring_buffer_many_threads)
+{
+    const int per_producer = 20000;
+    RingBuffer<long> ring(8);
+    atomic<long> sum(0);
+    atomic<int> popped(0);
+    vector<thread> threads;
+    for (int p = 0; p < 2; p++)
+    {
+        threads.emplace_back([&ring]() {
+            for (long i = 1; i <= per_producer; i++)
+            {
+                while (!ring.try_push(i))
+                {
+                    this_thread::yield();
+                }
+            }
+        });
+        threads.emplace_back([&]() {
+            long value = 0;
+            while (popped < 2 * per_producer)
+            {
+                if (ring.try_pop(value))
+                {
+                    sum += value;
+                    popped++;
+                }
+                else
+                {
+                    this_thread::yield();
+                }
+            }
+        });
+    }
+    for (thread &t : threads)
+    {
+        t.join();
+    }
+    ASSERT_EQUAL(sum.load(), 2L * per_producer * (per_producer + 1) / 2);
+}
+
+TEST(test_pipeline_consumes_every_deal_once)
+{
+    DealPipelineOptions options;
+    options.seed = 11;
+    options.deals = 1000; // not a multiple of the batch size
+    options.producers = 2;
+    options.ring_batches = 2;
+    ThreadPool pool(3);
+    vector<DealRecord> seen(options.deals);
+    vector<atomic<int>> counts(options.deals);
+    const DealPipelineStats stats = run_deal_pipeline(options, pool,
+                                                      [&](int, const DealRecord &deal) {
+        counts[deal.index]++;
+        seen[deal.index] = deal;
+    });
+    ASSERT_EQUAL(stats.deals, options.deals);
+
+    vector<DealRecord> expected(options.deals);
+    generate_deals(options.seed, 0, int(options.deals), expected.data());
+    for (long i = 0; i < options.deals; i++)
+    {
+        ASSERT_EQUAL(counts[i].load(), 1);
+        ASSERT_EQUAL(seen[i].upcard, expected[i].upcard);
+        ASSERT_EQUAL(seen[i].hands[0], expected[i].hands[0]);
+    }
+}
+
+TEST_MAIN()
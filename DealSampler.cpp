@@ -0,0 +1,217 @@
+#include "DealSampler.hpp"
+#include <cassert>
+#include <utility>
+
+using namespace std;
+
+namespace
+{
+    const int STATE_BASE = DealSampler::MAX_NEED + 1;
+    const int PLACE[DealSampler::NUM_PLAYERS] = {1, STATE_BASE, STATE_BASE * STATE_BASE,
+                                                 STATE_BASE * STATE_BASE * STATE_BASE};
+
+    __extension__ typedef unsigned __int128 uint128;
+
+    uint64_t binomial(int n, int k)
+    {
+        uint64_t result = 1;
+        for (int i = 1; i <= k; i++)
+        {
+            result = result * uint64_t(n - k + i) / uint64_t(i);
+        }
+        return result;
+    }
+
+    // EFFECTS: returns the cards each player still needs in state
+    array<uint8_t, DealSampler::NUM_PLAYERS> digits(int state)
+    {
+        array<uint8_t, DealSampler::NUM_PLAYERS> result;
+        for (int player = 0; player < DealSampler::NUM_PLAYERS; player++)
+        {
+            result[player] = uint8_t(state / PLACE[player] % STATE_BASE);
+        }
+        return result;
+    }
+
+    // EFFECTS: returns true if state still needs at least split's cards
+    bool fits(int state, const array<uint8_t, DealSampler::NUM_PLAYERS> &cards)
+    {
+        for (int player = 0; player < DealSampler::NUM_PLAYERS; player++)
+        {
+            if (state / PLACE[player] % STATE_BASE < cards[player])
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+DealSampler::DealSampler(const DealConstraints &constraints) : start_state(0)
+{
+    for (int player = 0; player < NUM_PLAYERS; player++)
+    {
+        assert(0 <= constraints.need[player] && constraints.need[player] <= MAX_NEED);
+        start_state += constraints.need[player] * PLACE[player];
+    }
+
+    // group the unseen cards by which players may hold them
+    array<uint32_t, 1 << NUM_PLAYERS> by_allowed{};
+    for (uint32_t cards = constraints.unseen; cards; cards &= cards - 1)
+    {
+        const int card = __builtin_ctz(cards);
+        int allowed = 0;
+        for (int player = 0; player < NUM_PLAYERS; player++)
+        {
+            if (!(constraints.excluded[player] & (uint32_t(1) << card)))
+            {
+                allowed |= 1 << player;
+            }
+        }
+        by_allowed[allowed] |= uint32_t(1) << card;
+    }
+
+    for (int allowed = 0; allowed < int(by_allowed.size()); allowed++)
+    {
+        if (!by_allowed[allowed])
+        {
+            continue;
+        }
+        CardClass card_class;
+        for (uint32_t cards = by_allowed[allowed]; cards; cards &= cards - 1)
+        {
+            card_class.cards.push_back(uint8_t(__builtin_ctz(cards)));
+        }
+
+        // every split that gives each allowed player at most its need
+        const int size = int(card_class.cards.size());
+        array<uint8_t, NUM_PLAYERS> split{};
+        while (true)
+        {
+            int dealt = 0;
+            int delta = 0;
+            uint64_t weight = 1;
+            for (int player = 0; player < NUM_PLAYERS; player++)
+            {
+                weight *= binomial(size - dealt, split[player]);
+                dealt += split[player];
+                delta += split[player] * PLACE[player];
+            }
+            if (dealt <= size)
+            {
+                card_class.splits.push_back({split, delta, weight});
+            }
+
+            // next split, counting up over the allowed players
+            int player = 0;
+            for (; player < NUM_PLAYERS; player++)
+            {
+                if (!(allowed & (1 << player)))
+                {
+                    continue;
+                }
+                if (split[player] < constraints.need[player])
+                {
+                    split[player]++;
+                    break;
+                }
+                split[player] = 0;
+            }
+            if (player == NUM_PLAYERS)
+            {
+                break;
+            }
+        }
+        classes.push_back(std::move(card_class));
+    }
+
+    // only states that never need more than the start are reachable
+    std::vector<int> states;
+    for (int state = 0; state < NUM_STATES; state++)
+    {
+        if (fits(start_state, digits(state)))
+        {
+            states.push_back(state);
+        }
+    }
+
+    // count completions from the last class back to the first
+    const int num_classes = int(classes.size());
+    completions.assign(size_t(num_classes + 1) * NUM_STATES, 0);
+    completions[size_t(num_classes) * NUM_STATES] = 1;
+    for (int c = num_classes - 1; c >= 0; c--)
+    {
+        const uint64_t *next = &completions[size_t(c + 1) * NUM_STATES];
+        uint64_t *here = &completions[size_t(c) * NUM_STATES];
+        for (int state : states)
+        {
+            for (const Split &split : classes[c].splits)
+            {
+                if (fits(state, split.cards))
+                {
+                    here[state] += split.weight * next[state - split.state_delta];
+                }
+            }
+        }
+    }
+}
+
+uint64_t DealSampler::count() const
+{
+    return completions[start_state];
+}
+
+array<uint32_t, DealSampler::NUM_PLAYERS> DealSampler::sample(Random &random) const
+{
+    assert(count() > 0);
+    array<uint32_t, NUM_PLAYERS> hands{};
+    int state = start_state;
+    for (size_t c = 0; c < classes.size(); c++)
+    {
+        const uint64_t *next = &completions[(c + 1) * NUM_STATES];
+        const uint64_t total = completions[c * NUM_STATES + state];
+        uint64_t target = uint64_t((uint128(random.next()) * total) >> 64);
+
+        // choose a split in proportion to the deals it leads to
+        const Split *chosen = nullptr;
+        for (const Split &split : classes[c].splits)
+        {
+            if (!fits(state, split.cards))
+            {
+                continue;
+            }
+            const uint64_t ways = split.weight * next[state - split.state_delta];
+            if (target < ways)
+            {
+                chosen = &split;
+                break;
+            }
+            target -= ways;
+        }
+        assert(chosen);
+
+        // then which of the class's cards each player gets
+        uint8_t cards[32];
+        const int size = int(classes[c].cards.size());
+        std::copy(classes[c].cards.begin(), classes[c].cards.end(), cards);
+        int dealt = 0;
+        for (int player = 0; player < NUM_PLAYERS; player++)
+        {
+            for (int k = 0; k < chosen->cards[player]; k++, dealt++)
+            {
+                std::swap(cards[dealt], cards[dealt + random.below(size - dealt)]);
+                hands[player] |= uint32_t(1) << cards[dealt];
+            }
+        }
+        state -= chosen->state_delta;
+    }
+    return hands;
+}
+
+void DealSampler::sample(Random &random, array<uint32_t, NUM_PLAYERS> *hands, int n) const
+{
+    for (int i = 0; i < n; i++)
+    {
+        hands[i] = sample(random);
+    }
+}
@@ -0,0 +1,78 @@
+#ifndef DEALSAMPLER_HPP
+#define DEALSAMPLER_HPP
+/* DealSampler.hpp
+ *
+ * Uniform random deals of the unseen cards that respect what a player
+ * knows: how many hidden cards each player still holds and which cards
+ * each player cannot hold (suits they have shown void in, or cards known
+ * to be elsewhere).  Unseen cards nobody holds stay in the kitty.
+ *
+ * Cards that the same players are allowed to hold are interchangeable, so
+ * the sampler groups them into at most 16 classes and counts, for every
+ * class and every vector of remaining needs, how many ways the rest of the
+ * deal can be completed.  Drawing a deal then walks the classes once,
+ * picking each class's split in proportion to its completions.  There are
+ * no rejection loops, so heavy constraints cost nothing extra.
+ */
+
+#include <array>
+#include <cstdint>
+#include <vector>
+#include "Random.hpp"
+
+struct DealConstraints
+{
+    std::array<int, 4> need{};            // hidden cards each player holds
+    std::array<uint32_t, 4> excluded{};   // cards each player cannot hold
+    uint32_t unseen = 0;                  // cards to deal, kitty included
+};
+
+class DealSampler
+{
+public:
+    static const int NUM_PLAYERS = 4;
+    static const int MAX_NEED = 5;
+
+    // REQUIRES: 0 <= need[p] <= MAX_NEED for each player, and the needs
+    //           sum to at most the number of unseen cards
+    // EFFECTS: Counts the deals that satisfy constraints
+    explicit DealSampler(const DealConstraints &constraints);
+
+    // EFFECTS: returns the number of deals that satisfy the constraints
+    uint64_t count() const;
+
+    // REQUIRES: count() > 0
+    // MODIFIES: random
+    // EFFECTS: returns the hidden hands of a uniformly random deal
+    std::array<uint32_t, NUM_PLAYERS> sample(Random &random) const;
+
+    // REQUIRES: count() > 0
+    // MODIFIES: random, hands
+    // EFFECTS: writes n uniformly random deals into hands[0 .. n)
+    void sample(Random &random, std::array<uint32_t, NUM_PLAYERS> *hands, int n) const;
+
+private:
+    static const int NUM_STATES = 6 * 6 * 6 * 6; // remaining needs, base 6
+
+    // One way to split a class: cards to each player, the rest unheld
+    struct Split
+    {
+        std::array<uint8_t, NUM_PLAYERS> cards;
+        int state_delta;
+        uint64_t weight;      // ways to choose which cards go where
+    };
+
+    struct CardClass
+    {
+        std::vector<uint8_t> cards;
+        std::vector<Split> splits;
+    };
+
+    std::vector<CardClass> classes;
+    // completions[c * NUM_STATES + s]: ways to deal classes c.. when the
+    // players still need the cards encoded by s
+    std::vector<uint64_t> completions;
+    int start_state;
+};
+
+#endif // DEALSAMPLER_HPP
@@ -0,0 +1,147 @@
+#include "DealSampler.hpp"
+#include "unit_test_framework.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <map>
+#include <vector>
+
+using namespace std;
+
+typedef array<uint32_t, 4> Hands;
+
+// EFFECTS: returns every deal that satisfies constraints, by brute force
+static vector<Hands> all_deals(const DealConstraints &constraints)
+{
+    vector<int> cards;
+    for (uint32_t unseen = constraints.unseen; unseen; unseen &= unseen - 1)
+    {
+        cards.push_back(__builtin_ctz(unseen));
+    }
+    vector<Hands> deals;
+    long assignments = 1;
+    for (size_t i = 0; i < cards.size(); i++)
+    {
+        assignments *= 5;
+    }
+    for (long a = 0; a < assignments; a++)
+    {
+        Hands hands{};
+        bool valid = true;
+        long code = a;
+        for (int card : cards)
+        {
+            const int holder = int(code % 5); // 4 is the kitty
+            code /= 5;
+            if (holder < 4)
+            {
+                hands[holder] |= uint32_t(1) << card;
+                valid = valid && !(constraints.excluded[holder] & (uint32_t(1) << card));
+            }
+        }
+        for (int player = 0; player < 4 && valid; player++)
+        {
+            valid = __builtin_popcount(hands[player]) == constraints.need[player];
+        }
+        if (valid)
+        {
+            deals.push_back(hands);
+        }
+    }
+    return deals;
+}
+
+static DealConstraints small_constraints()
+{
+    DealConstraints constraints;
+    constraints.unseen = 0x3f3;        // eight cards
+    constraints.need = {2, 0, 3, 1};   // two left in the kitty
+    constraints.excluded[0] = 0x0f0;   // player 0 void in part of them
+    constraints.excluded[2] = 0x303;
+    constraints.excluded[3] = 0x3c0;
+    return constraints;
+}
+
+TEST(test_count_matches_brute_force)
+{
+    const DealConstraints constraints = small_constraints();
+    ASSERT_EQUAL(DealSampler(constraints).count(), uint64_t(all_deals(constraints).size()));
+
+    DealConstraints open;
+    open.unseen = 0xff;
+    open.need = {2, 2, 2, 1};
+    ASSERT_EQUAL(DealSampler(open).count(), uint64_t(all_deals(open).size()));
+}
+
+TEST(test_impossible_constraints_count_zero)
+{
+    DealConstraints constraints;
+    constraints.unseen = 0xf;
+    constraints.need = {3, 1, 0, 0};
+    constraints.excluded[0] = 0x3; // player 0 can hold only two of them
+    ASSERT_EQUAL(DealSampler(constraints).count(), uint64_t(0));
+}
+
+TEST(test_samples_are_uniform)
+{
+    const DealConstraints constraints = small_constraints();
+    const vector<Hands> deals = all_deals(constraints);
+    const DealSampler sampler(constraints);
+    map<Hands, long> seen;
+    Random random(1);
+    vector<Hands> batch(deals.size() * 10);
+    const long samples = 20 * long(batch.size());
+    for (long done = 0; done < samples; done += long(batch.size()))
+    {
+        sampler.sample(random, batch.data(), int(batch.size()));
+        for (const Hands &hands : batch)
+        {
+            seen[hands]++;
+        }
+    }
+
+    // every sample is a legal deal, and each deal turns up about equally
+    ASSERT_EQUAL(seen.size(), deals.size());
+    const double expected = double(samples) / deals.size();
+    double chi_squared = 0;
+    for (const Hands &hands : deals)
+    {
+        const double difference = seen[hands] - expected;
+        chi_squared += difference * difference / expected;
+    }
+    const double freedom = double(deals.size() - 1);
+    ASSERT_TRUE(chi_squared < freedom + 5 * sqrt(2 * freedom));
+}
+
+TEST(test_heavy_voids_full_size)
+{
+    // 15 hidden cards in four suits; player 1 and 3 void in most of them
+    DealConstraints constraints;
+    constraints.unseen = 0xfffe00;
+    constraints.need = {0, 5, 5, 4};
+    constraints.excluded[1] = 0x00fe00;
+    constraints.excluded[3] = 0xfc0000;
+    const DealSampler sampler(constraints);
+    ASSERT_TRUE(sampler.count() > 0);
+
+    Random random(9);
+    vector<Hands> batch(10000);
+    const auto start = chrono::steady_clock::now();
+    sampler.sample(random, batch.data(), int(batch.size()));
+    const chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+    for (const Hands &hands : batch)
+    {
+        uint32_t dealt = 0;
+        for (int player = 0; player < 4; player++)
+        {
+            ASSERT_EQUAL(__builtin_popcount(hands[player]), constraints.need[player]);
+            ASSERT_EQUAL(hands[player] & constraints.excluded[player], 0u);
+            ASSERT_EQUAL(hands[player] & ~constraints.unseen, 0u);
+            ASSERT_EQUAL(hands[player] & dealt, 0u);
+            dealt |= hands[player];
+        }
+    }
+    ASSERT_TRUE(elapsed.count() < 1.0);
+}
+
+TEST_MAIN()
@@ -0,0 +1,527 @@
+#include "DecisionLog.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <iterator>
+
+using namespace std;
+
+namespace
+{
+    const char LOG_MAGIC[4] = {'E', 'U', 'D', 'L'};
+    const uint32_t LOG_VERSION = 1;
+    const size_t HEADER_SIZE = 4 + 4 + 4;
+    const size_t BLOCK_HEADER_SIZE = 4 + 8 + 8;
+    const int FIXED_COLUMNS = 7;    // deal, decision, seat, kind, option, chosen, points
+    const int NUM_COLUMNS = FIXED_COLUMNS + LEARNED_INPUTS;
+    const size_t MAX_DICTIONARY = 256;
+    const size_t COPY_BUFFER = 1 << 16;
+
+    enum Codec : uint8_t
+    {
+        RAW_CODEC,
+        DICTIONARY_CODEC,
+    };
+
+    void put_u64(string &out, uint64_t value, int bytes = 8)
+    {
+        for (int i = 0; i < bytes; i++)
+        {
+            out.push_back(char((value >> (8 * i)) & 0xff));
+        }
+    }
+
+    uint64_t get_u64(const unsigned char *in, int bytes = 8)
+    {
+        uint64_t value = 0;
+        for (int i = 0; i < bytes; i++)
+        {
+            value |= uint64_t(in[i]) << (8 * i);
+        }
+        return value;
+    }
+
+    string file_header()
+    {
+        string out(LOG_MAGIC, sizeof(LOG_MAGIC));
+        put_u64(out, LOG_VERSION, 4);
+        put_u64(out, LEARNED_INPUTS, 4);
+        return out;
+    }
+
+    uint32_t float_bits(float value)
+    {
+        uint32_t word;
+        memcpy(&word, &value, sizeof(word));
+        return word;
+    }
+
+    float bits_float(uint32_t word)
+    {
+        float value;
+        memcpy(&value, &word, sizeof(value));
+        return value;
+    }
+
+    // MODIFIES: words
+    // EFFECTS: Sets words to column of each row, as a word
+    void column_words(const vector<DecisionRow> &rows, int column,
+                      vector<uint32_t> &words)
+    {
+        words.resize(rows.size());
+        uint64_t previous = rows.empty() ? 0 : rows[0].deal;
+        for (size_t r = 0; r < rows.size(); r++)
+        {
+            const DecisionRow &row = rows[r];
+            switch (column)
+            {
+            case 0:
+                words[r] = uint32_t(row.deal - previous);
+                previous = row.deal;
+                break;
+            case 1:
+                words[r] = row.decision;
+                break;
+            case 2:
+                words[r] = row.seat;
+                break;
+            case 3:
+                words[r] = row.kind;
+                break;
+            case 4:
+                words[r] = row.option;
+                break;
+            case 5:
+                words[r] = row.chosen;
+                break;
+            case 6:
+                words[r] = uint8_t(row.points);
+                break;
+            default:
+                words[r] = float_bits(row.features[column - FIXED_COLUMNS]);
+            }
+        }
+    }
+
+    // MODIFIES: rows
+    // EFFECTS: Stores words as column of rows, first_deal being the deal
+    //          the first difference is taken from
+    void set_column(const vector<uint32_t> &words, int column, uint64_t first_deal,
+                    DecisionRow *rows)
+    {
+        uint64_t deal = first_deal;
+        for (size_t r = 0; r < words.size(); r++)
+        {
+            DecisionRow &row = rows[r];
+            switch (column)
+            {
+            case 0:
+                deal += uint64_t(int64_t(int32_t(words[r])));
+                row.deal = deal;
+                break;
+            case 1:
+                row.decision = uint8_t(words[r]);
+                break;
+            case 2:
+                row.seat = uint8_t(words[r]);
+                break;
+            case 3:
+                row.kind = uint8_t(words[r]);
+                break;
+            case 4:
+                row.option = uint8_t(words[r]);
+                break;
+            case 5:
+                row.chosen = uint8_t(words[r]);
+                break;
+            case 6:
+                row.points = int8_t(uint8_t(words[r]));
+                break;
+            default:
+                row.features[column - FIXED_COLUMNS] = bits_float(words[r]);
+            }
+        }
+    }
+
+    // MODIFIES: out
+    // EFFECTS: Appends words in the dictionary codec if they hold at most
+    //          MAX_DICTIONARY distinct values, otherwise raw
+    void encode_column(const vector<uint32_t> &words, string &out)
+    {
+        vector<uint32_t> dictionary(words);
+        sort(dictionary.begin(), dictionary.end());
+        dictionary.erase(unique(dictionary.begin(), dictionary.end()), dictionary.end());
+        if (dictionary.size() > MAX_DICTIONARY)
+        {
+            out.push_back(char(RAW_CODEC));
+            for (uint32_t word : words)
+            {
+                put_u64(out, word, 4);
+            }
+            return;
+        }
+
+        int bits = 0;
+        while ((size_t(1) << bits) < dictionary.size())
+        {
+            bits++;
+        }
+        out.push_back(char(DICTIONARY_CODEC));
+        put_u64(out, dictionary.size(), 2);
+        for (uint32_t word : dictionary)
+        {
+            put_u64(out, word, 4);
+        }
+        out.push_back(char(bits));
+        uint32_t buffer = 0;
+        int buffered = 0;
+        for (uint32_t word : words)
+        {
+            const uint32_t index =
+                uint32_t(lower_bound(dictionary.begin(), dictionary.end(), word) -
+                         dictionary.begin());
+            buffer |= index << buffered;
+            buffered += bits;
+            for (; buffered >= 8; buffered -= 8, buffer >>= 8)
+            {
+                out.push_back(char(buffer & 0xff));
+            }
+        }
+        if (buffered > 0)
+        {
+            out.push_back(char(buffer & 0xff));
+        }
+    }
+
+    // MODIFIES: in, words
+    // EFFECTS: Decodes one column of count words starting at in, advancing
+    //          in past it.  Returns false if it would run past end.
+    bool decode_column(const unsigned char *&in, const unsigned char *end, size_t count,
+                       vector<uint32_t> &words)
+    {
+        words.resize(count);
+        if (in >= end)
+        {
+            return false;
+        }
+        const uint8_t codec = *in++;
+        if (codec == RAW_CODEC)
+        {
+            if (size_t(end - in) < 4 * count)
+            {
+                return false;
+            }
+            for (size_t r = 0; r < count; r++, in += 4)
+            {
+                words[r] = uint32_t(get_u64(in, 4));
+            }
+            return true;
+        }
+        if (codec != DICTIONARY_CODEC || end - in < 2)
+        {
+            return false;
+        }
+        const size_t size = get_u64(in, 2);
+        in += 2;
+        if (size == 0 || size > MAX_DICTIONARY || size_t(end - in) < 4 * size + 1)
+        {
+            return false;
+        }
+        uint32_t dictionary[MAX_DICTIONARY];
+        for (size_t i = 0; i < size; i++, in += 4)
+        {
+            dictionary[i] = uint32_t(get_u64(in, 4));
+        }
+        const int bits = *in++;
+        if (bits > 8 || (size_t(1) << bits) < size ||
+            size_t(end - in) < (count * bits + 7) / 8)
+        {
+            return false;
+        }
+        const uint32_t mask = (uint32_t(1) << bits) - 1;
+        uint32_t buffer = 0;
+        int buffered = 0;
+        for (size_t r = 0; r < count; r++)
+        {
+            for (; buffered < bits; buffered += 8)
+            {
+                buffer |= uint32_t(*in++) << buffered;
+            }
+            const uint32_t index = buffer & mask;
+            buffer >>= bits;
+            buffered -= bits;
+            if (index >= size)
+            {
+                return false;
+            }
+            words[r] = dictionary[index];
+        }
+        return true;
+    }
+
+    struct Block
+    {
+        uint64_t first_deal = 0;
+        string bytes;       // header and payload as written
+    };
+
+    // MODIFIES: blocks
+    // EFFECTS: Appends the blocks of path to blocks.  Returns false if path
+    //          cannot be read or is malformed.
+    bool read_blocks(const string &path, vector<Block> &blocks)
+    {
+        ifstream file(path, ios::binary);
+        if (!file)
+        {
+            return false;
+        }
+        const string data((istreambuf_iterator<char>(file)), istreambuf_iterator<char>());
+        if (data.size() < HEADER_SIZE || data.compare(0, HEADER_SIZE, file_header()) != 0)
+        {
+            return false;
+        }
+        for (size_t at = HEADER_SIZE; at < data.size();)
+        {
+            const unsigned char *in = reinterpret_cast<const unsigned char *>(&data[at]);
+            if (data.size() - at < BLOCK_HEADER_SIZE)
+            {
+                return false;
+            }
+            const uint64_t payload = get_u64(in + 12);
+            if (payload > data.size() - at - BLOCK_HEADER_SIZE)
+            {
+                return false;
+            }
+            Block block;
+            block.first_deal = get_u64(in + 4);
+            block.bytes = data.substr(at, BLOCK_HEADER_SIZE + payload);
+            blocks.push_back(std::move(block));
+            at += BLOCK_HEADER_SIZE + payload;
+        }
+        return true;
+    }
+
+    // Where a block sits in one of the files being merged
+    struct BlockRef
+    {
+        uint64_t first_deal = 0;
+        size_t part = 0;
+        uint64_t offset = 0;
+        uint64_t size = 0;  // header and payload
+    };
+
+    // MODIFIES: refs
+    // EFFECTS: Appends where each block of path is, labelled with part,
+    //          reading only the block headers.  Returns false if path
+    //          cannot be read or is malformed.
+    bool index_blocks(const string &path, size_t part, vector<BlockRef> &refs)
+    {
+        ifstream file(path, ios::binary | ios::ate);
+        if (!file)
+        {
+            return false;
+        }
+        const uint64_t size = uint64_t(file.tellg());
+        string header(HEADER_SIZE, '\0');
+        if (size < HEADER_SIZE || !file.seekg(0) || !file.read(&header[0], HEADER_SIZE) ||
+            header != file_header())
+        {
+            return false;
+        }
+        unsigned char in[BLOCK_HEADER_SIZE];
+        for (uint64_t at = HEADER_SIZE; at < size;)
+        {
+            if (size - at < BLOCK_HEADER_SIZE ||
+                !file.read(reinterpret_cast<char *>(in), BLOCK_HEADER_SIZE))
+            {
+                return false;
+            }
+            const uint64_t payload = get_u64(in + 12);
+            if (payload > size - at - BLOCK_HEADER_SIZE)
+            {
+                return false;
+            }
+            BlockRef ref;
+            ref.first_deal = get_u64(in + 4);
+            ref.part = part;
+            ref.offset = at;
+            ref.size = BLOCK_HEADER_SIZE + payload;
+            refs.push_back(ref);
+            at += ref.size;
+            file.seekg(at);
+        }
+        return true;
+    }
+
+    // MODIFIES: rows
+    // EFFECTS: Appends the rows of block.  Returns false if it is malformed.
+    bool decode_block(const string &block, vector<DecisionRow> &rows)
+    {
+        const unsigned char *in = reinterpret_cast<const unsigned char *>(block.data());
+        const unsigned char *end = in + block.size();
+        const size_t count = get_u64(in, 4);
+        const uint64_t first_deal = get_u64(in + 4);
+        in += BLOCK_HEADER_SIZE;
+        vector<DecisionRow> decoded(count);
+        vector<uint32_t> words;
+        for (int column = 0; column < NUM_COLUMNS; column++)
+        {
+            if (!decode_column(in, end, count, words))
+            {
+                return false;
+            }
+            set_column(words, column, first_deal, decoded.data());
+        }
+        if (in != end)
+        {
+            return false;
+        }
+        rows.insert(rows.end(), decoded.begin(), decoded.end());
+        return true;
+    }
+}
+
+DecisionWriter::DecisionWriter(const std::string &path, int block_rows)
+    : file(path, ios::binary | ios::app), block_rows(block_rows), ok(bool(file)), rows(0),
+      bytes(0)
+{
+    assert(block_rows >= 1);
+    if (!ok)
+    {
+        return;
+    }
+    // an existing file must be a decision log; a new one gets a header
+    ifstream existing(path, ios::binary);
+    string header(HEADER_SIZE, '\0');
+    if (existing.read(&header[0], HEADER_SIZE))
+    {
+        ok = header == file_header();
+    }
+    else if (existing.gcount() == 0)
+    {
+        const string out = file_header();
+        ok = bool(file.write(out.data(), out.size()));
+    }
+    else
+    {
+        ok = false;
+    }
+    pending.reserve(std::min(block_rows, int(DEFAULT_BLOCK_ROWS)));
+}
+
+DecisionWriter::~DecisionWriter()
+{
+    flush();
+}
+
+bool DecisionWriter::is_open() const
+{
+    return ok;
+}
+
+void DecisionWriter::add(const DecisionRow &row)
+{
+    pending.push_back(row);
+    if (int(pending.size()) >= block_rows)
+    {
+        flush();
+    }
+}
+
+bool DecisionWriter::flush()
+{
+    if (pending.empty() || !ok)
+    {
+        pending.clear();
+        return ok;
+    }
+    string payload;
+    vector<uint32_t> words;
+    for (int column = 0; column < NUM_COLUMNS; column++)
+    {
+        column_words(pending, column, words);
+        encode_column(words, payload);
+    }
+    string out;
+    put_u64(out, pending.size(), 4);
+    put_u64(out, pending[0].deal);
+    put_u64(out, payload.size());
+    out += payload;
+    ok = bool(file.write(out.data(), out.size())) && bool(file.flush());
+    rows += long(pending.size());
+    bytes += long(out.size());
+    pending.clear();
+    return ok;
+}
+
+long DecisionWriter::get_rows() const
+{
+    return rows;
+}
+
+long DecisionWriter::get_bytes() const
+{
+    return bytes;
+}
+
+bool read_decisions(const std::string &path, std::vector<DecisionRow> &rows)
+{
+    vector<Block> blocks;
+    const bool read = read_blocks(path, blocks);
+    for (const Block &block : blocks)
+    {
+        if (!decode_block(block.bytes, rows))
+        {
+            return false;
+        }
+    }
+    return read;
+}
+
+bool merge_decision_logs(const std::vector<std::string> &parts, const std::string &path)
+{
+    // only the block headers are held; a day of self-play is far larger
+    // than memory
+    vector<BlockRef> refs;
+    for (size_t part = 0; part < parts.size(); part++)
+    {
+        if (!index_blocks(parts[part], part, refs))
+        {
+            return false;
+        }
+    }
+    stable_sort(refs.begin(), refs.end(), [](const BlockRef &a, const BlockRef &b) {
+        return a.first_deal < b.first_deal;
+    });
+
+    {
+        // checks path is a decision log, or starts one
+        DecisionWriter writer(path);
+        if (!writer.is_open())
+        {
+            return false;
+        }
+    }
+    vector<ifstream> inputs;
+    for (const string &part : parts)
+    {
+        inputs.emplace_back(part, ios::binary);
+    }
+    ofstream file(path, ios::binary | ios::app);
+    vector<char> buffer(COPY_BUFFER);
+    for (const BlockRef &ref : refs)
+    {
+        ifstream &input = inputs[ref.part];
+        input.seekg(ref.offset);
+        for (uint64_t left = ref.size; left > 0;)
+        {
+            const size_t n = size_t(std::min<uint64_t>(left, buffer.size()));
+            if (!input.read(buffer.data(), n) || !file.write(buffer.data(), n))
+            {
+                return false;
+            }
+            left -= n;
+        }
+    }
+    return bool(file.flush());
+}
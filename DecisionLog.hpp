@@ -0,0 +1,115 @@
+#ifndef DECISIONLOG_HPP
+#define DECISIONLOG_HPP
+/* DecisionLog.hpp
+ *
+ * An append-only columnar file of labelled decisions, for training the
+ * Learned models.  Each row is one option a player had at one decision:
+ * the features the Learned model would score it by, whether the player
+ * chose it, and the points the player's team won in the hand.
+ *
+ * Rows are written in blocks.  Each column of a block is compressed on
+ * its own: when it holds at most 256 distinct values they are stored
+ * once and every row becomes a bit-packed index, which suits the small
+ * integer and 0/1 features well; otherwise the column is stored raw.
+ * Writers only ever append whole blocks, so every thread can write its
+ * own file and merge_decision_logs can join them later without decoding.
+ *
+ * File layout, all integers little endian:
+ *   magic "EUDL", u32 version, u32 number of feature columns
+ *   then blocks: u32 rows, u64 deal of the first row, u64 payload bytes,
+ *   then the payload: each column as u8 codec and its data
+ *     codec 0, raw: rows u32 values
+ *     codec 1, dictionary: u16 count, count u32 values, u8 bits, then
+ *       the rows' indexes, bits each, packed from the low bit up
+ * Every value is a u32 word: features are their float bits and the deal
+ * is the difference from the row before.
+ */
+
+#include <array>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "Learned.hpp"
+
+enum DecisionKind : uint8_t
+{
+    BID_DECISION,       // option is the suit named
+    DISCARD_DECISION,   // option is the card thrown away
+    LEAD_DECISION,      // option is the card led
+    PLAY_DECISION,      // option is the card played to a led trick
+};
+
+struct DecisionRow
+{
+    uint64_t deal = 0;          // DealRecord index
+    uint8_t decision = 0;       // decisions made earlier in the deal
+    uint8_t seat = 0;           // player number, 0 deals
+    uint8_t kind = BID_DECISION;
+    uint8_t option = 0;         // suit or Card_to_index
+    uint8_t chosen = 0;         // 1 if the player took this option
+    int8_t points = 0;          // the seat's team's points in the hand,
+                                // negative for the opponents' points
+    std::array<float, LEARNED_INPUTS> features{};
+
+    bool operator==(const DecisionRow &other) const = default;
+};
+
+class DecisionWriter
+{
+public:
+    static const int DEFAULT_BLOCK_ROWS = 4096;
+
+    // REQUIRES: block_rows >= 1
+    // EFFECTS: Opens path for appending, writing the file header if it is
+    //          new or empty.  Check is_open() before use.
+    explicit DecisionWriter(const std::string &path,
+                            int block_rows = DEFAULT_BLOCK_ROWS);
+
+    // EFFECTS: Writes the rows still buffered
+    ~DecisionWriter();
+
+    DecisionWriter(const DecisionWriter &) = delete;
+    DecisionWriter & operator=(const DecisionWriter &) = delete;
+
+    // EFFECTS: returns false if path could not be opened, holds another
+    //          kind of file, or a write has failed
+    bool is_open() const;
+
+    // REQUIRES: row.deal differs from the previous row's by less than 2^31
+    // MODIFIES: this
+    // EFFECTS: Buffers row, writing a block once block_rows are buffered
+    void add(const DecisionRow &row);
+
+    // MODIFIES: this
+    // EFFECTS: Writes the buffered rows as one block.  Returns is_open().
+    bool flush();
+
+    // EFFECTS: returns the rows and bytes this writer has written
+    long get_rows() const;
+    long get_bytes() const;
+
+private:
+    std::ofstream file;
+    int block_rows;
+    bool ok;
+    std::vector<DecisionRow> pending;
+    long rows;
+    long bytes;
+};
+
+// MODIFIES: rows
+// EFFECTS: Appends every row in path to rows, in file order.  Returns
+//          false if path cannot be read or is malformed, keeping the rows
+//          of the blocks before the fault.
+bool read_decisions(const std::string &path, std::vector<DecisionRow> &rows);
+
+// EFFECTS: Appends the blocks of every file in parts to path, in order of
+//          their first deal, without decoding them.  Blocks with the same
+//          first deal keep the order of parts.  Only the block headers are
+//          kept in memory; blocks are copied through a small buffer.
+//          Returns false, writing nothing, if a part is unreadable or
+//          malformed.
+bool merge_decision_logs(const std::vector<std::string> &parts, const std::string &path);
+
+#endif // DECISIONLOG_HPP
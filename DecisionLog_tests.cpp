@@ -0,0 +1,202 @@
+#include "DecisionLog.hpp"
+#include "Random.hpp"
+#include "unit_test_framework.hpp"
+
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+
+using namespace std;
+
+// EFFECTS: returns count rows like self-play's, drawn from seed
+static vector<DecisionRow> random_rows(int count, uint64_t seed,
+                                       uint64_t first_deal = 0) {
+    Random random(seed);
+    vector<DecisionRow> rows(count);
+    uint64_t deal = first_deal;
+    for (int r = 0; r < count; r++) {
+        DecisionRow &row = rows[r];
+        deal += random.below(8) == 0;
+        row.deal = deal;
+        row.decision = uint8_t(random.below(30));
+        row.seat = uint8_t(random.below(4));
+        row.kind = uint8_t(random.below(4));
+        row.option = uint8_t(random.below(24));
+        row.chosen = uint8_t(random.below(2));
+        row.points = int8_t(int(random.below(5)) - 2);
+        for (int i = 0; i < LEARNED_INPUTS; i++) {
+            // small integers, one fraction column, one column of noise
+            row.features[i] = i == 0 ? float(random.uniform())
+                            : i == 1 ? random.below(24) / 23.0f
+                            : float(random.below(3));
+        }
+    }
+    return rows;
+}
+
+static long file_size(const string &path) {
+    ifstream file(path, ios::binary | ios::ate);
+    return long(file.tellg());
+}
+
+TEST(test_round_trip) {
+    const string path = "DecisionLog_tests_round_trip.bin";
+    remove(path.c_str());
+    const vector<DecisionRow> rows = random_rows(10000, 1, uint64_t(1) << 40);
+    {
+        DecisionWriter writer(path, 3000);
+        ASSERT_TRUE(writer.is_open());
+        for (const DecisionRow &row : rows) {
+            writer.add(row);
+        }
+    }
+    vector<DecisionRow> read;
+    ASSERT_TRUE(read_decisions(path, read));
+    ASSERT_TRUE(read == rows);
+    remove(path.c_str());
+}
+
+TEST(test_columns_compress) {
+    const string path = "DecisionLog_tests_compress.bin";
+    remove(path.c_str());
+    const vector<DecisionRow> rows = random_rows(4096, 2);
+    DecisionWriter writer(path);
+    for (const DecisionRow &row : rows) {
+        writer.add(row);
+    }
+    ASSERT_TRUE(writer.flush());
+    ASSERT_EQUAL(writer.get_rows(), 4096l);
+    ASSERT_EQUAL(file_size(path), 12 + writer.get_bytes());
+    // 23 columns of 4 bytes raw; only the noise column stays that size
+    const long raw = 4096l * 23 * 4;
+    ASSERT_TRUE(writer.get_bytes() * 4 < raw);
+    remove(path.c_str());
+}
+
+TEST(test_append_across_writers) {
+    const string path = "DecisionLog_tests_append.bin";
+    remove(path.c_str());
+    const vector<DecisionRow> rows = random_rows(500, 3);
+    for (int half = 0; half < 2; half++) {
+        DecisionWriter writer(path);
+        ASSERT_TRUE(writer.is_open());
+        for (int r = half * 250; r < (half + 1) * 250; r++) {
+            writer.add(rows[r]);
+        }
+    }
+    vector<DecisionRow> read;
+    ASSERT_TRUE(read_decisions(path, read));
+    ASSERT_TRUE(read == rows);
+    remove(path.c_str());
+}
+
+TEST(test_merge_orders_blocks_by_deal) {
+    const vector<string> parts = {"DecisionLog_tests_part0.bin",
+                                  "DecisionLog_tests_part1.bin"};
+    const string path = "DecisionLog_tests_merged.bin";
+    remove(path.c_str());
+    // four blocks of 100 deals each, alternating between the parts
+    vector<DecisionRow> rows;
+    for (int block = 0; block < 4; block++) {
+        const vector<DecisionRow> more = random_rows(300, 4 + block, 100 * block);
+        rows.insert(rows.end(), more.begin(), more.end());
+    }
+    for (const string &part : parts) {
+        remove(part.c_str());
+    }
+    {
+        DecisionWriter part0(parts[0]);
+        DecisionWriter part1(parts[1]);
+        for (int block = 3; block >= 0; block--) {
+            DecisionWriter &writer = block % 2 ? part1 : part0;
+            for (int r = 300 * block; r < 300 * (block + 1); r++) {
+                writer.add(rows[r]);
+            }
+            writer.flush();
+        }
+    }
+    ASSERT_TRUE(merge_decision_logs(parts, path));
+    vector<DecisionRow> read;
+    ASSERT_TRUE(read_decisions(path, read));
+    ASSERT_TRUE(read == rows);
+    for (const string &part : parts) {
+        remove(part.c_str());
+    }
+    remove(path.c_str());
+}
+
+TEST(test_merge_copies_blocks_larger_than_its_buffer) {
+    const vector<string> parts = {"DecisionLog_tests_part0.bin",
+                                  "DecisionLog_tests_part1.bin"};
+    const string path = "DecisionLog_tests_merged.bin";
+    remove(path.c_str());
+    for (const string &part : parts) {
+        remove(part.c_str());
+    }
+    // the noise column alone makes the first block hundreds of KB
+    const vector<DecisionRow> small = random_rows(300, 11);
+    const vector<DecisionRow> large = random_rows(50000, 12, small.back().deal + 1);
+    {
+        DecisionWriter part0(parts[0], int(large.size()));
+        for (const DecisionRow &row : large) {
+            part0.add(row);
+        }
+        DecisionWriter part1(parts[1]);
+        for (const DecisionRow &row : small) {
+            part1.add(row);
+        }
+    }
+    ASSERT_TRUE(file_size(parts[0]) > 200000);
+    ASSERT_TRUE(merge_decision_logs(parts, path));
+    vector<DecisionRow> read;
+    ASSERT_TRUE(read_decisions(path, read));
+    vector<DecisionRow> rows = small;
+    rows.insert(rows.end(), large.begin(), large.end());
+    ASSERT_TRUE(read == rows);
+    for (const string &part : parts) {
+        remove(part.c_str());
+    }
+    remove(path.c_str());
+}
+
+TEST(test_rejects_other_files) {
+    const string path = "DecisionLog_tests_other.bin";
+    {
+        ofstream file(path, ios::binary | ios::trunc);
+        file << "not a decision log";
+    }
+    DecisionWriter writer(path);
+    ASSERT_FALSE(writer.is_open());
+    vector<DecisionRow> read;
+    ASSERT_FALSE(read_decisions(path, read));
+    ASSERT_FALSE(read_decisions("no_such_decision_log.bin", read));
+    ASSERT_FALSE(merge_decision_logs({path}, "DecisionLog_tests_unused.bin"));
+    ASSERT_FALSE(ifstream("DecisionLog_tests_unused.bin").good());
+    remove(path.c_str());
+}
+
+TEST(test_truncated_file_keeps_whole_blocks) {
+    const string path = "DecisionLog_tests_truncated.bin";
+    remove(path.c_str());
+    const vector<DecisionRow> rows = random_rows(200, 5);
+    {
+        DecisionWriter writer(path, 100);
+        for (const DecisionRow &row : rows) {
+            writer.add(row);
+        }
+    }
+    ifstream file(path, ios::binary);
+    string data((istreambuf_iterator<char>(file)), istreambuf_iterator<char>());
+    file.close();
+    {
+        ofstream out(path, ios::binary | ios::trunc);
+        out.write(data.data(), data.size() - 10);
+    }
+    vector<DecisionRow> read;
+    ASSERT_FALSE(read_decisions(path, read));
+    ASSERT_EQUAL(read.size(), size_t(100));
+    ASSERT_TRUE(equal(read.begin(), read.end(), rows.begin()));
+    remove(path.c_str());
+}
+
+TEST_MAIN()
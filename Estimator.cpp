@@ -0,0 +1,248 @@
+#include "Estimator.hpp"
+#include "CardTracker.hpp"
+#include "DealSampler.hpp"
+#include "GameState.hpp"
+#include "Hand.hpp"
+#include "Player.hpp"
+#include "Random.hpp"
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <memory>
+
+using namespace std;
+
+namespace
+{
+    const int NUM_PLAYERS = GameState::num_players;
+    const int CHUNK_SAMPLES = 32;
+    const int CHUNKS_PER_ROUND = 8;
+
+    // Everything the seat can work out about the hidden cards
+    struct Knowledge
+    {
+        std::array<uint32_t, NUM_PLAYERS> known{};      // held now, and seen
+        DealConstraints constraints;
+    };
+
+    Knowledge analyze(const HandView &view)
+    {
+        // replay the hand's public events
+        CardTracker tracker;
+        PlayerEvent event{PlayerEvent::HAND_STARTED};
+        event.player = view.dealer;
+        event.card = view.upcard;
+        tracker.observe(event);
+
+        event = PlayerEvent{PlayerEvent::ORDERED_UP};
+        event.player = view.maker;
+        event.trump = view.trump;
+        event.round = view.upcard_taken ? 1 : 2;
+        tracker.observe(event);
+        if (view.upcard_taken && view.seat == view.dealer)
+        {
+            // only the dealer saw what it threw away
+            tracker.observe_discard(view.discard);
+        }
+
+        for (const Card &card : view.played)
+        {
+            event = PlayerEvent{PlayerEvent::CARD_PLAYED};
+            event.player = tracker.to_move();
+            event.card = card;
+            tracker.observe(event);
+        }
+
+        Knowledge knowledge;
+        const uint32_t hand = GameState::mask_of(view.hand);
+        for (int player = 0; player < NUM_PLAYERS; player++)
+        {
+            knowledge.known[player] = player == view.seat ? hand : tracker.known(player);
+        }
+        knowledge.constraints = tracker.constraints(view.seat, hand);
+        return knowledge;
+    }
+
+    // Sums over a set of rollouts
+    struct Tally
+    {
+        long samples = 0;
+        long points = 0;
+        long points_squared = 0;
+        long tricks = 0;
+        std::array<long, 6> trick_counts{};
+        std::array<long, 5> point_counts{};
+
+        void add(const Tally &other)
+        {
+            samples += other.samples;
+            points += other.points;
+            points_squared += other.points_squared;
+            tricks += other.tricks;
+            for (size_t i = 0; i < trick_counts.size(); i++)
+            {
+                trick_counts[i] += other.trick_counts[i];
+            }
+            for (size_t i = 0; i < point_counts.size(); i++)
+            {
+                point_counts[i] += other.point_counts[i];
+            }
+        }
+    };
+
+    // MODIFIES: hand
+    // EFFECTS: bids the way view says the hand went: every seat before the
+    //          maker passed, in both rounds if trump was made in round two
+    void replay_bidding(const HandView &view, Hand &hand)
+    {
+        const int round = view.upcard_taken ? 1 : 2;
+        while (hand.get_round() < round || hand.to_act() != view.maker)
+        {
+            hand.bid(false, view.upcard.get_suit());
+        }
+        hand.bid(true, view.trump);
+        if (view.upcard_taken)
+        {
+            hand.discard();
+        }
+    }
+
+    // MODIFIES: players, tally
+    // EFFECTS: plays out one rollout with the hidden cards dealt from seed.
+    //          The players see every event of the hand, as they do in Game.
+    void rollout(const HandView &view, const Knowledge &knowledge, const DealSampler &sampler,
+                 uint64_t seed, const std::vector<std::unique_ptr<Player>> &players,
+                 Tally &tally)
+    {
+        Random random(seed);
+        const std::array<uint32_t, NUM_PLAYERS> hidden = sampler.sample(random);
+        for (int player = 0; player < NUM_PLAYERS; player++)
+        {
+            const uint32_t held = knowledge.known[player] | hidden[player];
+            for (uint32_t cards = held; cards; cards &= cards - 1)
+            {
+                players[player]->add_card(Card_from_index(__builtin_ctz(cards)));
+            }
+        }
+
+        Hand hand([&players](const PlayerEvent &event) {
+            for (const std::unique_ptr<Player> &player : players)
+            {
+                player->observe(event);
+            }
+        });
+        hand.start(view.dealer, view.upcard);
+        replay_bidding(view, hand);
+        for (const Card &card : view.played)
+        {
+            hand.play(card);
+        }
+        while (hand.get_phase() != Hand::OVER)
+        {
+            Player &player = *players[hand.to_act()];
+            if (hand.get_num_in_trick() == 0)
+            {
+                hand.play(player.lead_card(view.trump));
+            }
+            else
+            {
+                hand.play(player.play_card(hand.get_led_card(), view.trump));
+            }
+        }
+
+        const int team = view.seat % 2;
+        int winners;
+        const int won = hand.get_points(winners);
+        const int points = winners == team ? won : -won;
+        const int tricks = hand.get_tricks(team);
+        tally.samples++;
+        tally.points += points;
+        tally.points_squared += points * points;
+        tally.tricks += tricks;
+        tally.trick_counts[tricks]++;
+        tally.point_counts[points + 2]++;
+    }
+
+    double half_width(const Tally &tally, double z)
+    {
+        const double n = double(tally.samples);
+        const double mean = tally.points / n;
+        const double variance = std::max(0.0, (tally.points_squared / n - mean * mean) *
+                                                  n / std::max(1.0, n - 1));
+        return z * std::sqrt(variance / n);
+    }
+}
+
+HandEstimate estimate_hand(const HandView &view, const EstimateOptions &options,
+                           ThreadPool &pool)
+{
+    const Knowledge knowledge = analyze(view);
+    const DealSampler sampler(knowledge.constraints);
+    assert(sampler.count() > 0);
+    const auto start_time = chrono::steady_clock::now();
+
+    // each worker keeps its own players; their hands are empty again at
+    // the end of every rollout
+    std::vector<std::vector<std::unique_ptr<Player>>> players(pool.size());
+    for (auto &seats : players)
+    {
+        for (int player = 0; player < NUM_PLAYERS; player++)
+        {
+            seats.emplace_back(Player_factory("Player " + to_string(player),
+                                              options.strategies[player]));
+        }
+    }
+
+    // rounds are a fixed size and split into fixed chunks, so the totals
+    // do not depend on how chunks land on workers
+    Tally total;
+    HandEstimate estimate;
+    while (total.samples < options.max_samples)
+    {
+        std::vector<Tally> chunks(CHUNKS_PER_ROUND);
+        const long round_start = total.samples;
+        pool.parallel_for(CHUNKS_PER_ROUND, [&](int worker, int chunk) {
+            for (int i = 0; i < CHUNK_SAMPLES; i++)
+            {
+                const long sample = round_start + long(chunk) * CHUNK_SAMPLES + i;
+                if (sample < options.max_samples)
+                {
+                    rollout(view, knowledge, sampler, derive_seed(options.seed, sample),
+                            players[worker], chunks[chunk]);
+                }
+            }
+        });
+        for (const Tally &chunk : chunks)
+        {
+            total.add(chunk);
+        }
+
+        if (total.samples >= options.min_samples &&
+            half_width(total, options.z) <= options.target_half_width)
+        {
+            estimate.converged = true;
+            break;
+        }
+        const chrono::duration<double> elapsed = chrono::steady_clock::now() - start_time;
+        if (options.time_budget > 0 && elapsed.count() >= options.time_budget)
+        {
+            break;
+        }
+    }
+
+    const double n = double(total.samples);
+    estimate.samples = total.samples;
+    estimate.mean_points = total.points / n;
+    estimate.half_width = half_width(total, options.z);
+    estimate.mean_tricks = total.tricks / n;
+    for (size_t i = 0; i < estimate.tricks.size(); i++)
+    {
+        estimate.tricks[i] = total.trick_counts[i] / n;
+    }
+    for (size_t i = 0; i < estimate.points.size(); i++)
+    {
+        estimate.points[i] = total.point_counts[i] / n;
+    }
+    return estimate;
+}
@@ -0,0 +1,67 @@
+#ifndef ESTIMATOR_HPP
+#define ESTIMATOR_HPP
+/* Estimator.hpp
+ *
+ * Monte Carlo estimate of how a hand will turn out, from one seat's point
+ * of view.  Each rollout deals the cards the seat cannot see in a way that
+ * agrees with what it has seen, then plays the rest of the hand out with
+ * the chosen strategies.  Rollouts run in rounds across a ThreadPool until
+ * the confidence interval on the expected points is narrow enough, a
+ * sample cap is hit, or a time budget runs out.
+ */
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Card.hpp"
+#include "ThreadPool.hpp"
+
+// What one seat knows once trump is made
+struct HandView
+{
+    int seat = 0;
+    int dealer = 0;
+    std::vector<Card> hand;       // cards the seat holds now
+    Card upcard;
+    bool upcard_taken = false;    // ordered up in round one, so the dealer
+                                  // picked it up
+    Card discard;                 // when the seat is that dealer, the card
+                                  // it put down; ignored otherwise
+    Suit trump = SPADES;
+    int maker = 0;                // seat that made trump
+    std::vector<Card> played;     // this hand's cards so far, in play order
+};
+
+struct EstimateOptions
+{
+    std::array<std::string, 4> strategies = {"Simple", "Simple", "Simple", "Simple"};
+    double target_half_width = 0.05;  // of the interval on expected points
+    double z = 1.96;                  // normal quantile of the interval
+    long min_samples = 256;
+    long max_samples = 1 << 20;
+    double time_budget = 0;           // seconds, or 0 for no limit
+    uint64_t seed = 0;
+};
+
+struct HandEstimate
+{
+    long samples = 0;
+    double mean_points = 0;           // for the seat's team; negative when
+                                      // the other team scores
+    double half_width = 0;
+    double mean_tricks = 0;           // taken by the seat's team
+    std::array<double, 6> tricks{};   // probability of 0 to 5 tricks
+    std::array<double, 5> points{};   // probability of -2 to 2 points
+    bool converged = false;           // stopped because the target was met
+};
+
+// REQUIRES: view is a position reachable in a real hand, every strategy is
+//           a non-interactive Player_factory strategy
+// EFFECTS: Estimates the outcome of the hand for view.seat's team.  With no
+//          time budget the result depends only on view and options, not
+//          on the number of threads in pool.
+HandEstimate estimate_hand(const HandView &view, const EstimateOptions &options,
+                           ThreadPool &pool);
+
+#endif // ESTIMATOR_HPP
@@ -0,0 +1,167 @@
+#include "Estimator.hpp"
+#include "Player.hpp"
+#include "unit_test_framework.hpp"
+#include <atomic>
+#include <memory>
+
+using namespace std;
+
+// How many events of each type the Recording players have seen
+static array<atomic<long>, PlayerEvent::TRICK_WON + 1> seen_events;
+
+// A Simple player that counts the events it is shown
+class Recording : public Player {
+public:
+    explicit Recording(const string &name) : simple(Player_factory(name, "Simple")) {}
+
+    const string & get_name() const override { return simple->get_name(); }
+    void add_card(const Card &c) override { simple->add_card(c); }
+    bool make_trump(const Card &upcard, bool is_dealer, int round,
+                    Suit &order_up_suit) const override {
+        return simple->make_trump(upcard, is_dealer, round, order_up_suit);
+    }
+    void add_and_discard(const Card &upcard) override { simple->add_and_discard(upcard); }
+    Card lead_card(Suit trump) override { return simple->lead_card(trump); }
+    Card play_card(const Card &led_card, Suit trump) override {
+        return simple->play_card(led_card, trump);
+    }
+    void observe(const PlayerEvent &event) override { seen_events[event.type]++; }
+
+private:
+    unique_ptr<Player> simple;
+};
+
+static Player * make_recording(const string &name) {
+    return new Recording(name);
+}
+
+static const bool registered = Player_register("Recording", make_recording, true);
+
+TEST(test_estimate_certain_march) {
+    // the top five trumps, led from the seat left of the dealer
+    HandView view;
+    view.seat = 1;
+    view.dealer = 0;
+    view.hand = {Card(JACK, HEARTS), Card(JACK, DIAMONDS), Card(ACE, HEARTS),
+                 Card(KING, HEARTS), Card(QUEEN, HEARTS)};
+    view.upcard = Card(NINE, CLUBS);
+    view.trump = HEARTS;
+    view.maker = 1;
+
+    ThreadPool pool(2);
+    EstimateOptions options;
+    HandEstimate estimate = estimate_hand(view, options, pool);
+    ASSERT_TRUE(estimate.converged);
+    ASSERT_EQUAL(estimate.samples, options.min_samples);
+    ASSERT_EQUAL(estimate.mean_points, 2.0);
+    ASSERT_EQUAL(estimate.tricks[5], 1.0);
+    ASSERT_EQUAL(estimate.half_width, 0.0);
+}
+
+TEST(test_estimate_mid_hand_is_reproducible) {
+    // dealer is seat 3 and picked up the Nine of Spades; seat 0 led a trick
+    // and seat 2 failed to follow, so seat 2 holds no hearts
+    HandView view;
+    view.seat = 0;
+    view.dealer = 3;
+    view.hand = {Card(TEN, SPADES), Card(ACE, CLUBS), Card(KING, DIAMONDS), Card(NINE, DIAMONDS)};
+    view.upcard = Card(NINE, SPADES);
+    view.upcard_taken = true;
+    view.trump = SPADES;
+    view.maker = 1;
+    view.played = {Card(ACE, HEARTS), Card(NINE, HEARTS), Card(JACK, CLUBS), Card(TEN, HEARTS),
+                   Card(QUEEN, SPADES)};
+
+    EstimateOptions options;
+    options.target_half_width = 0;
+    options.max_samples = 2000;
+    ThreadPool one(1);
+    ThreadPool three(3);
+    HandEstimate a = estimate_hand(view, options, one);
+    HandEstimate b = estimate_hand(view, options, three);
+    ASSERT_FALSE(a.converged);
+    ASSERT_EQUAL(a.samples, 2000);
+    ASSERT_EQUAL(a.mean_points, b.mean_points);
+    ASSERT_EQUAL(a.mean_tricks, b.mean_tricks);
+    ASSERT_TRUE(a.mean_tricks >= 0 && a.mean_tricks <= 4);
+
+    double total = 0;
+    for (double p : a.points) {
+        total += p;
+    }
+    ASSERT_ALMOST_EQUAL(total, 1.0, 1e-9);
+    ASSERT_EQUAL(a.points[2], 0.0);
+}
+
+TEST(test_estimate_rollout_players_see_the_whole_hand) {
+    // seat 0 passed and seat 1 ordered up; the first trick is half played
+    HandView view;
+    view.seat = 0;
+    view.dealer = 3;
+    view.hand = {Card(TEN, SPADES), Card(ACE, CLUBS), Card(KING, DIAMONDS),
+                 Card(NINE, DIAMONDS)};
+    view.upcard = Card(NINE, SPADES);
+    view.upcard_taken = true;
+    view.trump = SPADES;
+    view.maker = 1;
+    view.played = {Card(ACE, HEARTS), Card(NINE, HEARTS)};
+
+    EstimateOptions options;
+    options.strategies = {"Recording", "Recording", "Recording", "Recording"};
+    options.target_half_width = 0;
+    options.max_samples = 64;
+    ThreadPool pool(2);
+    estimate_hand(view, options, pool);
+
+    // every player sees every event of every rollout
+    const long per_event = 64 * 4;
+    ASSERT_EQUAL(seen_events[PlayerEvent::HAND_STARTED], per_event);
+    ASSERT_EQUAL(seen_events[PlayerEvent::PASSED], per_event);
+    ASSERT_EQUAL(seen_events[PlayerEvent::ORDERED_UP], per_event);
+    ASSERT_EQUAL(seen_events[PlayerEvent::CARD_PLAYED], 20 * per_event);
+    ASSERT_EQUAL(seen_events[PlayerEvent::TRICK_WON], 5 * per_event);
+}
+
+TEST(test_estimate_stops_early) {
+    HandView view;
+    view.seat = 2;
+    view.dealer = 2;
+    view.hand = {Card(JACK, CLUBS), Card(NINE, CLUBS), Card(ACE, HEARTS), Card(TEN, DIAMONDS),
+                 Card(KING, SPADES)};
+    view.upcard = Card(NINE, CLUBS);
+    view.upcard_taken = true;
+    view.discard = Card(NINE, HEARTS);
+    view.trump = CLUBS;
+    view.maker = 2;
+
+    EstimateOptions options;
+    options.target_half_width = 0.2;
+    ThreadPool pool(2);
+    HandEstimate estimate = estimate_hand(view, options, pool);
+    ASSERT_TRUE(estimate.converged);
+    ASSERT_TRUE(estimate.half_width <= 0.2);
+    ASSERT_TRUE(estimate.samples < options.max_samples);
+}
+
+TEST(test_estimate_dealer_discard_stays_out) {
+    // the dealer threw away the right bower and holds every other trump
+    // but the nine, so no one else can take a trick
+    HandView view;
+    view.seat = 0;
+    view.dealer = 0;
+    view.hand = {Card(JACK, DIAMONDS), Card(ACE, HEARTS), Card(KING, HEARTS),
+                 Card(QUEEN, HEARTS), Card(TEN, HEARTS)};
+    view.upcard = Card(TEN, HEARTS);
+    view.upcard_taken = true;
+    view.discard = Card(JACK, HEARTS);
+    view.trump = HEARTS;
+    view.maker = 0;
+
+    ThreadPool pool(2);
+    EstimateOptions options;
+    HandEstimate estimate = estimate_hand(view, options, pool);
+    ASSERT_EQUAL(estimate.tricks[5], 1.0);
+    ASSERT_EQUAL(estimate.mean_points, 2.0);
+}
+
+TEST_MAIN()
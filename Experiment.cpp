@@ -0,0 +1,473 @@
+#include "Experiment.hpp"
+#include "Game.hpp"
+#include "HandIndex.hpp"
+#include "Random.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <memory>
+#include <sstream>
+
+using namespace std;
+
+namespace
+{
+    const int DEAL_CARDS = 20;
+    const int TEAM_CARDS = 10;
+    const int MAX_SCAN_FACTOR = 100;
+    const size_t EXPERIMENT_CACHE_SIZE = size_t(1) << 22;
+
+    // seat that receives each card of a pack dealt by player 0
+    constexpr std::array<int, DEAL_CARDS> make_seats()
+    {
+        std::array<int, DEAL_CARDS> seats{};
+        const int pattern[8] = {3, 2, 3, 2, 2, 3, 2, 3};
+        int position = 0;
+        int seat = 1;
+        for (int count : pattern)
+        {
+            for (int i = 0; i < count; i++)
+            {
+                seats[position++] = seat;
+            }
+            seat = (seat + 1) % 4;
+        }
+        return seats;
+    }
+
+    constexpr std::array<int, DEAL_CARDS> SEAT_OF_CARD = make_seats();
+
+    double choose(int n, int k)
+    {
+        if (k < 0 || n < 0 || k > n)
+        {
+            return 0;
+        }
+        double result = 1;
+        for (int i = 1; i <= k; i++)
+        {
+            result = result * (n - k + i) / i;
+        }
+        return result;
+    }
+
+    // Per-deal results of both arms, points summed over both seatings
+    struct Outcome
+    {
+        int stratum = 0;
+        int candidate = 0;
+        int baseline = 0;
+    };
+
+    // Sums over deals
+    struct Moments
+    {
+        long n = 0;
+        double sum[3] = {0, 0, 0};       // candidate, baseline, difference
+        double sum_sq[3] = {0, 0, 0};
+
+        void add(const Outcome &outcome)
+        {
+            const double values[3] = {double(outcome.candidate), double(outcome.baseline),
+                                      double(outcome.candidate - outcome.baseline)};
+            n++;
+            for (int i = 0; i < 3; i++)
+            {
+                sum[i] += values[i];
+                sum_sq[i] += values[i] * values[i];
+            }
+        }
+
+        double mean(int i) const
+        {
+            return sum[i] / n;
+        }
+
+        // EFFECTS: returns the sample variance, or -1 with under two deals
+        double variance(int i) const
+        {
+            if (n < 2)
+            {
+                return -1;
+            }
+            return std::max(0.0, (sum_sq[i] - sum[i] * sum[i] / n) / (n - 1));
+        }
+    };
+
+    // EFFECTS: returns the seeds of the deals to play
+    std::vector<uint64_t> choose_deals(const ExperimentOptions &options)
+    {
+        std::vector<uint64_t> seeds;
+        if (!options.stratify)
+        {
+            for (long i = 0; i < options.deals; i++)
+            {
+                seeds.push_back(derive_seed(options.seed, i));
+            }
+            return seeds;
+        }
+
+        // proportional allocation, rounded by largest remainder
+        const std::array<double, NUM_STRATA> &probabilities = stratum_probabilities();
+        std::array<long, NUM_STRATA> quota{};
+        std::vector<std::pair<double, int>> remainders;
+        long allocated = 0;
+        for (int h = 0; h < NUM_STRATA; h++)
+        {
+            const double share = probabilities[h] * options.deals;
+            quota[h] = long(share);
+            allocated += quota[h];
+            remainders.push_back({-(share - quota[h]), h});
+        }
+        std::sort(remainders.begin(), remainders.end());
+        for (long i = 0; allocated + i < options.deals; i++)
+        {
+            quota[remainders[i].second]++;
+        }
+
+        // fill each stratum's quota from one seeded stream of deals
+        long wanted = options.deals;
+        for (long k = 0; wanted > 0 && k < MAX_SCAN_FACTOR * (options.deals + NUM_STRATA); k++)
+        {
+            const uint64_t seed = derive_seed(options.seed, k);
+            Pack pack;
+            pack.shuffle(seed);
+            const int h = deal_stratum(pack);
+            if (quota[h] > 0)
+            {
+                quota[h]--;
+                wanted--;
+                seeds.push_back(seed);
+            }
+        }
+        return seeds;
+    }
+
+    // One Game per arm and seating, reused for every deal a worker plays
+    struct Tables
+    {
+        ostream quiet{nullptr};
+        // [arm][seating]: arm 0 is the candidate; seating 1 puts the arm's
+        // team on the non-dealing side
+        std::unique_ptr<Game> games[2][2];
+
+        explicit Tables(const ExperimentOptions &options)
+        {
+            istringstream no_pack;
+            for (int arm = 0; arm < 2; arm++)
+            {
+                for (int seating = 0; seating < 2; seating++)
+                {
+                    games[arm][seating].reset(new Game(no_pack, false, 1, names(),
+                                                       strategies(options, arm, seating),
+                                                       quiet));
+                }
+            }
+        }
+
+        static std::array<std::string, Game::num_players> names()
+        {
+            return {"Player 0", "Player 1", "Player 2", "Player 3"};
+        }
+
+        static std::array<std::string, Game::num_players>
+        strategies(const ExperimentOptions &options, int arm, int seating)
+        {
+            const std::string &tested = arm == 0 ? options.candidate : options.baseline;
+            std::array<std::string, Game::num_players> seats;
+            for (int seat = 0; seat < Game::num_players; seat++)
+            {
+                seats[seat] = seat % 2 == seating ? tested : options.opponent;
+            }
+            return seats;
+        }
+
+        // MODIFIES: cache
+        // EFFECTS: returns the arm's points minus the opponents' over both
+        //          seatings of the deal in pack, looking each seating up in
+        //          cache first if there is one
+        int play(const ExperimentOptions &options, int arm, const Pack &pack,
+                 uint64_t deal_rank, OutcomeCache *cache)
+        {
+            int total = 0;
+            for (int seating = 0; seating < 2; seating++)
+            {
+                const std::array<std::string, Game::num_players> seats =
+                    strategies(options, arm, seating);
+                OutcomeKey key;
+                key.deal = deal_rank;
+                key.strategies = strategy_set_hash(seats);
+                HandOutcome outcome;
+                if (!cache || !cache->lookup(key, outcome))
+                {
+                    Game &game = *games[arm][seating];
+                    game.reset(pack, false, 1, names(), seats);
+                    game.play_next_hand();
+                    for (int team = 0; team < Game::num_teams; team++)
+                    {
+                        outcome.tricks[team] = uint8_t(game.get_hand_tricks(Team_Number(team)));
+                        outcome.points[team] = int8_t(game.get_points(Team_Number(team)));
+                    }
+                    if (cache)
+                    {
+                        cache->insert(key, outcome);
+                    }
+                }
+                total += outcome.points[seating] - outcome.points[1 - seating];
+            }
+            return total;
+        }
+    };
+}
+
+uint64_t deal_rank(const Pack &pack)
+{
+    const std::array<Card, Pack::PACK_SIZE> &cards = pack.get_cards();
+    std::array<uint32_t, Game::num_players> hands{};
+    for (int i = 0; i < DEAL_CARDS; i++)
+    {
+        hands[SEAT_OF_CARD[i]] |= uint32_t(1) << Card_to_index(cards[i]);
+    }
+    return rank_deal(hands, Card_to_index(cards[DEAL_CARDS]));
+}
+
+int deal_stratum(const Pack &pack)
+{
+    const std::array<Card, Pack::PACK_SIZE> &cards = pack.get_cards();
+    const Card upcard = cards[DEAL_CARDS];
+    const Suit suit = upcard.get_suit();
+    int bowers[2] = {0, 0};
+    for (int i = 0; i < DEAL_CARDS; i++)
+    {
+        const Card &card = cards[i];
+        if (card.get_rank() == JACK && (card.get_suit() == suit || card.get_suit() == Suit_next(suit)))
+        {
+            bowers[SEAT_OF_CARD[i] % 2]++;
+        }
+    }
+    return (Card_to_index(upcard) * 3 + bowers[0]) * 3 + bowers[1];
+}
+
+const std::array<double, NUM_STRATA> & stratum_probabilities()
+{
+    static const std::array<double, NUM_STRATA> probabilities = [] {
+        std::array<double, NUM_STRATA> result{};
+        const int rest = Pack::PACK_SIZE - 1;
+        const double deals = choose(rest, TEAM_CARDS) * choose(rest - TEAM_CARDS, TEAM_CARDS);
+        for (int upcard = 0; upcard < Pack::PACK_SIZE; upcard++)
+        {
+            // a Jack turned up is one of its own suit's bowers
+            const int jacks = Card_from_index(upcard).get_rank() == JACK ? 1 : 2;
+            for (int b0 = 0; b0 <= 2; b0++)
+            {
+                for (int b1 = 0; b0 + b1 <= jacks; b1++)
+                {
+                    const double ways = choose(jacks, b0) * choose(rest - jacks, TEAM_CARDS - b0) *
+                                        choose(jacks - b0, b1) *
+                                        choose(rest - TEAM_CARDS - (jacks - b0), TEAM_CARDS - b1);
+                    result[(upcard * 3 + b0) * 3 + b1] = ways / deals / Pack::PACK_SIZE;
+                }
+            }
+        }
+        return result;
+    }();
+    return probabilities;
+}
+
+ExperimentResult run_experiment(const ExperimentOptions &options, ThreadPool &pool,
+                                OutcomeCache *cache)
+{
+    const std::vector<uint64_t> seeds = choose_deals(options);
+    std::vector<Outcome> outcomes(seeds.size());
+    std::vector<std::unique_ptr<Tables>> tables(pool.size());
+    for (auto &worker_tables : tables)
+    {
+        worker_tables.reset(new Tables(options));
+    }
+
+    pool.parallel_for(int(seeds.size()), [&](int worker, int i) {
+        Pack pack;
+        pack.shuffle(seeds[i]);
+        Outcome &outcome = outcomes[i];
+        outcome.stratum = deal_stratum(pack);
+        const uint64_t rank = deal_rank(pack);
+        outcome.candidate = tables[worker]->play(options, 0, pack, rank, cache);
+        outcome.baseline = tables[worker]->play(options, 1, pack, rank, cache);
+    });
+
+    // tally in deal order so results are the same for any thread count
+    ExperimentResult result;
+    Moments overall;
+    std::vector<Moments> strata(NUM_STRATA);
+    for (const Outcome &outcome : outcomes)
+    {
+        overall.add(outcome);
+        strata[outcome.stratum].add(outcome);
+    }
+    result.deals = overall.n;
+    if (overall.n == 0)
+    {
+        return result;
+    }
+
+    double means[3] = {overall.mean(0), overall.mean(1), overall.mean(2)};
+    double mean_variance[3];
+    for (int i = 0; i < 3; i++)
+    {
+        mean_variance[i] = std::max(0.0, overall.variance(i)) / overall.n;
+    }
+
+    if (options.stratify)
+    {
+        // weight each sampled stratum by its exact probability
+        const std::array<double, NUM_STRATA> &probabilities = stratum_probabilities();
+        double covered = 0;
+        for (int h = 0; h < NUM_STRATA; h++)
+        {
+            if (strata[h].n > 0)
+            {
+                covered += probabilities[h];
+                result.strata++;
+            }
+        }
+        for (int i = 0; i < 3; i++)
+        {
+            means[i] = 0;
+            mean_variance[i] = 0;
+            for (int h = 0; h < NUM_STRATA; h++)
+            {
+                const Moments &stratum = strata[h];
+                if (stratum.n == 0)
+                {
+                    continue;
+                }
+                const double weight = probabilities[h] / covered;
+                // a stratum with a single deal borrows the overall variance
+                double variance = stratum.variance(i);
+                if (variance < 0)
+                {
+                    variance = std::max(0.0, overall.variance(i));
+                }
+                means[i] += weight * stratum.mean(i);
+                mean_variance[i] += weight * weight * variance / stratum.n;
+            }
+        }
+    }
+
+    result.mean_candidate = means[0];
+    result.mean_baseline = means[1];
+    result.mean_difference = means[2];
+    result.half_width = options.z * std::sqrt(mean_variance[2]);
+    result.unpaired_half_width = options.z * std::sqrt(mean_variance[0] + mean_variance[1]);
+    return result;
+}
+
+void print_experiment(const ExperimentOptions &options, const ExperimentResult &result,
+                      std::ostream &os)
+{
+    os << "Candidate " << options.candidate << " vs baseline " << options.baseline
+       << ", opponent " << options.opponent << ", " << result.deals << " deals";
+    if (options.stratify)
+    {
+        os << " in " << result.strata << " strata";
+    }
+    os << std::endl;
+    os << std::fixed << std::setprecision(4);
+    os << "Candidate:  " << result.mean_candidate << " points per deal" << std::endl;
+    os << "Baseline:   " << result.mean_baseline << " points per deal" << std::endl;
+    os << "Difference: " << std::showpos << result.mean_difference << std::noshowpos << " +/- "
+       << result.half_width << " (unpaired +/- " << result.unpaired_half_width << ")"
+       << std::endl;
+    os.unsetf(std::ios::floatfield);
+}
+
+static void print_experiment_usage()
+{
+    cout << "Usage: euchre.exe --experiment CANDIDATE BASELINE DEALS THREADS "
+         << "[--opponent STRATEGY] [--stratify] [--seed N] [--cache FILE]" << endl;
+}
+
+int experiment_main(int argc, char **argv)
+{
+    if (argc < 6)
+    {
+        print_experiment_usage();
+        return 1;
+    }
+    ExperimentOptions options;
+    options.candidate = argv[2];
+    options.baseline = argv[3];
+    options.deals = atol(argv[4]);
+    const int threads = atoi(argv[5]);
+    string cache_path;
+    for (int i = 6; i < argc; i++)
+    {
+        const string option = argv[i];
+        if (option == "--opponent" && i + 1 < argc)
+        {
+            options.opponent = argv[++i];
+        }
+        else if (option == "--stratify")
+        {
+            options.stratify = true;
+        }
+        else if (option == "--seed" && i + 1 < argc)
+        {
+            options.seed = strtoull(argv[++i], nullptr, 10);
+        }
+        else if (option == "--cache" && i + 1 < argc)
+        {
+            cache_path = argv[++i];
+        }
+        else
+        {
+            print_experiment_usage();
+            return 1;
+        }
+    }
+    if (options.deals < 1 || threads < 0)
+    {
+        print_experiment_usage();
+        return 2;
+    }
+    for (const string &strategy : {options.candidate, options.baseline, options.opponent})
+    {
+        if (!Player_strategy_exists(strategy) || Player_strategy_is_interactive(strategy))
+        {
+            cout << "Unknown or interactive strategy " << strategy << endl;
+            return 3;
+        }
+    }
+
+    // hands only repeat exactly when every strategy is deterministic
+    std::unique_ptr<OutcomeCache> cache;
+    bool deterministic = true;
+    for (const string &strategy : {options.candidate, options.baseline, options.opponent})
+    {
+        deterministic = deterministic && Player_strategy_is_deterministic(strategy);
+    }
+    if (deterministic)
+    {
+        cache.reset(new OutcomeCache(EXPERIMENT_CACHE_SIZE));
+        if (!cache_path.empty() && !cache->load(cache_path))
+        {
+            cout << "Starting a new outcome cache at " << cache_path << endl;
+        }
+    }
+
+    ThreadPool pool(threads == 0 ? default_thread_count() : threads);
+    print_experiment(options, run_experiment(options, pool, cache.get()), cout);
+    if (cache)
+    {
+        cout << "Outcome cache: " << cache->hits() << " hits, " << cache->misses()
+             << " misses, " << cache->size() << " entries" << endl;
+        if (!cache_path.empty() && !cache->save(cache_path))
+        {
+            cout << "Could not save the outcome cache to " << cache_path << endl;
+            return 4;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,80 @@
+#ifndef EXPERIMENT_HPP
+#define EXPERIMENT_HPP
+/* Experiment.hpp
+ *
+ * Paired A/B comparison of two strategies.  Both arms play exactly the
+ * same seeded deals against the same opponents, once from each side of
+ * the dealer, so the luck of the deal cancels out of the per-deal
+ * difference.  Deals can also be stratified by the upcard and by how the
+ * two jacks of the upcard's color are split between the teams, with each
+ * stratum given its exact share of the sample.
+ */
+
+#include <array>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "OutcomeCache.hpp"
+#include "Pack.hpp"
+#include "ThreadPool.hpp"
+
+struct ExperimentOptions
+{
+    std::string candidate = "Simple";
+    std::string baseline = "Simple";
+    std::string opponent = "Simple";
+    long deals = 10000;
+    bool stratify = false;
+    uint64_t seed = 0;
+    double z = 1.96;
+};
+
+struct ExperimentResult
+{
+    long deals = 0;
+    double mean_candidate = 0;       // points per deal, both seatings
+    double mean_baseline = 0;
+    double mean_difference = 0;      // candidate minus baseline
+    double half_width = 0;           // paired interval on the difference
+    double unpaired_half_width = 0;  // the interval independent arms give
+    int strata = 0;                  // strata sampled, or 0 if unstratified
+};
+
+// Deal features used for stratification
+const int NUM_STRATA = 24 * 3 * 3;
+
+// REQUIRES: pack is in dealing order for a hand dealt by player 0
+// EFFECTS: returns the stratum of the deal: the upcard, then how many of
+//          the jacks of the upcard's suit and its same-color suit went to
+//          the dealer's team and to the other team
+int deal_stratum(const Pack &pack);
+
+// REQUIRES: pack is in dealing order for a hand dealt by player 0
+// EFFECTS: returns rank_deal() of the hands and upcard pack deals
+uint64_t deal_rank(const Pack &pack);
+
+// EFFECTS: returns the probability of each stratum for a uniform deal
+const std::array<double, NUM_STRATA> & stratum_probabilities();
+
+// REQUIRES: every strategy in options is non-interactive, and deterministic
+//           if cache is given
+// MODIFIES: cache
+// EFFECTS: Plays options.deals paired deals on pool and returns the
+//          statistics, taking hands already in cache from there instead of
+//          playing them.  Results do not depend on the number of threads.
+ExperimentResult run_experiment(const ExperimentOptions &options, ThreadPool &pool,
+                                OutcomeCache *cache = nullptr);
+
+// EFFECTS: Prints result as a short report
+void print_experiment(const ExperimentOptions &options, const ExperimentResult &result,
+                      std::ostream &os);
+
+// EFFECTS: Runs an experiment from command line arguments
+//          CANDIDATE BASELINE DEALS THREADS [--opponent STRATEGY]
+//          [--stratify] [--seed N] [--cache FILE] and prints the report.
+//          Deterministic strategies share an outcome cache, loaded from and
+//          saved to FILE if given.  Returns the process exit status.
+int experiment_main(int argc, char **argv);
+
+#endif // EXPERIMENT_HPP
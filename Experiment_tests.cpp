@@ -0,0 +1,77 @@
+#include "Experiment.hpp"
+#include "Random.hpp"
+#include "unit_test_framework.hpp"
+
+using namespace std;
+
+TEST(test_stratum_probabilities_match_deals) {
+    const array<double, NUM_STRATA> &probabilities = stratum_probabilities();
+    double total = 0;
+    for (double p : probabilities) {
+        total += p;
+    }
+    ASSERT_ALMOST_EQUAL(total, 1.0, 1e-9);
+
+    // the share of deals with no bower on either team, over all upcards
+    const int samples = 200000;
+    int none = 0;
+    for (int i = 0; i < samples; i++) {
+        Pack pack;
+        pack.shuffle(derive_seed(5, i));
+        none += deal_stratum(pack) % 9 == 0;
+    }
+    double expected = 0;
+    for (int h = 0; h < NUM_STRATA; h += 9) {
+        expected += probabilities[h];
+    }
+    ASSERT_ALMOST_EQUAL(double(none) / samples, expected, 0.005);
+}
+
+TEST(test_identical_arms_have_no_paired_variance) {
+    ExperimentOptions options;
+    options.deals = 2000;
+    ThreadPool pool(2);
+    ExperimentResult result = run_experiment(options, pool);
+    ASSERT_EQUAL(result.deals, 2000);
+    ASSERT_EQUAL(result.mean_difference, 0.0);
+    ASSERT_EQUAL(result.half_width, 0.0);
+    // with every seat the same, the two seatings of a deal cancel exactly
+    ASSERT_EQUAL(result.mean_candidate, 0.0);
+    ASSERT_EQUAL(result.mean_baseline, 0.0);
+}
+
+TEST(test_stratified_experiment_is_reproducible) {
+    ExperimentOptions options;
+    options.deals = 3000;
+    options.stratify = true;
+    options.seed = 11;
+    ThreadPool one(1);
+    ThreadPool three(3);
+    ExperimentResult a = run_experiment(options, one);
+    ExperimentResult b = run_experiment(options, three);
+    ASSERT_EQUAL(a.deals, 3000);
+    ASSERT_TRUE(a.strata > 100);
+    ASSERT_EQUAL(a.mean_candidate, b.mean_candidate);
+    ASSERT_EQUAL(a.unpaired_half_width, b.unpaired_half_width);
+    ASSERT_EQUAL(a.half_width, 0.0);
+}
+
+TEST(test_cached_experiment_matches_uncached) {
+    ExperimentOptions options;
+    options.deals = 500;
+    options.seed = 4;
+    ThreadPool pool(2);
+    OutcomeCache cache(1 << 16);
+    ExperimentResult plain = run_experiment(options, pool);
+    ExperimentResult first = run_experiment(options, pool, &cache);
+    // every seat plays Simple, so each deal is only played once
+    ASSERT_EQUAL(cache.misses(), options.deals);
+    ASSERT_EQUAL(cache.hits(), 3 * options.deals);
+    ExperimentResult second = run_experiment(options, pool, &cache);
+    ASSERT_EQUAL(cache.misses(), options.deals);
+    ASSERT_EQUAL(cache.hits(), 7 * options.deals);
+    ASSERT_EQUAL(plain.mean_candidate, first.mean_candidate);
+    ASSERT_EQUAL(plain.unpaired_half_width, second.unpaired_half_width);
+}
+
+TEST_MAIN()
@@ -0,0 +1,244 @@
+#include "Game.hpp"
+#include "Random.hpp"
+
+Game::Game(const std::istream &pack_input, const bool shuffle, const int points_to_win,
+           const std::array<std::string, num_players> names,
+           const std::array<std::string, num_players> strategies,
+           std::ostream &os)
+    : player_strategies(strategies), points_to_win(points_to_win), shuffle_between_hands(shuffle),
+      random_shuffle(false), seed(0), os(os),
+      checkpoint_every(0), hand_number(0), dealer(PLAYER_ZERO),
+      hand([this](const PlayerEvent &event) { notify(event); })
+{
+    points = {0};
+    hand_tricks = {0};
+    for (int i = 0; i < num_players; i++)
+    {
+        players[i] = Player_factory(names[i], strategies[i]);
+        this->names[i] = names[i];
+    }
+    hand.narrate(os, this->names);
+}
+
+Game::~Game()
+{
+    for (size_t i = 0; i < players.size(); ++i)
+    {
+        delete players[i];
+    }
+}
+
+Team_Number Game::play()
+{
+    while (!is_over())
+    {
+        play_next_hand();
+    }
+
+    // A team has won
+    if (points[0] >= points_to_win)
+    {
+        os << team_names(TEAM_ZERO_AND_TWO) << " win!" << std::endl;
+        return TEAM_ZERO_AND_TWO;
+    }
+    os << team_names(TEAM_ONE_AND_THREE) << " win!" << std::endl;
+    return TEAM_ONE_AND_THREE;
+}
+
+void Game::reset(const Pack &pack_in, const bool shuffle, const int points_to_win_in,
+                 const std::array<std::string, num_players> &names,
+                 const std::array<std::string, num_players> &strategies)
+{
+    for (int i = 0; i < num_players; i++)
+    {
+        if (players[i]->get_name() != names[i] || player_strategies[i] != strategies[i])
+        {
+            delete players[i];
+            players[i] = Player_factory(names[i], strategies[i]);
+        }
+    }
+    this->names = names;
+    player_strategies = strategies;
+    pack = pack_in;
+    points_to_win = points_to_win_in;
+    shuffle_between_hands = shuffle;
+    random_shuffle = false;
+    seed = 0;
+    points = {0};
+    hand_tricks = {0};
+    hand_number = 0;
+    dealer = PLAYER_ZERO;
+}
+
+int Game::get_points(Team_Number team) const
+{
+    return points[team];
+}
+
+int Game::get_hand_tricks(Team_Number team) const
+{
+    return hand_tricks[team];
+}
+
+int Game::get_hands_played() const
+{
+    return hand_number;
+}
+
+bool Game::is_over() const
+{
+    return points[0] >= points_to_win || points[1] >= points_to_win;
+}
+
+void Game::play_next_hand()
+{
+    os << "Hand " << hand_number << std::endl;
+    play_hand();
+    // print scores
+    os << team_names(TEAM_ZERO_AND_TWO) << " have " << points[0] << " points" << std::endl;
+    os << team_names(TEAM_ONE_AND_THREE) << " have " << points[1] << " points" << std::endl;
+    os << std::endl;
+
+    hand_number++;
+    dealer = pass_left(dealer);
+
+    if (checkpoint_every > 0 && hand_number % checkpoint_every == 0)
+    {
+        if (!write_checkpoint(checkpoint_path, get_checkpoint()))
+        {
+            std::cerr << "Error writing checkpoint " << checkpoint_path << std::endl;
+        }
+    }
+}
+
+void Game::use_random_shuffle(uint64_t seed_in)
+{
+    random_shuffle = true;
+    seed = seed_in;
+}
+
+void Game::enable_checkpoints(const std::string &path, int every_hands)
+{
+    checkpoint_path = path;
+    checkpoint_every = every_hands;
+}
+
+Checkpoint Game::get_checkpoint() const
+{
+    Checkpoint checkpoint;
+    checkpoint.points_to_win = points_to_win;
+    checkpoint.shuffle = shuffle_between_hands;
+    checkpoint.random_shuffle = random_shuffle;
+    checkpoint.seed = seed;
+    checkpoint.hand_number = hand_number;
+    checkpoint.dealer = dealer;
+    checkpoint.points = {points[0], points[1]};
+    checkpoint.pack_next = pack.get_next();
+    checkpoint.pack_cards = pack.get_cards();
+    return checkpoint;
+}
+
+bool Game::restore(const Checkpoint &checkpoint)
+{
+    if (checkpoint.points_to_win != points_to_win ||
+        checkpoint.shuffle != shuffle_between_hands ||
+        checkpoint.random_shuffle != random_shuffle || checkpoint.seed != seed)
+    {
+        return false;
+    }
+    hand_number = checkpoint.hand_number;
+    dealer = Player_Number(checkpoint.dealer);
+    points = {checkpoint.points[0], checkpoint.points[1]};
+    pack = Pack(checkpoint.pack_cards, checkpoint.pack_next);
+    return true;
+}
+
+Player_Number Game::pass_left(const Player_Number player) const
+{
+    return Player_Number((player + 1) % num_players);
+}
+
+Player_Number Game::pass_across(const Player_Number player) const
+{
+    return Player_Number((player + 2) % num_players);
+}
+
+std::string Game::team_names(Team_Number team) const
+{
+    Player_Number first_teammate = Player_Number(team);
+    Player_Number second_teammate = pass_across(first_teammate);
+    return players[first_teammate]->get_name() + " and " + players[second_teammate]->get_name();
+}
+
+void Game::notify(const PlayerEvent &event)
+{
+    for (Player *player : players)
+    {
+        player->observe(event);
+    }
+}
+
+void Game::play_turn()
+{
+    const int seat = hand.to_act();
+    Player *player = players[seat];
+    const Card upcard = hand.get_upcard();
+    if (hand.get_phase() == Hand::BID)
+    {
+        Suit trump_suit = upcard.get_suit();
+        const bool order_up = player->make_trump(upcard, seat == dealer, hand.get_round(),
+                                                 trump_suit);
+        hand.bid(order_up, trump_suit);
+    }
+    else if (hand.get_phase() == Hand::DISCARD)
+    {
+        // dealer picks up upcard and discards a card
+        player->add_and_discard(upcard);
+        hand.discard();
+    }
+    else if (hand.get_num_in_trick() == 0)
+    {
+        hand.play(player->lead_card(hand.get_trump()));
+    }
+    else
+    {
+        hand.play(player->play_card(hand.get_led_card(), hand.get_trump()));
+    }
+}
+
+void Game::play_hand()
+{
+    // shuffle
+    if (random_shuffle)
+    {
+        pack.shuffle(derive_seed(seed, hand_number));
+    }
+    else if (shuffle_between_hands)
+    {
+        pack.shuffle();
+    }
+    pack.reset();
+
+    // deal
+    Hand::Deal cards;
+    const Card upcard = Hand::deal(pack, dealer, cards);
+    for (int i = 0; i < num_players; i++)
+    {
+        for (const Card &card : cards[i])
+        {
+            players[i]->add_card(card);
+        }
+    }
+
+    // make trump and play the tricks
+    hand.start(dealer, upcard);
+    while (hand.get_phase() != Hand::OVER)
+    {
+        play_turn();
+    }
+    hand_tricks = {hand.get_tricks(TEAM_ZERO_AND_TWO),
+                   hand.get_tricks(TEAM_ONE_AND_THREE)};
+
+    // scoring the hand
+    hand.score(points);
+}
@@ -0,0 +1,129 @@
+#ifndef GAME_HPP
+#define GAME_HPP
+/* Game.hpp
+ *
+ * Runs a game of euchre between four players
+ */
+
+#include <iostream>
+#include <array>
+#include <string>
+#include "Player.hpp"
+#include "Pack.hpp"
+#include "Checkpoint.hpp"
+#include "Hand.hpp"
+
+enum Player_Number
+{
+    PLAYER_ZERO = 0,
+    PLAYER_ONE = 1,
+    PLAYER_TWO = 2,
+    PLAYER_THREE = 3,
+};
+
+enum Team_Number
+{
+    TEAM_ZERO_AND_TWO = 0,
+    TEAM_ONE_AND_THREE = 1,
+};
+
+class Game
+{
+public:
+    static const int num_players = 4;
+    static const int num_teams = 2;
+
+    // EFFECTS: Creates a game between players with the given names and
+    //          strategies.  Game output is written to os.
+    Game(const std::istream &pack_input, const bool shuffle, const int points_to_win,
+         const std::array<std::string, num_players> names,
+         const std::array<std::string, num_players> strategies,
+         std::ostream &os = std::cout);
+
+    ~Game();
+
+    // EFFECTS: Play hands until one team has points_to_win or more points.
+    //          Returns the winning team.
+    Team_Number play();
+
+    // EFFECTS: Starts a new game with pack and the given settings, with
+    //          the random shuffle turned off.  Players whose name and
+    //          strategy are unchanged are kept rather than created again.
+    void reset(const Pack &pack_in, const bool shuffle, const int points_to_win_in,
+               const std::array<std::string, num_players> &names,
+               const std::array<std::string, num_players> &strategies);
+
+    // EFFECTS: returns the points team has so far
+    int get_points(Team_Number team) const;
+
+    // EFFECTS: returns the tricks team took in the last hand played
+    int get_hand_tricks(Team_Number team) const;
+
+    // EFFECTS: returns the number of hands played so far
+    int get_hands_played() const;
+
+    // EFFECTS: returns true if a team has points_to_win or more points
+    bool is_over() const;
+
+    // REQUIRES: !is_over()
+    // EFFECTS: Plays one hand, prints the scores and passes the deal left.
+    //          Writes a checkpoint afterwards if checkpoints are enabled.
+    void play_next_hand();
+
+    // EFFECTS: Shuffles before every hand with a random permutation drawn
+    //          from seed and the hand number, instead of the in-shuffle.
+    void use_random_shuffle(uint64_t seed);
+
+    // REQUIRES: every_hands >= 1
+    // EFFECTS: Writes a checkpoint to path after every every_hands hands.
+    void enable_checkpoints(const std::string &path, int every_hands);
+
+    // EFFECTS: returns the state needed to resume the game between hands
+    Checkpoint get_checkpoint() const;
+
+    // EFFECTS: Restores a state from get_checkpoint().  Returns false and
+    //          leaves the game unchanged if the checkpoint was written by a
+    //          game with different settings.
+    bool restore(const Checkpoint &checkpoint);
+
+private:
+    // variables through entire game
+    std::array<Player *, num_players> players; // players indexed 0,1,2,3
+    std::array<std::string, num_players> names;
+    std::array<int, num_teams> points;         // points for players 0 and 2 (index 0) and for players 1 and 3 (index 1)
+    std::array<int, num_teams> hand_tricks;    // tricks per team in the last hand
+    Pack pack;
+    std::array<std::string, num_players> player_strategies;
+    int points_to_win;
+    bool shuffle_between_hands;
+    bool random_shuffle;
+    uint64_t seed;
+    std::ostream &os;
+
+    // checkpointing, disabled when checkpoint_every is 0
+    std::string checkpoint_path;
+    int checkpoint_every;
+
+    // variables each hand
+    int hand_number;
+    Player_Number dealer;
+    Hand hand;
+
+    // EFFECTS move player 1 to the left
+    Player_Number pass_left(const Player_Number player) const;
+
+    // EFFECTS move player 2 to the left (your teammate)
+    Player_Number pass_across(const Player_Number player) const;
+
+    std::string team_names(Team_Number team) const;
+
+    // EFFECTS shows event to every player
+    void notify(const PlayerEvent &event);
+
+    // EFFECTS asks the player whose turn it is for the hand's next decision
+    void play_turn();
+
+    void play_hand();
+};
+
+#endif // GAME_HPP
@@ -0,0 +1,250 @@
+#include "GameState.hpp"
+#include <cassert>
+
+static_assert(sizeof(GameState) == 32, "GameState should stay half a cache line");
+
+namespace
+{
+    const int CARDS_PER_SUIT = 6;
+    const int JACK_OFFSET = JACK - NINE;
+    const int PLAYS_IN_HISTORY = 12;
+    const int BITS_PER_PLAY = 5;
+
+    // Effective suit and trick-taking power of each card under each trump
+    struct CardTables
+    {
+        int suit[4][24];
+        // trump: 8 + order with the bowers on top; otherwise 1 + rank
+        int power[4][24];
+        uint32_t suit_mask[4][4];
+    };
+
+    constexpr CardTables make_tables()
+    {
+        CardTables tables{};
+        for (int trump = 0; trump < 4; trump++)
+        {
+            const int next = (trump + 2) % 4;
+            for (int card = 0; card < 24; card++)
+            {
+                const int suit = card / CARDS_PER_SUIT;
+                const int rank = card % CARDS_PER_SUIT;
+                int effective_suit = suit;
+                int power = 1 + rank;
+                if (rank == JACK_OFFSET && suit == trump)
+                {
+                    power = 8 + 6;
+                }
+                else if (rank == JACK_OFFSET && suit == next)
+                {
+                    effective_suit = trump;
+                    power = 8 + 5;
+                }
+                else if (suit == trump)
+                {
+                    // the Jack is gone, so the Queen through Ace close up
+                    power = 8 + (rank < JACK_OFFSET ? rank : rank - 1);
+                }
+                tables.suit[trump][card] = effective_suit;
+                tables.power[trump][card] = power;
+                tables.suit_mask[trump][effective_suit] |= uint32_t(1) << card;
+            }
+        }
+        return tables;
+    }
+
+    constexpr CardTables TABLES = make_tables();
+}
+
+GameState::GameState()
+    : hands{0, 0, 0, 0}, history(0), history_hi(0), trump(0), maker(0), leader(0),
+      num_played(0), tricks_zero(0), tricks_one(0) {}
+
+GameState::GameState(const std::array<uint32_t, num_players> &hands_in, Suit trump_in,
+                     int maker_team, int leader_in)
+    : hands{hands_in[0], hands_in[1], hands_in[2], hands_in[3]}, history(0), history_hi(0),
+      trump(trump_in), maker(maker_team), leader(leader_in), num_played(0), tricks_zero(0),
+      tricks_one(0) {}
+
+GameState::GameState(const std::array<std::vector<Card>, num_players> &hands_in,
+                     Suit trump_in, int maker_team, int leader_in)
+    : GameState({mask_of(hands_in[0]), mask_of(hands_in[1]), mask_of(hands_in[2]),
+                 mask_of(hands_in[3])},
+                trump_in, maker_team, leader_in) {}
+
+uint32_t GameState::mask_of(const std::vector<Card> &cards)
+{
+    uint32_t mask = 0;
+    for (const Card &card : cards)
+    {
+        mask |= uint32_t(1) << Card_to_index(card);
+    }
+    return mask;
+}
+
+uint32_t GameState::legal_moves() const
+{
+    const uint32_t hand = hands[to_move()];
+    const int in_trick = num_played % num_players;
+    if (in_trick == 0)
+    {
+        return hand;
+    }
+    const int led = get_play(num_played - in_trick);
+    const uint32_t follow = hand & TABLES.suit_mask[trump][TABLES.suit[trump][led]];
+    return follow ? follow : hand;
+}
+
+void GameState::apply(int card)
+{
+    assert(!is_terminal());
+    assert(legal_moves() & (uint32_t(1) << card));
+    hands[to_move()] &= ~(uint32_t(1) << card);
+    set_play(num_played, card);
+    num_played += 1;
+
+    if (num_played % num_players == 0)
+    {
+        leader = (leader + winning_offset(num_played)) % num_players;
+        if (leader % 2 == 0)
+        {
+            tricks_zero += 1;
+        }
+        else
+        {
+            tricks_one += 1;
+        }
+    }
+}
+
+void GameState::undo()
+{
+    assert(num_played > 0);
+    if (num_played % num_players == 0)
+    {
+        // the winner of the trick leads now; step back to who led it
+        if (leader % 2 == 0)
+        {
+            tricks_zero -= 1;
+        }
+        else
+        {
+            tricks_one -= 1;
+        }
+        leader = (leader + num_players - winning_offset(num_played)) % num_players;
+    }
+
+    num_played -= 1;
+    const int card = get_play(num_played);
+    set_play(num_played, 0);
+    hands[to_move()] |= uint32_t(1) << card;
+}
+
+bool GameState::is_terminal() const
+{
+    return num_played == num_plays;
+}
+
+int GameState::score() const
+{
+    assert(is_terminal());
+    const int maker_tricks = get_tricks(maker);
+    int points = 2;
+    if (maker_tricks == 3 || maker_tricks == 4)
+    {
+        points = 1;
+    }
+    // the makers score if they take three tricks, otherwise the defenders
+    const int scoring_team = maker_tricks >= 3 ? int(maker) : 1 - int(maker);
+    return scoring_team == 0 ? points : -points;
+}
+
+int GameState::to_move() const
+{
+    return (leader + num_played % num_players) % num_players;
+}
+
+int GameState::get_leader() const
+{
+    return leader;
+}
+
+uint32_t GameState::get_hand(int player) const
+{
+    return hands[player];
+}
+
+int GameState::get_tricks(int team) const
+{
+    return team == 0 ? tricks_zero : tricks_one;
+}
+
+Suit GameState::get_trump() const
+{
+    return Suit(trump);
+}
+
+int GameState::get_maker() const
+{
+    return maker;
+}
+
+int GameState::get_num_played() const
+{
+    return num_played;
+}
+
+int GameState::get_play(int i) const
+{
+    if (i < PLAYS_IN_HISTORY)
+    {
+        return (history >> (BITS_PER_PLAY * i)) & 31;
+    }
+    return (history_hi >> (BITS_PER_PLAY * (i - PLAYS_IN_HISTORY))) & 31;
+}
+
+int GameState::trick_winner(const int cards[num_players], int leader, Suit trump)
+{
+    const int led_suit = TABLES.suit[trump][cards[0]];
+    int best = 0;
+    int best_power = TABLES.power[trump][cards[0]];
+    for (int i = 1; i < num_players; i++)
+    {
+        const int card = cards[i];
+        int power = TABLES.power[trump][card];
+        if (TABLES.suit[trump][card] != led_suit && power < 8)
+        {
+            power = 0;
+        }
+        if (power > best_power)
+        {
+            best = i;
+            best_power = power;
+        }
+    }
+    return (leader + best) % num_players;
+}
+
+void GameState::set_play(int i, int card)
+{
+    if (i < PLAYS_IN_HISTORY)
+    {
+        const int shift = BITS_PER_PLAY * i;
+        history = (history & ~(uint64_t(31) << shift)) | (uint64_t(card) << shift);
+    }
+    else
+    {
+        const int shift = BITS_PER_PLAY * (i - PLAYS_IN_HISTORY);
+        history_hi = (history_hi & ~(uint64_t(31) << shift)) | (uint64_t(card) << shift);
+    }
+}
+
+int GameState::winning_offset(int end) const
+{
+    int cards[num_players];
+    for (int i = 0; i < num_players; i++)
+    {
+        cards[i] = get_play(end - num_players + i);
+    }
+    return trick_winner(cards, 0, Suit(trump));
+}
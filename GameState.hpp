@@ -0,0 +1,109 @@
+#ifndef GAMESTATE_HPP
+#define GAMESTATE_HPP
+/* GameState.hpp
+ *
+ * The card play of one hand of euchre as a small value type, for search
+ * and rollouts.  Cards are identified by Card_to_index and sets of cards
+ * are 24-bit masks.  apply() and undo() make and unmake single plays, and
+ * the state copies as 32 plain bytes.
+ */
+
+#include <array>
+#include <cstdint>
+#include <vector>
+#include "Card.hpp"
+
+class GameState
+{
+public:
+    static const int num_players = 4;
+    static const int num_tricks = 5;
+    static const int num_plays = num_players * num_tricks;
+
+    // EFFECTS: Creates a state with empty hands
+    GameState();
+
+    // REQUIRES: hands are disjoint masks of five cards each,
+    //           0 <= maker_team < 2, 0 <= leader < 4
+    // EFFECTS: Creates the state at the first lead of a hand
+    GameState(const std::array<uint32_t, num_players> &hands, Suit trump, int maker_team,
+              int leader);
+
+    // REQUIRES: as above, with each hand holding euchre cards
+    GameState(const std::array<std::vector<Card>, num_players> &hands, Suit trump,
+              int maker_team, int leader);
+
+    // EFFECTS: returns the mask of cards in a hand
+    static uint32_t mask_of(const std::vector<Card> &cards);
+
+    // EFFECTS: returns the mask of cards the player to move may play: the
+    //          cards following the led suit (counting the left bower as
+    //          trump) if they have any, otherwise their whole hand
+    uint32_t legal_moves() const;
+
+    // REQUIRES: !is_terminal(), card is in legal_moves()
+    // MODIFIES: *this
+    // EFFECTS: plays card for the player to move.  Completing a trick
+    //          credits its winner, who leads next.
+    void apply(int card);
+
+    // REQUIRES: get_num_played() > 0
+    // MODIFIES: *this
+    // EFFECTS: takes back the most recent play
+    void undo();
+
+    // EFFECTS: returns true once all five tricks are played
+    bool is_terminal() const;
+
+    // REQUIRES: is_terminal()
+    // EFFECTS: returns the points team 0 scored for the hand minus the
+    //          points team 1 scored, as Game::play_hand awards them
+    int score() const;
+
+    // EFFECTS: returns the player whose turn it is
+    int to_move() const;
+
+    // EFFECTS: returns the player who led the current trick
+    int get_leader() const;
+
+    // EFFECTS: returns the cards left in a player's hand
+    uint32_t get_hand(int player) const;
+
+    // EFFECTS: returns the number of tricks team has taken
+    int get_tricks(int team) const;
+
+    Suit get_trump() const;
+    int get_maker() const;
+    int get_num_played() const;
+
+    // REQUIRES: 0 <= i < get_num_played()
+    // EFFECTS: returns the i-th card played this hand
+    int get_play(int i) const;
+
+    // EFFECTS: returns the player who wins a complete trick of cards
+    //          led by leader
+    static int trick_winner(const int cards[num_players], int leader, Suit trump);
+
+    bool operator==(const GameState &other) const = default;
+
+private:
+    uint32_t hands[num_players];
+    // card indices in play order, five bits each: plays 0-11 in history,
+    // plays 12-19 in history_hi
+    uint64_t history;
+    uint64_t history_hi : 40;
+    uint64_t trump : 2;
+    uint64_t maker : 1;
+    uint64_t leader : 2;
+    uint64_t num_played : 5;
+    uint64_t tricks_zero : 3;
+    uint64_t tricks_one : 3;
+
+    void set_play(int i, int card);
+
+    // EFFECTS: returns the position in the trick ending at play end
+    //          (exclusive) of the card that won it
+    int winning_offset(int end) const;
+};
+
+#endif // GAMESTATE_HPP
@@ -0,0 +1,132 @@
+#include "GameState.hpp"
+#include "Pack.hpp"
+#include "Random.hpp"
+#include "unit_test_framework.hpp"
+
+#include <vector>
+
+using namespace std;
+
+// EFFECTS: deals four five-card hands from a pack shuffled with seed
+static array<vector<Card>, 4> deal_hands(uint64_t seed) {
+    Pack pack;
+    pack.shuffle(seed);
+    array<vector<Card>, 4> hands;
+    for (int player = 0; player < 4; player++) {
+        for (int i = 0; i < 5; i++) {
+            hands[player].push_back(pack.deal_one());
+        }
+    }
+    return hands;
+}
+
+// EFFECTS: returns the cards player may play, by the rules Game's players
+//          follow, as a mask
+static uint32_t reference_legal(const vector<Card> &hand, const vector<Card> &trick,
+                                Suit trump) {
+    uint32_t all = GameState::mask_of(hand);
+    if (trick.empty()) {
+        return all;
+    }
+    vector<Card> follow;
+    for (const Card &card : hand) {
+        if (card.get_suit(trump) == trick[0].get_suit(trump)) {
+            follow.push_back(card);
+        }
+    }
+    return follow.empty() ? all : GameState::mask_of(follow);
+}
+
+TEST(test_game_state_matches_reference_rules) {
+    for (uint64_t seed = 0; seed < 2000; seed++) {
+        Random random(seed);
+        array<vector<Card>, 4> hands = deal_hands(seed);
+        const Suit trump = Suit(random.below(4));
+        const int maker = random.below(2);
+        int leader = random.below(4);
+        GameState state(hands, trump, maker, leader);
+        const GameState start = state;
+
+        int tricks[2] = {0, 0};
+        for (int trick = 0; trick < 5; trick++) {
+            vector<Card> played;
+            Card highest;
+            int winner = leader;
+            for (int i = 0; i < 4; i++) {
+                const int player = (leader + i) % 4;
+                ASSERT_EQUAL(state.to_move(), player);
+                uint32_t legal = state.legal_moves();
+                ASSERT_EQUAL(legal, reference_legal(hands[player], played, trump));
+
+                // pick a random legal card
+                vector<int> choices;
+                for (int card = 0; card < 24; card++) {
+                    if (legal & (1u << card)) {
+                        choices.push_back(card);
+                    }
+                }
+                const int choice = choices[random.below(choices.size())];
+                const Card card = Card_from_index(choice);
+                state.apply(choice);
+
+                // as Game::play_trick decides the winner
+                if (i == 0 || Card_less(highest, card, played[0], trump)) {
+                    highest = card;
+                    winner = player;
+                }
+                played.push_back(card);
+                for (auto it = hands[player].begin(); it != hands[player].end(); ++it) {
+                    if (*it == card) {
+                        hands[player].erase(it);
+                        break;
+                    }
+                }
+            }
+            tricks[winner % 2]++;
+            leader = winner;
+            ASSERT_EQUAL(state.get_leader(), leader);
+            ASSERT_EQUAL(state.get_tricks(0), tricks[0]);
+            ASSERT_EQUAL(state.get_tricks(1), tricks[1]);
+        }
+        ASSERT_TRUE(state.is_terminal());
+
+        // as Game::play_hand awards points
+        int expected = 0;
+        if (tricks[maker] >= 3) {
+            expected = tricks[maker] == 5 ? 2 : 1;
+            expected = maker == 0 ? expected : -expected;
+        } else {
+            expected = maker == 0 ? -2 : 2;
+        }
+        ASSERT_EQUAL(state.score(), expected);
+
+        while (state.get_num_played() > 0) {
+            state.undo();
+        }
+        ASSERT_TRUE(state == start);
+    }
+}
+
+TEST(test_game_state_left_bower_led) {
+    // hearts trump: the Jack of Diamonds is the left bower and leads trump
+    array<vector<Card>, 4> hands = {{
+        {Card(JACK, DIAMONDS)},
+        {Card(ACE, HEARTS)},
+        {Card(ACE, DIAMONDS)},
+        {Card(JACK, HEARTS)},
+    }};
+    GameState state(hands, HEARTS, 0, 0);
+    state.apply(Card_to_index(Card(JACK, DIAMONDS)));
+    ASSERT_EQUAL(state.legal_moves(), 1u << Card_to_index(Card(ACE, HEARTS)));
+    state.apply(Card_to_index(Card(ACE, HEARTS)));
+    state.apply(Card_to_index(Card(ACE, DIAMONDS)));
+    state.apply(Card_to_index(Card(JACK, HEARTS)));
+    ASSERT_EQUAL(state.get_leader(), 3);
+    ASSERT_EQUAL(state.get_tricks(1), 1);
+}
+
+TEST(test_game_state_is_small) {
+    ASSERT_TRUE(sizeof(GameState) <= 32);
+}
+
+TEST_MAIN()
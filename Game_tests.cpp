@@ -0,0 +1,53 @@
+#include "Game.hpp"
+#include "unit_test_framework.hpp"
+
+#include <cstdio>
+#include <sstream>
+
+using namespace std;
+
+static const array<string, Game::num_players> NAMES = {"Edsger", "Fran", "Gabriel", "Herb"};
+static const array<string, Game::num_players> SIMPLE = {"Simple", "Simple", "Simple", "Simple"};
+
+TEST(test_game_resume_matches_uninterrupted) {
+    istringstream pack_input;
+    ostringstream full_output;
+    Game full(pack_input, true, 10, NAMES, SIMPLE, full_output);
+    Team_Number full_winner = full.play();
+
+    // play three hands, checkpoint, and finish in a fresh game
+    const string path = "Game_tests_checkpoint.bin";
+    ostringstream split_output;
+    {
+        Game first(pack_input, true, 10, NAMES, SIMPLE, split_output);
+        first.enable_checkpoints(path, 3);
+        for (int i = 0; i < 3; i++) {
+            first.play_next_hand();
+        }
+    }
+    Checkpoint checkpoint;
+    ASSERT_TRUE(read_checkpoint(path, checkpoint));
+    ASSERT_EQUAL(checkpoint.hand_number, 3);
+    remove(path.c_str());
+
+    Game second(pack_input, true, 10, NAMES, SIMPLE, split_output);
+    ASSERT_TRUE(second.restore(checkpoint));
+    ASSERT_EQUAL(second.play(), full_winner);
+    ASSERT_EQUAL(split_output.str(), full_output.str());
+}
+
+TEST(test_game_restore_rejects_other_settings) {
+    istringstream pack_input;
+    ostringstream output;
+    Game game(pack_input, true, 10, NAMES, SIMPLE, output);
+    Checkpoint checkpoint = game.get_checkpoint();
+    checkpoint.points_to_win = 5;
+    ASSERT_FALSE(game.restore(checkpoint));
+}
+
+TEST(test_read_checkpoint_missing_file) {
+    Checkpoint checkpoint;
+    ASSERT_FALSE(read_checkpoint("no_such_checkpoint.bin", checkpoint));
+}
+
+TEST_MAIN()
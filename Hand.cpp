@@ -0,0 +1,239 @@
+#include "Hand.hpp"
+#include <cassert>
+
+static const int DEALING_PATTERN[2 * Hand::num_players] = {3, 2, 3, 2, 2, 3, 2, 3};
+
+Card Hand::deal(Pack &pack, int dealer, Deal &hands)
+{
+    std::array<int, num_players> dealt = {0, 0, 0, 0};
+    int seat = (dealer + 1) % num_players;
+    for (int count : DEALING_PATTERN)
+    {
+        for (int j = 0; j < count; j++)
+        {
+            hands[seat][dealt[seat]++] = pack.deal_one();
+        }
+        seat = (seat + 1) % num_players;
+    }
+    return pack.deal_one();
+}
+
+Hand::Hand(const Listener &listener)
+    : listener(listener), os(nullptr), names(nullptr), phase(OVER), dealer(0), round(1),
+      turn(0), trump(SPADES), maker(0), num_in_trick(0), best_seat(0), trick_number(0),
+      tricks({0, 0}) {}
+
+void Hand::narrate(std::ostream &os_in,
+                  const std::array<std::string, num_players> &names_in)
+{
+    os = &os_in;
+    names = &names_in;
+}
+
+void Hand::start(int dealer_in, Card upcard_in)
+{
+    dealer = dealer_in;
+    upcard = upcard_in;
+    phase = BID;
+    round = 1;
+    turn = (dealer + 1) % num_players;
+    num_in_trick = 0;
+    trick_number = 0;
+    tricks = {0, 0};
+    if (os)
+    {
+        *os << (*names)[dealer] << " deals" << std::endl;
+        *os << upcard << " turned up" << std::endl;
+    }
+
+    PlayerEvent event{PlayerEvent::HAND_STARTED};
+    event.player = dealer;
+    event.card = upcard;
+    listener(event);
+}
+
+Hand::Phase Hand::get_phase() const
+{
+    return phase;
+}
+
+int Hand::to_act() const
+{
+    assert(phase != OVER);
+    return phase == DISCARD ? dealer : turn;
+}
+
+int Hand::get_dealer() const
+{
+    return dealer;
+}
+
+Card Hand::get_upcard() const
+{
+    return upcard;
+}
+
+int Hand::get_round() const
+{
+    return round;
+}
+
+Suit Hand::get_trump() const
+{
+    return trump;
+}
+
+int Hand::get_maker() const
+{
+    return maker;
+}
+
+int Hand::get_num_in_trick() const
+{
+    return num_in_trick;
+}
+
+Card Hand::get_led_card() const
+{
+    assert(num_in_trick > 0);
+    return led_card;
+}
+
+int Hand::get_tricks(int team) const
+{
+    return tricks[team];
+}
+
+void Hand::bid(bool order_up, Suit suit)
+{
+    assert(phase == BID);
+    if (order_up)
+    {
+        trump = suit;
+        maker = turn;
+        if (os)
+        {
+            *os << (*names)[turn] << " orders up " << trump << std::endl;
+            *os << std::endl;
+        }
+
+        PlayerEvent event{PlayerEvent::ORDERED_UP};
+        event.player = turn;
+        event.trump = trump;
+        event.round = round;
+        listener(event);
+
+        // in round 1 the dealer picks up the upcard before play starts
+        phase = round == 1 ? DISCARD : PLAY;
+        turn = (dealer + 1) % num_players;
+        return;
+    }
+
+    if (os)
+    {
+        *os << (*names)[turn] << " passes" << std::endl;
+    }
+    PlayerEvent event{PlayerEvent::PASSED};
+    event.player = turn;
+    event.round = round;
+    listener(event);
+
+    turn = (turn + 1) % num_players;
+    if (turn == (dealer + 1) % num_players)
+    {
+        round++;
+    }
+}
+
+void Hand::discard()
+{
+    assert(phase == DISCARD);
+    phase = PLAY;
+}
+
+void Hand::play(Card card)
+{
+    assert(phase == PLAY);
+    if (num_in_trick == 0)
+    {
+        led_card = card;
+        best_card = card;
+        best_seat = turn;
+    }
+    else if (Card_less(best_card, card, led_card, trump))
+    {
+        best_card = card;
+        best_seat = turn;
+    }
+    if (os)
+    {
+        *os << card << (num_in_trick == 0 ? " led by " : " played by ") << (*names)[turn]
+            << std::endl;
+    }
+    PlayerEvent event{PlayerEvent::CARD_PLAYED};
+    event.player = turn;
+    event.card = card;
+    listener(event);
+
+    num_in_trick++;
+    turn = (turn + 1) % num_players;
+    if (num_in_trick < num_players)
+    {
+        return;
+    }
+
+    // the winner of the trick leads the next one
+    if (os)
+    {
+        *os << (*names)[best_seat] << " takes the trick" << std::endl;
+        *os << std::endl;
+    }
+    event = PlayerEvent{PlayerEvent::TRICK_WON};
+    event.player = best_seat;
+    listener(event);
+
+    tricks[best_seat % 2]++;
+    trick_number++;
+    turn = best_seat;
+    num_in_trick = 0;
+    if (trick_number == Player::MAX_HAND_SIZE)
+    {
+        phase = OVER;
+    }
+}
+
+int Hand::get_points(int &team) const
+{
+    const int makers = maker % 2;
+    if (tricks[makers] >= 3)
+    {
+        team = makers;
+        return tricks[makers] == Player::MAX_HAND_SIZE ? 2 : 1;
+    }
+    team = 1 - makers;
+    return 2;
+}
+
+void Hand::score(std::array<int, num_teams> &points) const
+{
+    int team;
+    const int won = get_points(team);
+    if (os)
+    {
+        *os << team_names(team) << " win the hand" << std::endl;
+        if (team != maker % 2)
+        {
+            *os << "euchred!" << std::endl;
+        }
+        else if (won == 2)
+        {
+            *os << "march!" << std::endl;
+        }
+    }
+    points[team] += won;
+}
+
+std::string Hand::team_names(int team) const
+{
+    return (*names)[team] + " and " + (*names)[team + 2];
+}
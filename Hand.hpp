@@ -0,0 +1,131 @@
+#ifndef HAND_HPP
+#define HAND_HPP
+/* Hand.hpp
+ *
+ * The rules of one hand of euchre, in one place: the deal, whose turn it
+ * is to bid and play, trick resolution and scoring.  A Hand does not ask
+ * anyone for decisions.  Its driver (Game, AsyncGame, a server Table,
+ * self-play) gets each decision from its own kind of player and applies
+ * it with bid(), discard() or play().  The Hand sends every PlayerEvent to
+ * a listener in the order Game always has, and can narrate the hand in
+ * Game's words.
+ */
+
+#include <array>
+#include <functional>
+#include <iostream>
+#include <string>
+#include "Card.hpp"
+#include "Pack.hpp"
+#include "Player.hpp"
+
+class Hand
+{
+public:
+    static const int num_players = 4;
+    static const int num_teams = 2;
+
+    enum Phase
+    {
+        BID,     // to_act() bids in get_round()
+        DISCARD, // the dealer picks up the upcard and discards
+        PLAY,    // to_act() plays a card
+        OVER,    // all tricks are played, or no hand has started
+    };
+
+    typedef std::array<std::array<Card, Player::MAX_HAND_SIZE>, num_players> Deal;
+    typedef std::function<void(const PlayerEvent &)> Listener;
+
+    // REQUIRES: pack has at least 21 cards left
+    // MODIFIES: pack, hands
+    // EFFECTS: Deals pack in the 3-2 pattern starting left of dealer.
+    //          hands[seat] gets the seat's cards in the order dealt.
+    //          Returns the upcard.
+    static Card deal(Pack &pack, int dealer, Deal &hands);
+
+    // EFFECTS: Creates a hand waiting to start, sending events to listener
+    explicit Hand(const Listener &listener);
+
+    // MODIFIES: os
+    // EFFECTS: From now on writes the hand as Game prints it to os, naming
+    //          seats by names.  os and names must outlive the hand.
+    void narrate(std::ostream &os, const std::array<std::string, num_players> &names);
+
+    // EFFECTS: Starts a hand dealt by dealer with upcard turned up, and
+    //          sends HAND_STARTED
+    void start(int dealer, Card upcard);
+
+    Phase get_phase() const;
+
+    // REQUIRES: get_phase() != OVER
+    // EFFECTS: returns the seat whose decision is needed
+    int to_act() const;
+
+    int get_dealer() const;
+    Card get_upcard() const;
+
+    // EFFECTS: returns the bidding round, 1 or 2
+    int get_round() const;
+
+    // REQUIRES: get_phase() is DISCARD, PLAY or OVER after a full hand
+    Suit get_trump() const;
+    int get_maker() const;
+
+    // EFFECTS: returns the number of cards played in the current trick
+    int get_num_in_trick() const;
+
+    // REQUIRES: get_num_in_trick() > 0
+    Card get_led_card() const;
+
+    // EFFECTS: returns the tricks team has taken this hand
+    int get_tricks(int team) const;
+
+    // REQUIRES: get_phase() == BID, and order_up if to_act() is the dealer
+    //           in round two
+    // EFFECTS: Applies to_act()'s bid, naming suit if order_up.  Ordering
+    //          up in round one moves to DISCARD, in round two to PLAY.
+    void bid(bool order_up, Suit suit);
+
+    // REQUIRES: get_phase() == DISCARD
+    // EFFECTS: Records that the dealer has picked up and discarded
+    void discard();
+
+    // REQUIRES: get_phase() == PLAY, card is a legal play for to_act()
+    // EFFECTS: Plays card for to_act().  The fourth card of a trick sends
+    //          TRICK_WON; the last trick moves to OVER.
+    void play(Card card);
+
+    // REQUIRES: get_phase() == OVER after a full hand
+    // EFFECTS: returns the points the hand is worth, and sets team to the
+    //          team that wins them
+    int get_points(int &team) const;
+
+    // REQUIRES: get_phase() == OVER after a full hand
+    // MODIFIES: points
+    // EFFECTS: Adds the hand's points to the team that won them
+    void score(std::array<int, num_teams> &points) const;
+
+private:
+    Listener listener;
+    std::ostream *os;
+    const std::array<std::string, num_players> *names;
+
+    Phase phase;
+    int dealer;
+    Card upcard;
+    int round;
+    int turn;
+    Suit trump;
+    int maker;
+
+    int num_in_trick;
+    Card led_card;
+    Card best_card;
+    int best_seat;
+    int trick_number;
+    std::array<int, num_teams> tricks;
+
+    std::string team_names(int team) const;
+};
+
+#endif // HAND_HPP
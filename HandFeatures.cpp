@@ -0,0 +1,134 @@
+#include "HandFeatures.hpp"
+
+using namespace std;
+
+namespace
+{
+    const int NUM_CARDS = 24;
+    const int NUM_SUITS = 4;
+    const int RANK_PLANES = 3;
+
+    // Masks for one trump suit
+    struct FeatureMasks
+    {
+        std::array<uint32_t, NUM_SUITS> suits{};
+        uint32_t trump = 0;
+        std::array<uint32_t, NUM_SUITS - 1> off_suits{};
+        uint32_t right_bower = 0;
+        uint32_t left_bower = 0;
+        uint32_t good = 0;
+        uint32_t off_aces = 0;
+        std::array<uint32_t, RANK_PLANES> rank_planes{};
+    };
+
+    FeatureMasks build(Suit trump)
+    {
+        FeatureMasks masks;
+        const Card trump_ten(TEN, trump);
+        for (int card = 0; card < NUM_CARDS; card++)
+        {
+            const Card c = Card_from_index(card);
+            const uint32_t bit = uint32_t(1) << card;
+            masks.suits[c.get_suit(trump)] |= bit;
+            if (c.is_right_bower(trump))
+            {
+                masks.right_bower |= bit;
+            }
+            if (c.is_left_bower(trump))
+            {
+                masks.left_bower |= bit;
+            }
+            if (Card_less(trump_ten, c, trump))
+            {
+                masks.good |= bit;
+            }
+            if (c.get_rank() == ACE && c.get_suit() != trump)
+            {
+                masks.off_aces |= bit;
+            }
+            if (c.is_trump(trump))
+            {
+                // one more than the number of trumps it beats
+                int rank = 1;
+                for (int other = 0; other < NUM_CARDS; other++)
+                {
+                    const Card o = Card_from_index(other);
+                    rank += o.is_trump(trump) && Card_less(o, c, trump);
+                }
+                for (int plane = 0; plane < RANK_PLANES; plane++)
+                {
+                    if (rank & (1 << plane))
+                    {
+                        masks.rank_planes[plane] |= bit;
+                    }
+                }
+            }
+        }
+        masks.trump = masks.suits[trump];
+        int off = 0;
+        for (int suit = 0; suit < NUM_SUITS; suit++)
+        {
+            if (suit != trump)
+            {
+                masks.off_suits[off++] = masks.suits[suit];
+            }
+        }
+        return masks;
+    }
+
+    const std::array<FeatureMasks, NUM_SUITS> & all_masks()
+    {
+        static const std::array<FeatureMasks, NUM_SUITS> masks = {
+            build(SPADES), build(HEARTS), build(CLUBS), build(DIAMONDS)};
+        return masks;
+    }
+
+    int count(uint32_t cards)
+    {
+        return __builtin_popcount(cards);
+    }
+
+    HandFeatures extract(uint32_t hand, const FeatureMasks &masks)
+    {
+        HandFeatures result;
+        result.trumps = uint8_t(count(hand & masks.trump));
+        result.right_bower = uint8_t((hand & masks.right_bower) != 0);
+        result.left_bower = uint8_t((hand & masks.left_bower) != 0);
+        result.good_trumps = uint8_t(count(hand & masks.good));
+        result.off_aces = uint8_t(count(hand & masks.off_aces));
+        int voids = 0;
+        int singletons = 0;
+        for (uint32_t suit : masks.off_suits)
+        {
+            const int held = count(hand & suit);
+            voids += held == 0;
+            singletons += held == 1;
+        }
+        result.voids = uint8_t(voids);
+        result.singletons = uint8_t(singletons);
+        result.trump_rank_sum = uint8_t(count(hand & masks.rank_planes[0]) +
+                                        2 * count(hand & masks.rank_planes[1]) +
+                                        4 * count(hand & masks.rank_planes[2]));
+        return result;
+    }
+}
+
+const std::array<uint32_t, 4> & suit_masks(Suit trump)
+{
+    return all_masks()[trump].suits;
+}
+
+HandFeatures hand_features(uint32_t hand, Suit trump)
+{
+    return extract(hand, all_masks()[trump]);
+}
+
+void hand_features(const uint32_t *hands, size_t count, Suit trump, HandFeatures *features)
+{
+    // one copy of the masks for the whole batch
+    const FeatureMasks masks = all_masks()[trump];
+    for (size_t i = 0; i < count; i++)
+    {
+        features[i] = extract(hands[i], masks);
+    }
+}
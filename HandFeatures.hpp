@@ -0,0 +1,47 @@
+#ifndef HANDFEATURES_HPP
+#define HANDFEATURES_HPP
+/* HandFeatures.hpp
+ *
+ * The hand-strength features evaluators share, for a hand and a candidate
+ * trump suit.  Every feature is a popcount of the hand against a mask
+ * built once per trump suit, so a full feature vector costs about a dozen
+ * bit operations and no loops over cards.  The trump rank sum is a
+ * weighted popcount: each trump's rank is spread over three bit planes,
+ * and the planes are counted with weights 1, 2 and 4.
+ *
+ * Hands are bitmasks of Card_to_index bits, as in GameState.
+ */
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include "Card.hpp"
+
+struct HandFeatures
+{
+    uint8_t trumps = 0;           // cards of trump, bowers included
+    uint8_t right_bower = 0;      // 1 if held
+    uint8_t left_bower = 0;       // 1 if held
+    uint8_t good_trumps = 0;      // trumps above the ten: bowers, A, K, Q
+    uint8_t off_aces = 0;         // aces of the three other suits
+    uint8_t voids = 0;            // other suits with no cards
+    uint8_t singletons = 0;       // other suits with one card
+    uint8_t trump_rank_sum = 0;   // nine 1, ten 2, ..., ace 5, left 6, right 7
+
+    bool operator==(const HandFeatures &other) const = default;
+};
+
+// EFFECTS: returns the cards of each suit when trump is trump, with the
+//          left bower moved to trump
+const std::array<uint32_t, 4> & suit_masks(Suit trump);
+
+// REQUIRES: hand only uses the low 24 bits
+// EFFECTS: returns the features of hand if trump is trump
+HandFeatures hand_features(uint32_t hand, Suit trump);
+
+// REQUIRES: hands and features hold count entries
+// MODIFIES: features
+// EFFECTS: sets features[i] to hand_features(hands[i], trump)
+void hand_features(const uint32_t *hands, size_t count, Suit trump, HandFeatures *features);
+
+#endif // HANDFEATURES_HPP
@@ -0,0 +1,100 @@
+#include "HandFeatures.hpp"
+#include "HandIndex.hpp"
+#include "unit_test_framework.hpp"
+
+#include <vector>
+
+using namespace std;
+
+static uint32_t bit(const Card &card) {
+    return uint32_t(1) << Card_to_index(card);
+}
+
+// EFFECTS: returns the features of hand worked out card by card
+static HandFeatures reference_features(uint32_t hand, Suit trump) {
+    HandFeatures result;
+    array<int, 4> suit_counts{};
+    vector<Card> trumps;
+    for (int card = 0; card < 24; card++) {
+        if (!(hand & (uint32_t(1) << card))) {
+            continue;
+        }
+        const Card c = Card_from_index(card);
+        suit_counts[c.get_suit(trump)]++;
+        if (c.is_trump(trump)) {
+            trumps.push_back(c);
+        }
+        result.right_bower += c.is_right_bower(trump);
+        result.left_bower += c.is_left_bower(trump);
+        result.good_trumps += Card_less(Card(TEN, trump), c, trump);
+        result.off_aces += c.get_rank() == ACE && c.get_suit() != trump;
+    }
+    result.trumps = uint8_t(trumps.size());
+    for (int suit = 0; suit < 4; suit++) {
+        if (suit != trump) {
+            result.voids += suit_counts[suit] == 0;
+            result.singletons += suit_counts[suit] == 1;
+        }
+    }
+    for (const Card &c : trumps) {
+        // the nine of trump is lowest, at 1
+        int rank = 1;
+        for (int other = 0; other < 24; other++) {
+            const Card o = Card_from_index(other);
+            rank += o.is_trump(trump) && Card_less(o, c, trump);
+        }
+        result.trump_rank_sum += rank;
+    }
+    return result;
+}
+
+TEST(test_features_of_a_strong_hand) {
+    const uint32_t hand = bit(Card(JACK, HEARTS)) | bit(Card(JACK, DIAMONDS)) |
+                          bit(Card(NINE, HEARTS)) | bit(Card(ACE, SPADES)) |
+                          bit(Card(KING, SPADES));
+    const HandFeatures features = hand_features(hand, HEARTS);
+    ASSERT_EQUAL(features.trumps, 3);
+    ASSERT_EQUAL(features.right_bower, 1);
+    ASSERT_EQUAL(features.left_bower, 1);
+    ASSERT_EQUAL(features.good_trumps, 2);
+    ASSERT_EQUAL(features.off_aces, 1);
+    // the left bower leaves diamonds empty
+    ASSERT_EQUAL(features.voids, 2);
+    ASSERT_EQUAL(features.singletons, 0);
+    ASSERT_EQUAL(features.trump_rank_sum, 7 + 6 + 1);
+
+    const HandFeatures as_spades = hand_features(hand, SPADES);
+    ASSERT_EQUAL(as_spades.trumps, 2);
+    ASSERT_EQUAL(as_spades.right_bower, 0);
+    ASSERT_EQUAL(as_spades.off_aces, 0);
+    ASSERT_EQUAL(as_spades.voids, 1);
+    ASSERT_EQUAL(as_spades.singletons, 1);
+    ASSERT_EQUAL(as_spades.trump_rank_sum, 5 + 4);
+}
+
+TEST(test_suit_masks_move_the_left_bower) {
+    const array<uint32_t, 4> &masks = suit_masks(CLUBS);
+    ASSERT_TRUE(masks[CLUBS] & bit(Card(JACK, SPADES)));
+    ASSERT_FALSE(masks[SPADES] & bit(Card(JACK, SPADES)));
+    ASSERT_EQUAL(__builtin_popcount(masks[CLUBS]), 7);
+    ASSERT_EQUAL(__builtin_popcount(masks[SPADES]), 5);
+    ASSERT_EQUAL(masks[SPADES] | masks[HEARTS] | masks[CLUBS] | masks[DIAMONDS], 0xFFFFFFu);
+}
+
+TEST(test_features_match_reference_for_every_hand) {
+    vector<uint32_t> hands(NUM_HANDS);
+    for (uint32_t i = 0; i < NUM_HANDS; i++) {
+        hands[i] = unrank_hand(i);
+    }
+    vector<HandFeatures> batch(NUM_HANDS);
+    for (int trump = SPADES; trump <= DIAMONDS; trump++) {
+        hand_features(hands.data(), hands.size(), Suit(trump), batch.data());
+        for (uint32_t i = 0; i < NUM_HANDS; i++) {
+            const HandFeatures expected = reference_features(hands[i], Suit(trump));
+            ASSERT_TRUE(hand_features(hands[i], Suit(trump)) == expected);
+            ASSERT_TRUE(batch[i] == expected);
+        }
+    }
+}
+
+TEST_MAIN()
@@ -0,0 +1,148 @@
+#include "HandIndex.hpp"
+#include <cassert>
+
+using namespace std;
+
+namespace
+{
+    const int NUM_CARDS = 24;
+    const int HAND_SIZE = 5;
+    const int NUM_PLAYERS = 4;
+
+    struct BinomialTable
+    {
+        uint64_t values[NUM_CARDS + 1][NUM_CARDS + 1];
+
+        constexpr BinomialTable() : values{}
+        {
+            for (int n = 0; n <= NUM_CARDS; n++)
+            {
+                values[n][0] = 1;
+                for (int k = 1; k <= n; k++)
+                {
+                    values[n][k] = values[n - 1][k - 1] + (k <= n - 1 ? values[n - 1][k] : 0);
+                }
+            }
+        }
+    };
+
+    constexpr BinomialTable BINOMIAL;
+
+    static_assert(BINOMIAL.values[NUM_CARDS][HAND_SIZE] == NUM_HANDS, "C(24, 5) hands");
+    static_assert(NUM_DEALS < (uint64_t(1) << DEAL_RANK_BITS), "deal ranks fit");
+
+    // EFFECTS: returns cards renumbered among the cards in available, so
+    //          the lowest available card becomes card 0
+    uint32_t compress(uint32_t cards, uint32_t available)
+    {
+        uint32_t result = 0;
+        for (uint32_t rest = cards; rest; rest &= rest - 1)
+        {
+            const uint32_t card = rest & -rest;
+            result |= uint32_t(1) << __builtin_popcount(available & (card - 1));
+        }
+        return result;
+    }
+
+    // EFFECTS: undoes compress
+    uint32_t expand(uint32_t cards, uint32_t available)
+    {
+        uint32_t result = 0;
+        int position = 0;
+        for (uint32_t rest = available; rest; rest &= rest - 1, position++)
+        {
+            if (cards & (uint32_t(1) << position))
+            {
+                result |= rest & -rest;
+            }
+        }
+        return result;
+    }
+}
+
+uint64_t binomial(int n, int k)
+{
+    assert(0 <= k && k <= n && n <= NUM_CARDS);
+    return BINOMIAL.values[n][k];
+}
+
+uint64_t rank_cards(uint32_t cards)
+{
+    assert(cards < (uint32_t(1) << NUM_CARDS));
+    uint64_t rank = 0;
+    int k = 1;
+    for (; cards; cards &= cards - 1, k++)
+    {
+        rank += BINOMIAL.values[__builtin_ctz(cards)][k];
+    }
+    return rank;
+}
+
+uint32_t unrank_cards(uint64_t rank, int k)
+{
+    assert(0 <= k && k <= NUM_CARDS && rank < BINOMIAL.values[NUM_CARDS][k]);
+    // take the highest card first: the largest c with C(c, k) <= rank
+    uint32_t cards = 0;
+    int card = NUM_CARDS - 1;
+    for (; k > 0; k--)
+    {
+        while (BINOMIAL.values[card][k] > rank)
+        {
+            card--;
+        }
+        cards |= uint32_t(1) << card;
+        rank -= BINOMIAL.values[card][k];
+        card--;
+    }
+    return cards;
+}
+
+uint32_t rank_hand(uint32_t hand)
+{
+    assert(__builtin_popcount(hand) == HAND_SIZE);
+    return uint32_t(rank_cards(hand));
+}
+
+uint32_t unrank_hand(uint32_t rank)
+{
+    return unrank_cards(rank, HAND_SIZE);
+}
+
+uint64_t rank_deal(const array<uint32_t, 4> &hands, int upcard)
+{
+    assert(0 <= upcard && upcard < NUM_CARDS);
+    uint32_t available = ((uint32_t(1) << NUM_CARDS) - 1) & ~(uint32_t(1) << upcard);
+    uint64_t rank = uint64_t(upcard);
+    int left = NUM_CARDS - 1;
+    for (int player = 0; player < NUM_PLAYERS; player++)
+    {
+        assert(__builtin_popcount(hands[player]) == HAND_SIZE);
+        assert((hands[player] & ~available) == 0);
+        rank = rank * BINOMIAL.values[left][HAND_SIZE] +
+               rank_cards(compress(hands[player], available));
+        available &= ~hands[player];
+        left -= HAND_SIZE;
+    }
+    return rank;
+}
+
+void unrank_deal(uint64_t rank, array<uint32_t, 4> &hands, int &upcard)
+{
+    assert(rank < NUM_DEALS);
+    // peel the mixed-radix digits off from the last hand back
+    array<uint64_t, NUM_PLAYERS> digits;
+    for (int player = NUM_PLAYERS - 1; player >= 0; player--)
+    {
+        const uint64_t radix = BINOMIAL.values[NUM_CARDS - 1 - HAND_SIZE * player][HAND_SIZE];
+        digits[player] = rank % radix;
+        rank /= radix;
+    }
+    upcard = int(rank);
+
+    uint32_t available = ((uint32_t(1) << NUM_CARDS) - 1) & ~(uint32_t(1) << upcard);
+    for (int player = 0; player < NUM_PLAYERS; player++)
+    {
+        hands[player] = expand(unrank_cards(digits[player], HAND_SIZE), available);
+        available &= ~hands[player];
+    }
+}
@@ -0,0 +1,56 @@
+#ifndef HANDINDEX_HPP
+#define HANDINDEX_HPP
+/* HandIndex.hpp
+ *
+ * Dense perfect-hash indices for sets of cards, using the combinatorial
+ * number system: a set {c1 < c2 < ... < ck} of card indices has rank
+ * C(c1, 1) + C(c2, 2) + ... + C(ck, k), which numbers the k-card sets
+ * 0, 1, 2, ... with no gaps.  Cards are bits of Card_to_index, as in
+ * GameState.
+ *
+ * A full deal (the upcard, then four hands each ranked among the cards
+ * still left) packs into fewer than 49 bits, so a deal fits in 7 bytes
+ * instead of 24 lines of pack text.
+ */
+
+#include <array>
+#include <cstdint>
+
+// Number of 5-card hands from the 24-card pack, C(24, 5)
+const uint32_t NUM_HANDS = 42504;
+
+// Number of deals: 24 upcards times C(23,5) C(18,5) C(13,5) C(8,5) hands
+const uint64_t NUM_DEALS = 24ull * 33649 * 8568 * 1287 * 56;
+const int DEAL_RANK_BITS = 49;
+
+// REQUIRES: 0 <= k <= n <= 24
+// EFFECTS: returns n choose k
+uint64_t binomial(int n, int k);
+
+// REQUIRES: cards only uses the low 24 bits
+// EFFECTS: returns the rank of cards among the sets of its size, in
+//          [0, C(24, popcount(cards)))
+uint64_t rank_cards(uint32_t cards);
+
+// REQUIRES: 0 <= k <= 24, rank < C(24, k)
+// EFFECTS: returns the k-card set with that rank
+uint32_t unrank_cards(uint64_t rank, int k);
+
+// REQUIRES: hand holds exactly 5 cards
+// EFFECTS: returns the hand's index in [0, NUM_HANDS)
+uint32_t rank_hand(uint32_t hand);
+
+// REQUIRES: rank < NUM_HANDS
+// EFFECTS: returns the hand with that index
+uint32_t unrank_hand(uint32_t rank);
+
+// REQUIRES: hands are disjoint 5-card sets and upcard is in none of them
+// EFFECTS: returns the deal's index in [0, NUM_DEALS)
+uint64_t rank_deal(const std::array<uint32_t, 4> &hands, int upcard);
+
+// REQUIRES: rank < NUM_DEALS
+// MODIFIES: hands, upcard
+// EFFECTS: sets hands and upcard to the deal with that index
+void unrank_deal(uint64_t rank, std::array<uint32_t, 4> &hands, int &upcard);
+
+#endif // HANDINDEX_HPP
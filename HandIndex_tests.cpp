@@ -0,0 +1,74 @@
+#include "HandIndex.hpp"
+#include "DealPipeline.hpp"
+#include "unit_test_framework.hpp"
+
+#include <vector>
+
+using namespace std;
+
+TEST(test_every_hand_round_trips)
+{
+    for (uint32_t rank = 0; rank < NUM_HANDS; rank++)
+    {
+        const uint32_t hand = unrank_hand(rank);
+        ASSERT_EQUAL(__builtin_popcount(hand), 5);
+        ASSERT_TRUE(hand < (uint32_t(1) << 24));
+        ASSERT_EQUAL(rank_hand(hand), rank);
+    }
+    ASSERT_EQUAL(rank_hand(0x1f), 0u);
+    ASSERT_EQUAL(rank_hand(0xf80000), NUM_HANDS - 1);
+}
+
+TEST(test_ranks_of_other_sizes)
+{
+    ASSERT_EQUAL(binomial(24, 3), uint64_t(2024));
+    ASSERT_EQUAL(rank_cards(0), uint64_t(0));
+    for (int k = 0; k <= 24; k += 4)
+    {
+        for (uint64_t rank = 0; rank < binomial(24, k); rank += 1 + binomial(24, k) / 100)
+        {
+            const uint32_t cards = unrank_cards(rank, k);
+            ASSERT_EQUAL(__builtin_popcount(cards), k);
+            ASSERT_EQUAL(rank_cards(cards), rank);
+        }
+    }
+}
+
+TEST(test_deals_round_trip)
+{
+    vector<DealRecord> deals(2000);
+    generate_deals(3, 0, int(deals.size()), deals.data());
+    for (const DealRecord &deal : deals)
+    {
+        const uint64_t rank = rank_deal(deal.hands, deal.upcard);
+        ASSERT_TRUE(rank < NUM_DEALS);
+        array<uint32_t, 4> hands;
+        int upcard = -1;
+        unrank_deal(rank, hands, upcard);
+        ASSERT_EQUAL(upcard, int(deal.upcard));
+        for (int player = 0; player < 4; player++)
+        {
+            ASSERT_EQUAL(hands[player], deal.hands[player]);
+        }
+    }
+}
+
+TEST(test_deal_rank_extremes)
+{
+    for (uint64_t rank : {uint64_t(0), uint64_t(1), NUM_DEALS / 2, NUM_DEALS - 1})
+    {
+        array<uint32_t, 4> hands;
+        int upcard = -1;
+        unrank_deal(rank, hands, upcard);
+        uint32_t dealt = uint32_t(1) << upcard;
+        for (uint32_t hand : hands)
+        {
+            ASSERT_EQUAL(__builtin_popcount(hand), 5);
+            ASSERT_EQUAL(hand & dealt, 0u);
+            dealt |= hand;
+        }
+        ASSERT_EQUAL(rank_deal(hands, upcard), rank);
+    }
+}
+
+TEST_MAIN()
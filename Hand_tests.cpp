@@ -0,0 +1,117 @@
+#include "Hand.hpp"
+#include "unit_test_framework.hpp"
+
+#include <sstream>
+#include <vector>
+
+using namespace std;
+
+static const array<string, 4> NAMES = {"Edsger", "Fran", "Gabriel", "Herb"};
+
+TEST(test_hand_deals_left_of_dealer) {
+    Pack pack;
+    Hand::Deal cards;
+    const Card upcard = Hand::deal(pack, 3, cards);
+
+    // player 0 is left of the dealer and takes the first three cards
+    Pack check;
+    ASSERT_EQUAL(cards[0][0], check.deal_one());
+    ASSERT_EQUAL(cards[0][1], check.deal_one());
+    ASSERT_EQUAL(cards[0][2], check.deal_one());
+    ASSERT_EQUAL(cards[1][0], check.deal_one());
+    for (int i = 0; i < 16; i++) {
+        check.deal_one();
+    }
+    ASSERT_EQUAL(upcard, check.deal_one());
+}
+
+TEST(test_hand_bidding_turns) {
+    vector<PlayerEvent> events;
+    Hand hand([&events](const PlayerEvent &event) { events.push_back(event); });
+    hand.start(1, Card(NINE, HEARTS));
+    ASSERT_EQUAL(events.size(), 1u);
+    ASSERT_EQUAL(events[0].type, PlayerEvent::HAND_STARTED);
+    ASSERT_EQUAL(events[0].player, 1);
+
+    // everyone passes in round one, starting left of the dealer
+    for (int k = 0; k < Hand::num_players; k++) {
+        ASSERT_EQUAL(hand.get_round(), 1);
+        ASSERT_EQUAL(hand.to_act(), (2 + k) % Hand::num_players);
+        hand.bid(false, HEARTS);
+    }
+    ASSERT_EQUAL(hand.get_round(), 2);
+    ASSERT_EQUAL(hand.to_act(), 2);
+    hand.bid(false, HEARTS);
+    hand.bid(true, SPADES);
+
+    // a round-two order skips the discard, and the dealer's left leads
+    ASSERT_EQUAL(hand.get_phase(), Hand::PLAY);
+    ASSERT_EQUAL(hand.get_maker(), 3);
+    ASSERT_EQUAL(hand.get_trump(), SPADES);
+    ASSERT_EQUAL(hand.to_act(), 2);
+    ASSERT_EQUAL(events.back().type, PlayerEvent::ORDERED_UP);
+    ASSERT_EQUAL(events.back().round, 2);
+}
+
+TEST(test_hand_tricks_and_score) {
+    vector<PlayerEvent> events;
+    ostringstream narration;
+    Hand hand([&events](const PlayerEvent &event) { events.push_back(event); });
+    hand.narrate(narration, NAMES);
+    hand.start(0, Card(NINE, SPADES));
+    hand.bid(false, SPADES);
+    hand.bid(true, SPADES);
+    ASSERT_EQUAL(hand.get_phase(), Hand::DISCARD);
+    ASSERT_EQUAL(hand.to_act(), 0);
+    hand.discard();
+
+    // player 1 leads every trick and player 2 takes each with a trump
+    const Rank ranks[] = {NINE, TEN, QUEEN, KING, ACE};
+    for (Rank rank : ranks) {
+        ASSERT_EQUAL(hand.to_act(), rank == NINE ? 1 : 2);
+        const int leader = hand.to_act();
+        for (int i = 0; i < Hand::num_players; i++) {
+            const int seat = (leader + i) % Hand::num_players;
+            const Card card(rank, seat == 2 ? SPADES : seat == 0 ? CLUBS : HEARTS);
+            hand.play(card);
+            if (i == 0) {
+                ASSERT_EQUAL(hand.get_led_card(), card);
+            }
+        }
+        ASSERT_EQUAL(events.back().type, PlayerEvent::TRICK_WON);
+        ASSERT_EQUAL(events.back().player, 2);
+    }
+    ASSERT_EQUAL(hand.get_phase(), Hand::OVER);
+    ASSERT_EQUAL(hand.get_tricks(0), 5);
+
+    array<int, Hand::num_teams> points = {1, 3};
+    hand.score(points);
+    ASSERT_EQUAL(points[0], 3);
+    ASSERT_EQUAL(points[1], 3);
+    const string text = narration.str();
+    ASSERT_TRUE(text.find("Edsger deals\n") == 0);
+    ASSERT_TRUE(text.find("Gabriel takes the trick\n") != string::npos);
+    ASSERT_TRUE(text.find("Edsger and Gabriel win the hand\nmarch!\n") != string::npos);
+}
+
+TEST(test_hand_euchre) {
+    Hand hand([](const PlayerEvent &) {});
+    hand.start(0, Card(NINE, SPADES));
+    hand.bid(true, SPADES);
+    hand.discard();
+
+    // player 1 ordered up, and the dealer's team takes every trick take every trick
+    for (int trick = 0; trick < Player::MAX_HAND_SIZE; trick++) {
+        const int leader = hand.to_act();
+        const int winner = leader % 2 == 0 ? leader : (leader + 1) % Hand::num_players;
+        for (int i = 0; i < Hand::num_players; i++) {
+            const int seat = (leader + i) % Hand::num_players;
+            hand.play(Card(ACE, seat == winner ? SPADES : HEARTS));
+        }
+    }
+    int team;
+    ASSERT_EQUAL(hand.get_points(team), 2);
+    ASSERT_EQUAL(team, 0);
+}
+
+TEST_MAIN()
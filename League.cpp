@@ -0,0 +1,436 @@
+#include "League.hpp"
+#include "Game.hpp"
+#include "Random.hpp"
+#include <cassert>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <mutex>
+#include <sstream>
+
+using namespace std;
+
+// floor on the variance estimate, so identical games do not divide by zero
+static const double MIN_HAND_VARIANCE = 1e-6;
+
+Sprt::Sprt(double delta, double alpha, double beta)
+    : delta(delta), upper(log((1 - beta) / alpha)), lower(log(beta / (1 - alpha))),
+      num_games(0), hands(0), margin_sum(0), margin_sum_sq(0) {}
+
+void Sprt::add_game(int game_hands, int margin, int margin_sq)
+{
+    num_games++;
+    hands += game_hands;
+    margin_sum += margin;
+    margin_sum_sq += margin_sq;
+}
+
+double Sprt::hand_variance() const
+{
+    if (hands < 2)
+    {
+        return MIN_HAND_VARIANCE;
+    }
+    const double v = (margin_sum_sq - double(margin_sum) * margin_sum / hands) / (hands - 1);
+    return max(v, MIN_HAND_VARIANCE);
+}
+
+double Sprt::log_likelihood_ratio(int sign) const
+{
+    const double mean = sign > 0 ? delta : -delta;
+    return (mean * margin_sum - mean * mean * hands / 2) / hand_variance();
+}
+
+Sprt::Verdict Sprt::verdict() const
+{
+    const double plus = log_likelihood_ratio(1);
+    const double minus = log_likelihood_ratio(-1);
+    if (plus >= upper)
+    {
+        return FIRST_BETTER;
+    }
+    if (minus >= upper)
+    {
+        return SECOND_BETTER;
+    }
+    if (plus <= lower && minus <= lower)
+    {
+        return EQUAL;
+    }
+    return UNDECIDED;
+}
+
+int Sprt::games() const
+{
+    return num_games;
+}
+
+League::League(const std::vector<std::string> &strategies_in, const LeagueOptions &options_in)
+    : options(options_in), strategies(strategies_in)
+{
+    // entrants entered more than once are told apart by their position
+    for (size_t i = 0; i < strategies.size(); i++)
+    {
+        assert(Player_strategy_exists(strategies[i]));
+        assert(!Player_strategy_is_interactive(strategies[i]));
+        int copies = 0;
+        for (size_t j = 0; j < strategies.size(); j++)
+        {
+            copies += strategies[j] == strategies[i];
+        }
+        string name = strategies[i];
+        if (copies > 1)
+        {
+            name += "#" + to_string(i + 1);
+        }
+        entrant_names.push_back(name);
+        ratings.add_strategy(name);
+    }
+
+    // a partnership is any unordered pair of entrants, including an
+    // entrant partnered with a copy of itself
+    for (int i = 0; i < int(strategies.size()); i++)
+    {
+        for (int j = i; j < int(strategies.size()); j++)
+        {
+            partnerships.push_back({i, j});
+        }
+    }
+    for (int i = 0; i < num_partnerships(); i++)
+    {
+        for (int j = i + 1; j < num_partnerships(); j++)
+        {
+            matches.push_back({i, j});
+        }
+    }
+    win_counts.assign(num_partnerships(), std::vector<int>(num_partnerships(), 0));
+}
+
+int League::num_partnerships() const
+{
+    return int(partnerships.size());
+}
+
+int League::num_matches() const
+{
+    return int(matches.size());
+}
+
+std::string League::partnership_name(int partnership) const
+{
+    return entrant_names[partnerships[partnership][0]] + "+" +
+           entrant_names[partnerships[partnership][1]];
+}
+
+std::vector<League::Fixture> League::make_fixtures() const
+{
+    // every seating of each match: which partnership sits in seats 0 and 2,
+    // and which partner of each sits first
+    std::vector<std::vector<std::array<int, 4>>> seatings(matches.size());
+    for (size_t m = 0; m < matches.size(); m++)
+    {
+        for (int swap = 0; swap < 2; swap++)
+        {
+            const std::array<int, 2> &a = partnerships[swap ? matches[m].second : matches[m].first];
+            const std::array<int, 2> &b = partnerships[swap ? matches[m].first : matches[m].second];
+            for (int a_order = 0; a_order < (a[0] == a[1] ? 1 : 2); a_order++)
+            {
+                for (int b_order = 0; b_order < (b[0] == b[1] ? 1 : 2); b_order++)
+                {
+                    seatings[m].push_back({a[a_order], b[b_order], a[1 - a_order], b[1 - b_order]});
+                }
+            }
+        }
+    }
+
+    // game g of every match is played before game g + 1 of any match, and
+    // game g of every match uses the same deals
+    std::vector<Fixture> fixtures;
+    fixtures.reserve(size_t(options.games_per_match) * matches.size());
+    for (int g = 0; g < options.games_per_match; g++)
+    {
+        for (size_t m = 0; m < matches.size(); m++)
+        {
+            fixtures.push_back({int(m), g, seatings[m][g % seatings[m].size()],
+                                derive_seed(options.seed, g)});
+        }
+    }
+    return fixtures;
+}
+
+void League::run(ThreadPool &pool)
+{
+    const std::vector<Fixture> fixtures = make_fixtures();
+    std::vector<GameRecord> records(fixtures.size());
+    std::vector<HandTotals> hands(fixtures.size());
+
+    // With the sequential test on, each match is judged on its games in
+    // order as they finish, and stops at the first game that settles it.
+    // Games after that are skipped, or ignored if already running, so the
+    // result still does not depend on the number of threads.
+    const bool sequential = options.sprt_delta > 0;
+    std::vector<Sprt> tests(matches.size(),
+                            Sprt(sequential ? options.sprt_delta : 1, options.sprt_alpha,
+                                 options.sprt_beta));
+    std::vector<int> games_used(matches.size(), options.games_per_match);
+    std::vector<std::vector<int>> finished(matches.size(),
+                                           std::vector<int>(options.games_per_match, -1));
+    std::vector<int> next_game(matches.size(), 0);
+    std::mutex mutex;
+
+    pool.parallel_for(int(fixtures.size()), [&](int, int i) {
+        const Fixture &fixture = fixtures[i];
+        if (sequential)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (fixture.game >= games_used[fixture.match])
+            {
+                return;
+            }
+        }
+
+        std::array<std::string, Game::num_players> names;
+        std::array<std::string, Game::num_players> seat_strategies;
+        for (int seat = 0; seat < Game::num_players; seat++)
+        {
+            names[seat] = entrant_names[fixture.seats[seat]];
+            seat_strategies[seat] = strategies[fixture.seats[seat]];
+        }
+
+        istringstream no_pack;
+        ostream quiet(nullptr);
+        Game game(no_pack, false, options.points_to_win, names, seat_strategies, quiet);
+        game.use_random_shuffle(fixture.seed);
+        HandTotals &totals = hands[i];
+        while (!game.is_over())
+        {
+            const int before = game.get_points(TEAM_ZERO_AND_TWO) -
+                               game.get_points(TEAM_ONE_AND_THREE);
+            game.play_next_hand();
+            const int margin = game.get_points(TEAM_ZERO_AND_TWO) -
+                               game.get_points(TEAM_ONE_AND_THREE) - before;
+            totals.hands++;
+            totals.margin += margin;
+            totals.margin_sq += margin * margin;
+        }
+
+        GameRecord &record = records[i];
+        for (int seat = 0; seat < Game::num_players; seat++)
+        {
+            record.strategies[seat] = uint16_t(fixture.seats[seat]);
+        }
+        record.points = {uint8_t(game.get_points(TEAM_ZERO_AND_TWO)),
+                         uint8_t(game.get_points(TEAM_ONE_AND_THREE))};
+
+        if (sequential)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            const int m = fixture.match;
+            finished[m][fixture.game] = i;
+            while (next_game[m] < games_used[m] && finished[m][next_game[m]] >= 0)
+            {
+                const int j = finished[m][next_game[m]];
+                const int sign = first_in_team_zero(fixtures[j]) ? 1 : -1;
+                tests[m].add_game(hands[j].hands, sign * hands[j].margin, hands[j].margin_sq);
+                next_game[m]++;
+                if (next_game[m] >= options.sprt_min_games &&
+                    tests[m].verdict() != Sprt::UNDECIDED)
+                {
+                    games_used[m] = next_game[m];
+                }
+            }
+        }
+    });
+
+    // tally in fixture order so results are the same for any thread count
+    for (size_t i = 0; i < fixtures.size(); i++)
+    {
+        if (fixtures[i].game >= games_used[fixtures[i].match])
+        {
+            continue;
+        }
+        const Match &match = matches[fixtures[i].match];
+        const GameRecord &record = records[i];
+        const int team_zero_wins = record.points[0] >= record.points[1];
+        if (team_zero_wins == first_in_team_zero(fixtures[i]))
+        {
+            win_counts[match.first][match.second]++;
+        }
+        else
+        {
+            win_counts[match.second][match.first]++;
+        }
+        ratings.update(record);
+    }
+    for (size_t m = 0; m < matches.size(); m++)
+    {
+        matches[m].verdict = sequential ? tests[m].verdict() : Sprt::UNDECIDED;
+    }
+}
+
+bool League::first_in_team_zero(const Fixture &fixture) const
+{
+    const std::array<int, 2> &first = partnerships[matches[fixture.match].first];
+    return (fixture.seats[0] == first[0] && fixture.seats[2] == first[1]) ||
+           (fixture.seats[0] == first[1] && fixture.seats[2] == first[0]);
+}
+
+int League::wins(int row, int col) const
+{
+    return win_counts[row][col];
+}
+
+Sprt::Verdict League::verdict(int row, int col) const
+{
+    for (const Match &match : matches)
+    {
+        if (match.first == row && match.second == col)
+        {
+            return match.verdict;
+        }
+        if (match.first == col && match.second == row)
+        {
+            switch (match.verdict)
+            {
+            case Sprt::FIRST_BETTER:
+                return Sprt::SECOND_BETTER;
+            case Sprt::SECOND_BETTER:
+                return Sprt::FIRST_BETTER;
+            default:
+                return match.verdict;
+            }
+        }
+    }
+    return Sprt::UNDECIDED;
+}
+
+const RatingTable & League::get_ratings() const
+{
+    return ratings;
+}
+
+void League::print(std::ostream &os) const
+{
+    size_t width = 8;
+    for (int i = 0; i < num_partnerships(); i++)
+    {
+        width = max(width, partnership_name(i).size() + 2);
+    }
+
+    os << setw(int(width)) << "";
+    for (int col = 0; col < num_partnerships(); col++)
+    {
+        os << setw(int(width)) << partnership_name(col);
+    }
+    os << std::endl;
+    for (int row = 0; row < num_partnerships(); row++)
+    {
+        os << setw(int(width)) << partnership_name(row);
+        for (int col = 0; col < num_partnerships(); col++)
+        {
+            const int games = wins(row, col) + wins(col, row);
+            if (row == col || games == 0)
+            {
+                os << setw(int(width)) << "-";
+            }
+            else
+            {
+                os << setw(int(width)) << fixed << setprecision(1)
+                   << 100.0 * wins(row, col) / games;
+            }
+        }
+        os << std::endl;
+    }
+    os << std::endl;
+
+    if (options.sprt_delta > 0)
+    {
+        os << "Sequential test at " << setprecision(2) << options.sprt_delta
+           << " points per hand" << std::endl;
+        for (const Match &match : matches)
+        {
+            const string first = partnership_name(match.first);
+            const string second = partnership_name(match.second);
+            os << first << " vs " << second << ": ";
+            switch (match.verdict)
+            {
+            case Sprt::FIRST_BETTER:
+                os << first << " better";
+                break;
+            case Sprt::SECOND_BETTER:
+                os << second << " better";
+                break;
+            case Sprt::EQUAL:
+                os << "even";
+                break;
+            case Sprt::UNDECIDED:
+                os << "undecided";
+                break;
+            }
+            os << " after " << wins(match.first, match.second) + wins(match.second, match.first)
+               << " games" << std::endl;
+        }
+        os << std::endl;
+    }
+    ratings.print(os);
+}
+
+static void print_league_usage()
+{
+    std::cout << "Usage: euchre.exe --league GAMES_PER_MATCH POINTS_TO_WIN "
+              << "THREADS STRATEGY1 STRATEGY2 ... [--sprt DELTA] [--sprt-alpha ALPHA]"
+              << std::endl;
+}
+
+int league_main(int argc, char **argv)
+{
+    if (argc < 6)
+    {
+        print_league_usage();
+        return 1;
+    }
+    LeagueOptions options;
+    options.games_per_match = atoi(argv[2]);
+    options.points_to_win = atoi(argv[3]);
+    const int threads = atoi(argv[4]);
+    if (options.games_per_match < 1 || options.points_to_win < 1 ||
+        options.points_to_win > 100 || threads < 0)
+    {
+        print_league_usage();
+        return 2;
+    }
+
+    std::vector<std::string> strategies;
+    for (int i = 5; i < argc; i++)
+    {
+        const std::string arg = argv[i];
+        if (arg == "--sprt" && i + 1 < argc)
+        {
+            options.sprt_delta = atof(argv[++i]);
+            continue;
+        }
+        if (arg == "--sprt-alpha" && i + 1 < argc)
+        {
+            options.sprt_alpha = options.sprt_beta = atof(argv[++i]);
+            continue;
+        }
+        if (!Player_strategy_exists(argv[i]) || Player_strategy_is_interactive(argv[i]))
+        {
+            std::cout << "Unknown or interactive strategy " << argv[i] << std::endl;
+            return 3;
+        }
+        strategies.push_back(argv[i]);
+    }
+
+    if (options.sprt_delta < 0 || options.sprt_alpha <= 0 || options.sprt_alpha >= 0.5)
+    {
+        print_league_usage();
+        return 2;
+    }
+
+    League league(strategies, options);
+    ThreadPool pool(threads == 0 ? default_thread_count() : threads);
+    league.run(pool);
+    league.print(std::cout);
+    return 0;
+}
@@ -0,0 +1,165 @@
+#ifndef LEAGUE_HPP
+#define LEAGUE_HPP
+/* League.hpp
+ *
+ * Round-robin league between strategies.  Every pair of entrants forms a
+ * partnership, and every partnership plays every other one for a fixed
+ * number of games, rotating through all seatings.  With a sequential test
+ * enabled, a match stops as soon as its result is clear.
+ */
+
+#include <array>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "Rating.hpp"
+#include "ThreadPool.hpp"
+
+struct LeagueOptions
+{
+    int games_per_match = 100;
+    int points_to_win = 10;
+    uint64_t seed = 0;
+    double sprt_delta = 0;      // points per hand; 0 plays every game
+    double sprt_alpha = 0.05;   // chance of a false verdict either way
+    double sprt_beta = 0.05;    // chance of missing a real difference
+    int sprt_min_games = 8;     // games before a match may stop
+};
+
+// Sequential probability ratio test on the points per hand by which one
+// side beats the other.  Two tests run side by side, mean +delta against
+// 0 and mean -delta against 0, treating hands as independent normal draws
+// whose variance is estimated from the hands so far.
+class Sprt
+{
+public:
+    enum Verdict
+    {
+        UNDECIDED,
+        FIRST_BETTER,
+        SECOND_BETTER,
+        EQUAL,
+    };
+
+    // REQUIRES: delta > 0, 0 < alpha < 1, 0 < beta < 1
+    Sprt(double delta, double alpha, double beta);
+
+    // MODIFIES: *this
+    // EFFECTS: Adds a game of hands hands, in which the first side's margin
+    //          per hand (negative when the other side scored) summed to
+    //          margin and its squares summed to margin_sq
+    void add_game(int hands, int margin, int margin_sq);
+
+    // EFFECTS: returns the log likelihood ratio of a +delta (sign > 0) or
+    //          -delta (sign < 0) advantage against none
+    double log_likelihood_ratio(int sign) const;
+
+    // EFFECTS: returns the verdict so far
+    Verdict verdict() const;
+
+    // EFFECTS: returns the number of games added
+    int games() const;
+
+private:
+    double delta;
+    double upper;  // accept the alternative at or above
+    double lower;  // accept no advantage at or below
+    int num_games;
+    long hands;
+    long margin_sum;
+    long margin_sum_sq;
+
+    // EFFECTS: returns the estimated variance of one hand's margin
+    double hand_variance() const;
+};
+
+class League
+{
+public:
+    // REQUIRES: every strategy is a non-interactive Player_factory strategy
+    // EFFECTS: Creates a league between entrants with the given strategies.
+    //          The same strategy may be entered more than once.
+    League(const std::vector<std::string> &strategies, const LeagueOptions &options);
+
+    // EFFECTS: returns the number of partnerships
+    int num_partnerships() const;
+
+    // EFFECTS: returns the number of matches between partnerships
+    int num_matches() const;
+
+    // EFFECTS: returns the name of a partnership, for example "Simple+Simple"
+    std::string partnership_name(int partnership) const;
+
+    // EFFECTS: Plays every game of every match on pool.  Games are
+    //          interleaved across matches and handed out one at a time, so
+    //          slow matches run alongside fast ones until all are done.
+    //          Results do not depend on the number of threads.
+    void run(ThreadPool &pool);
+
+    // REQUIRES: run() has been called
+    // EFFECTS: returns the number of games partnership row won against col
+    int wins(int row, int col) const;
+
+    // REQUIRES: run() has been called
+    // EFFECTS: returns the sequential test's verdict on the match between
+    //          partnerships row and col, from row's side
+    Sprt::Verdict verdict(int row, int col) const;
+
+    // REQUIRES: run() has been called
+    // EFFECTS: returns the ratings of the entrants
+    const RatingTable & get_ratings() const;
+
+    // REQUIRES: run() has been called
+    // EFFECTS: Prints the cross table of win percentages, row against
+    //          column, followed by the entrants' ratings
+    void print(std::ostream &os) const;
+
+private:
+    struct Match
+    {
+        int first;  // partnership indices
+        int second;
+        Sprt::Verdict verdict = Sprt::UNDECIDED;
+    };
+
+    // One game to be played: entrant in each seat and the deal seed
+    struct Fixture
+    {
+        int match;
+        int game;
+        std::array<int, 4> seats;
+        uint64_t seed;
+    };
+
+    // Team zero's margin in each hand of a game, summed
+    struct HandTotals
+    {
+        int hands = 0;
+        int margin = 0;
+        int margin_sq = 0;
+    };
+
+    LeagueOptions options;
+    std::vector<std::string> strategies;           // strategy of each entrant
+    std::vector<std::string> entrant_names;
+    std::vector<std::array<int, 2>> partnerships;  // entrants in each partnership
+    std::vector<Match> matches;
+    std::vector<std::vector<int>> win_counts;      // [row][col]
+    RatingTable ratings;
+
+    // EFFECTS: returns every fixture of the league in playing order
+    std::vector<Fixture> make_fixtures() const;
+
+    // EFFECTS: returns true if the match's first partnership sits in seats
+    //          0 and 2 of fixture
+    bool first_in_team_zero(const Fixture &fixture) const;
+};
+
+// EFFECTS: Runs a league from command line arguments
+//          GAMES_PER_MATCH POINTS_TO_WIN THREADS STRATEGY... [--sprt DELTA]
+//          [--sprt-alpha ALPHA] and prints the results.  Returns the
+//          process exit status.
+int league_main(int argc, char **argv);
+
+#endif // LEAGUE_HPP
@@ -0,0 +1,89 @@
+#include "League.hpp"
+#include "unit_test_framework.hpp"
+
+using namespace std;
+
+TEST(test_league_pairings) {
+    LeagueOptions options;
+    options.games_per_match = 4;
+    League league({"Simple", "Simple", "Simple"}, options);
+    // 6 partnerships: three of an entrant with itself, three mixed
+    ASSERT_EQUAL(league.num_partnerships(), 6);
+    ASSERT_EQUAL(league.num_matches(), 15);
+    ASSERT_EQUAL(league.partnership_name(1), "Simple#1+Simple#2");
+}
+
+TEST(test_league_results_independent_of_threads) {
+    LeagueOptions options;
+    options.games_per_match = 8;
+    options.points_to_win = 3;
+    League one(vector<string>{"Simple", "Simple"}, options);
+    League three(vector<string>{"Simple", "Simple"}, options);
+    ThreadPool single(1);
+    ThreadPool pool(3);
+    one.run(single);
+    three.run(pool);
+
+    int total = 0;
+    for (int row = 0; row < one.num_partnerships(); row++) {
+        for (int col = 0; col < one.num_partnerships(); col++) {
+            ASSERT_EQUAL(one.wins(row, col), three.wins(row, col));
+            total += one.wins(row, col);
+        }
+    }
+    ASSERT_EQUAL(total, 8 * one.num_matches());
+    ASSERT_EQUAL(one.get_ratings().get_rating(0).games, three.get_ratings().get_rating(0).games);
+}
+
+TEST(test_sprt_verdicts) {
+    Sprt undecided(0.25, 0.05, 0.05);
+    ASSERT_EQUAL(undecided.verdict(), Sprt::UNDECIDED);
+
+    // scoring six points net over ten hands every game
+    Sprt better(0.25, 0.05, 0.05);
+    for (int g = 0; g < 20 && better.verdict() == Sprt::UNDECIDED; g++) {
+        better.add_game(10, 6, 12);
+    }
+    ASSERT_EQUAL(better.verdict(), Sprt::FIRST_BETTER);
+
+    Sprt worse(0.25, 0.05, 0.05);
+    for (int g = 0; g < 20 && worse.verdict() == Sprt::UNDECIDED; g++) {
+        worse.add_game(10, -6, 12);
+    }
+    ASSERT_EQUAL(worse.verdict(), Sprt::SECOND_BETTER);
+
+    // games that are nearly even
+    Sprt even(0.5, 0.05, 0.05);
+    for (int g = 0; g < 200 && even.verdict() == Sprt::UNDECIDED; g++) {
+        even.add_game(12, g % 2 ? 1 : -1, 15);
+    }
+    ASSERT_EQUAL(even.verdict(), Sprt::EQUAL);
+    ASSERT_TRUE(even.games() < 200);
+}
+
+TEST(test_league_sprt_stops_early) {
+    LeagueOptions options;
+    options.games_per_match = 400;
+    options.points_to_win = 5;
+    options.sprt_delta = 0.5;
+    League one(vector<string>{"Simple", "Simple"}, options);
+    League three(vector<string>{"Simple", "Simple"}, options);
+    ThreadPool single(1);
+    ThreadPool pool(3);
+    one.run(single);
+    three.run(pool);
+
+    int total = 0;
+    for (int row = 0; row < one.num_partnerships(); row++) {
+        for (int col = 0; col < one.num_partnerships(); col++) {
+            ASSERT_EQUAL(one.wins(row, col), three.wins(row, col));
+            ASSERT_EQUAL(one.verdict(row, col), three.verdict(row, col));
+            total += one.wins(row, col);
+        }
+    }
+    // identical strategies: every match should settle as even, early
+    ASSERT_TRUE(total < 400 * one.num_matches() / 2);
+    ASSERT_EQUAL(one.verdict(0, 1), Sprt::EQUAL);
+}
+
+TEST_MAIN()
@@ -0,0 +1,338 @@
+#include "Learned.hpp"
+#include "HandFeatures.hpp"
+#include <array>
+#include <cassert>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+
+using namespace std;
+
+namespace
+{
+    const int NUM_CARDS = 24;
+    const int NUM_SUITS = 4;
+    const int MAX_OPTIONS = 6;
+    const float MAX_TRUMP_RANK = 7.0f;
+
+    // rows are packed back to back, so they must need no padding
+    static_assert(LEARNED_INPUTS % Network::LANES == 0,
+                  "rows are a whole number of lanes");
+
+    // Bias, then one weight per input.  These are hand-set starting values,
+    // not fitted: bids are in rough expected points from ordering up, less
+    // a margin for the value of passing, and plays encode the usual card
+    // play heuristics.  Fitted weights are loaded through
+    // EUCHRE_LEARNED_MODEL.
+    const float BID_WEIGHTS[LEARNED_INPUTS + 1] = {
+        -2.374f,                                        // bias
+        0.241f, 0.239f, 0.077f, -0.042f, 0.264f,        // trumps, bowers, good,
+                                                        // off aces
+        0.124f, -0.051f, 0.592f,                        // voids, singletons,
+                                                        // trump rank sum
+        1.221f, -0.769f,                                // upcard to partner, to opponents
+        0.000f, 0.033f, 0.007f, 0.042f,                 // first lead, dealer, round two,
+                                                        // partner deals
+        0.0f, 0.0f};
+    const float PLAY_WEIGHTS[LEARNED_INPUTS + 1] = {
+        0.0f,                                   // bias
+        0.0f, 1.0f, 0.4f, -1.5f,                // trump, wins, wins last, overtakes
+        -0.4f, 0.0f,                            // strength, boss
+        -0.1f, -0.8f, 1.6f,                     // leads trump as makers, as defenders,
+                                                // leads boss
+        -0.2f, 0.7f, 0.5f,                      // leads into opponent void, partner void,
+                                                // leads trump with trump out
+        0.5f, -1.0f,                            // sheds singleton, trumps and loses
+        0.0f, 0.0f};
+
+    uint32_t bit(int card)
+    {
+        return uint32_t(1) << card;
+    }
+
+    // Card order facts for one trump suit
+    struct Tables
+    {
+        // cards each card beats
+        std::array<std::array<int8_t, NUM_CARDS>, NUM_SUITS> strength{};
+        // cards of the same suit that beat it
+        std::array<std::array<uint32_t, NUM_CARDS>, NUM_SUITS> above{};
+    };
+
+    const Tables & tables()
+    {
+        static const Tables result = [] {
+            Tables t;
+            for (int trump = 0; trump < NUM_SUITS; trump++)
+            {
+                const array<uint32_t, 4> &suits = suit_masks(Suit(trump));
+                for (int card = 0; card < NUM_CARDS; card++)
+                {
+                    const Card c = Card_from_index(card);
+                    const uint32_t suit = suits[c.get_suit(Suit(trump))];
+                    for (int other = 0; other < NUM_CARDS; other++)
+                    {
+                        if (Card_less(Card_from_index(other), c, Suit(trump)))
+                        {
+                            t.strength[trump][card]++;
+                        }
+                        else if (other != card && (suit & bit(other)))
+                        {
+                            t.above[trump][card] |= bit(other);
+                        }
+                    }
+                }
+            }
+            return t;
+        }();
+        return result;
+    }
+
+    Network linear(const float *weights)
+    {
+        Network network(LEARNED_INPUTS);
+        network.bias() = weights[0];
+        for (int i = 0; i < LEARNED_INPUTS; i++)
+        {
+            network.weight(i) = weights[i + 1];
+        }
+        return network;
+    }
+
+    // EFFECTS: returns the index of the highest score, the first on ties
+    int best(const float *scores, int count)
+    {
+        int result = 0;
+        for (int i = 1; i < count; i++)
+        {
+            if (scores[i] > scores[result])
+            {
+                result = i;
+            }
+        }
+        return result;
+    }
+
+    // EFFECTS: returns the score of holding hand with trump as trump
+    float bid_score(const LearnedModel &model, uint32_t hand, int upcard, int position,
+                    int round, Suit trump)
+    {
+        float row[LEARNED_INPUTS];
+        learned_bid_inputs(hand, upcard, position, round, trump, row);
+        return model.bid.evaluate(row);
+    }
+}
+
+const LearnedModel & learned_default_model()
+{
+    static const LearnedModel model = {linear(BID_WEIGHTS), linear(PLAY_WEIGHTS)};
+    return model;
+}
+
+const LearnedModel & learned_model()
+{
+    static const LearnedModel model = [] {
+        const char *path = getenv("EUCHRE_LEARNED_MODEL");
+        if (!path)
+        {
+            return learned_default_model();
+        }
+        LearnedModel loaded;
+        ifstream file(path);
+        if (!file || !read_learned_model(file, loaded))
+        {
+            cerr << "Error reading learned model " << path << endl;
+            exit(1);
+        }
+        return loaded;
+    }();
+    return model;
+}
+
+void write_learned_model(std::ostream &os, const LearnedModel &model)
+{
+    os << "learned 1\n";
+    model.bid.write(os);
+    model.play.write(os);
+}
+
+bool read_learned_model(std::istream &is, LearnedModel &model)
+{
+    string tag;
+    int version = 0;
+    LearnedModel result;
+    if (!(is >> tag >> version) || tag != "learned" || version != 1 ||
+        !result.bid.read(is) || !result.play.read(is) ||
+        result.bid.get_inputs() != LEARNED_INPUTS ||
+        result.play.get_inputs() != LEARNED_INPUTS)
+    {
+        return false;
+    }
+    model = result;
+    return true;
+}
+
+void learned_bid_inputs(uint32_t hand, int upcard, int position, int round, Suit trump,
+                        float *row)
+{
+    const HandFeatures features = hand_features(hand, trump);
+    const float upcard_rank = round == 1 ?
+        hand_features(bit(upcard), trump).trump_rank_sum / MAX_TRUMP_RANK : 0.0f;
+    row[0] = features.trumps;
+    row[1] = features.right_bower;
+    row[2] = features.left_bower;
+    row[3] = features.good_trumps;
+    row[4] = features.off_aces;
+    row[5] = features.voids;
+    row[6] = features.singletons;
+    row[7] = features.trump_rank_sum / MAX_TRUMP_RANK;
+    row[8] = position == 1 ? upcard_rank : 0.0f;
+    row[9] = position % 2 == 0 ? upcard_rank : 0.0f;
+    row[10] = position == 0;
+    row[11] = position == 3;
+    row[12] = round == 2;
+    row[13] = position == 1;
+    row[14] = 0.0f;
+    row[15] = 0.0f;
+}
+
+int learned_discard(const LearnedModel &model, uint32_t hand, int upcard, Suit trump)
+{
+    const uint32_t held = hand | bit(upcard);
+    int cards[MAX_OPTIONS];
+    float rows[MAX_OPTIONS * LEARNED_INPUTS];
+    int count = 0;
+    for (uint32_t rest = held; rest; rest &= rest - 1)
+    {
+        cards[count] = __builtin_ctz(rest);
+        learned_bid_inputs(held & ~bit(cards[count]), upcard, 3, 1, trump,
+                           rows + count * LEARNED_INPUTS);
+        count++;
+    }
+    float scores[MAX_OPTIONS];
+    model.bid.evaluate(rows, count, scores);
+    return cards[best(scores, count)];
+}
+
+bool learned_orders_up(const LearnedModel &model, uint32_t hand, int upcard, int position,
+                       int round, Suit &trump)
+{
+    const Suit upcard_suit = Card_from_index(upcard).get_suit();
+    if (round == 1)
+    {
+        uint32_t held = hand;
+        if (position == 3)
+        {
+            const int discard = learned_discard(model, hand, upcard, upcard_suit);
+            held = (hand | bit(upcard)) & ~bit(discard);
+        }
+        if (bid_score(model, held, upcard, position, 1, upcard_suit) <= 0.0f)
+        {
+            return false;
+        }
+        trump = upcard_suit;
+        return true;
+    }
+
+    float rows[(NUM_SUITS - 1) * LEARNED_INPUTS];
+    Suit suits[NUM_SUITS - 1];
+    int count = 0;
+    for (int suit = 0; suit < NUM_SUITS; suit++)
+    {
+        if (suit != upcard_suit)
+        {
+            suits[count] = Suit(suit);
+            learned_bid_inputs(hand, upcard, position, 2, Suit(suit),
+                               rows + count * LEARNED_INPUTS);
+            count++;
+        }
+    }
+    float scores[NUM_SUITS - 1];
+    model.bid.evaluate(rows, count, scores);
+    const int choice = best(scores, count);
+    if (scores[choice] <= 0.0f && position != 3)
+    {
+        return false;
+    }
+    trump = suits[choice];
+    return true;
+}
+
+PlayView learned_view(const CardTracker &tracker, int seat, uint32_t hand)
+{
+    PlayView view;
+    view.hand = hand;
+    view.trump = tracker.get_trump();
+    view.makers = tracker.get_maker() % 2 == seat % 2;
+    view.position = tracker.get_num_played() % CardTracker::NUM_PLAYERS;
+    if (view.position > 0)
+    {
+        view.led = Card_to_index(tracker.get_led_card());
+        view.high = Card_to_index(tracker.get_trick_high());
+        view.partner_winning = tracker.get_trick_winner() == (seat + 2) % 4;
+    }
+    view.seen = tracker.played();
+    view.partner_voids = tracker.void_suits((seat + 2) % 4);
+    view.opponent_voids =
+        tracker.void_suits((seat + 1) % 4) | tracker.void_suits((seat + 3) % 4);
+    view.trump_out = tracker.remaining_trump() & ~hand;
+    return view;
+}
+
+void learned_play_inputs(const PlayView &view, int card, float *row)
+{
+    const Tables &t = tables();
+    const array<uint32_t, 4> &suits = suit_masks(view.trump);
+    const Card c = Card_from_index(card);
+    const Suit suit = c.get_suit(view.trump);
+    const bool trump = suit == view.trump;
+    const bool lead = view.position == 0;
+    const bool wins = lead || Card_less(Card_from_index(view.high), c,
+                                        Card_from_index(view.led), view.trump);
+    const bool boss = !(t.above[view.trump][card] & ~(view.seen | view.hand));
+    row[0] = trump;
+    row[1] = wins;
+    row[2] = wins && view.position == 3;
+    row[3] = wins && view.partner_winning;
+    row[4] = t.strength[view.trump][card] / float(NUM_CARDS - 1);
+    row[5] = boss;
+    row[6] = lead && trump && view.makers;
+    row[7] = lead && trump && !view.makers;
+    row[8] = lead && !trump && boss;
+    row[9] = lead && !trump && (view.opponent_voids & (1u << suit));
+    row[10] = lead && !trump && (view.partner_voids & (1u << suit));
+    row[11] = lead && trump ? __builtin_popcount(view.trump_out) / MAX_TRUMP_RANK : 0.0f;
+    row[12] = !trump && __builtin_popcount(view.hand & suits[suit]) == 1;
+    row[13] = !lead && !wins && trump;
+    row[14] = 0.0f;
+    row[15] = 0.0f;
+}
+
+uint32_t learned_legal(const PlayView &view)
+{
+    if (view.position == 0)
+    {
+        return view.hand;
+    }
+    const Suit led_suit = Card_from_index(view.led).get_suit(view.trump);
+    const uint32_t follow = view.hand & suit_masks(view.trump)[led_suit];
+    return follow ? follow : view.hand;
+}
+
+int learned_play(const LearnedModel &model, const PlayView &view)
+{
+    assert(view.hand);
+    uint32_t legal = learned_legal(view);
+    int cards[MAX_OPTIONS];
+    float rows[MAX_OPTIONS * LEARNED_INPUTS];
+    int count = 0;
+    for (; legal; legal &= legal - 1)
+    {
+        cards[count] = __builtin_ctz(legal);
+        learned_play_inputs(view, cards[count], rows + count * LEARNED_INPUTS);
+        count++;
+    }
+    float scores[MAX_OPTIONS];
+    model.play.evaluate(rows, count, scores);
+    return cards[best(scores, count)];
+}
@@ -0,0 +1,108 @@
+#ifndef LEARNED_HPP
+#define LEARNED_HPP
+/* Learned.hpp
+ *
+ * The Learned strategy: every choice is made by scoring the options with
+ * a Network and taking the best.  The bid model scores the hand a player
+ * would hold with a candidate trump suit, in expected points for its
+ * team; the play model scores each legal card against the trick so far
+ * and what the CardTracker has seen.  Inputs are built from HandFeatures
+ * and card masks, and all the options of one decision are scored as one
+ * batch.
+ *
+ * The models are linear by default, with built-in weights.  Setting the
+ * environment variable EUCHRE_LEARNED_MODEL to a file written by
+ * write_learned_model() makes every Learned player use those weights
+ * instead, which may be linear or MLP models.
+ *
+ * Hands are bitmasks of Card_to_index bits, as in GameState.
+ */
+
+#include <cstdint>
+#include <iostream>
+#include "Card.hpp"
+#include "CardTracker.hpp"
+#include "Network.hpp"
+
+// Inputs per row of either model
+const int LEARNED_INPUTS = 16;
+
+struct LearnedModel
+{
+    Network bid;    // a five-card hand and a candidate trump suit
+    Network play;   // one legal card in the current trick
+};
+
+// EFFECTS: returns the built-in linear models
+const LearnedModel & learned_default_model();
+
+// EFFECTS: returns the models Learned players use: read from the file
+//          named by EUCHRE_LEARNED_MODEL when it is set, otherwise the
+//          built-in ones.  Exits with a message if the file is unreadable.
+const LearnedModel & learned_model();
+
+// EFFECTS: Writes model as "learned 1", then the bid and play networks
+void write_learned_model(std::ostream &os, const LearnedModel &model);
+
+// MODIFIES: model, is
+// EFFECTS: Reads a model written by write_learned_model.  Returns false
+//          and leaves model unchanged if the input is malformed or either
+//          network does not take LEARNED_INPUTS inputs.
+bool read_learned_model(std::istream &is, LearnedModel &model);
+
+// REQUIRES: hand holds five cards, row holds LEARNED_INPUTS floats,
+//           0 <= position <= 3 counts bidders from the dealer's left, so
+//           the dealer is 3; a dealer's round-one hand already holds upcard
+// MODIFIES: row
+// EFFECTS: Writes the bid model inputs for holding hand with trump as trump
+void learned_bid_inputs(uint32_t hand, int upcard, int position, int round, Suit trump,
+                        float *row);
+
+// REQUIRES: hand holds five cards, upcard is not in hand
+// EFFECTS: returns the card the dealer throws away after picking up
+//          upcard: the one whose loss leaves the best-scoring hand
+int learned_discard(const LearnedModel &model, uint32_t hand, int upcard, Suit trump);
+
+// REQUIRES: hand holds five cards, 0 <= position <= 3, round is 1 or 2
+// MODIFIES: trump
+// EFFECTS: returns true and sets trump if the player at position orders
+//          up: in round one the upcard's suit when its hand scores above
+//          zero, in round two the best other suit when it scores above zero
+//          or the player is the dealer
+bool learned_orders_up(const LearnedModel &model, uint32_t hand, int upcard, int position,
+                       int round, Suit &trump);
+
+// What the player on move knows when choosing a card
+struct PlayView
+{
+    uint32_t hand = 0;
+    Suit trump = SPADES;
+    bool makers = false;            // the player's team ordered up
+    int position = 0;               // cards already played to the trick
+    int led = -1;                   // first card of the trick, or -1
+    int high = -1;                  // card winning the trick, or -1
+    bool partner_winning = false;
+    uint32_t seen = 0;              // cards played this hand
+    unsigned partner_voids = 0;     // suits shown void, one bit per Suit
+    unsigned opponent_voids = 0;    // either opponent
+    uint32_t trump_out = 0;         // unplayed trump outside the hand
+};
+
+// REQUIRES: tracker has trump made and it is seat's turn to play
+// EFFECTS: returns seat's view of the hand, holding hand
+PlayView learned_view(const CardTracker &tracker, int seat, uint32_t hand);
+
+// REQUIRES: card is in view.hand, row holds LEARNED_INPUTS floats
+// MODIFIES: row
+// EFFECTS: Writes the play model inputs for playing card
+void learned_play_inputs(const PlayView &view, int card, float *row);
+
+// EFFECTS: returns the cards in view.hand that may be played: those
+//          following the led suit if there are any, otherwise all of them
+uint32_t learned_legal(const PlayView &view);
+
+// REQUIRES: view.hand is not empty
+// EFFECTS: returns the legal card in view.hand that scores best
+int learned_play(const LearnedModel &model, const PlayView &view);
+
+#endif // LEARNED_HPP
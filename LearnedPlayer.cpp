@@ -0,0 +1,126 @@
+#include "Learned.hpp"
+#include "Player.hpp"
+
+// Scores its options with the learned models and takes the best, keeping
+// track of the hand through observe().  Without events (for example when
+// driven directly by a search) it sees only its cards and the led card.
+class LearnedPlayer : public Player
+{
+public:
+    LearnedPlayer(std::string name_in) : name(name_in), hand(0), model(learned_model()) {}
+
+    // EFFECTS returns player's name
+    const std::string &get_name() const override
+    {
+        return name;
+    }
+
+    // REQUIRES player has less than MAX_HAND_SIZE cards
+    // EFFECTS  adds Card c to Player's hand
+    void add_card(const Card &c) override
+    {
+        hand |= bit(c);
+    }
+
+    // REQUIRES round is 1 or 2
+    // MODIFIES order_up_suit
+    // EFFECTS If Player wishes to order up a trump suit then return true and
+    //   change order_up_suit to desired suit.  If Player wishes to pass, then do
+    //   not modify order_up_suit and return false.
+    bool make_trump(const Card &upcard, bool is_dealer,
+                    int round, Suit &order_up_suit) const override
+    {
+        return learned_orders_up(model, hand, Card_to_index(upcard),
+                                 tracker.bid_position(upcard, is_dealer), round,
+                                 order_up_suit);
+    }
+
+    // REQUIRES Player has at least one card
+    // EFFECTS  Player adds one card to hand and removes one card from hand.
+    void add_and_discard(const Card &upcard) override
+    {
+        const int discard = learned_discard(model, hand, Card_to_index(upcard),
+                                            upcard.get_suit());
+        hand = (hand | bit(upcard)) & ~(uint32_t(1) << discard);
+        if (tracker.is_trump_made() && tracker.is_upcard_taken())
+        {
+            tracker.observe_discard(Card_from_index(discard));
+        }
+    }
+
+    // REQUIRES Player has at least one card
+    // EFFECTS  Leads one Card from Player's hand according to their strategy
+    Card lead_card(Suit trump) override
+    {
+        PlayView view;
+        if (is_tracking(trump) && tracker.get_num_played() % 4 == 0)
+        {
+            view = learned_view(tracker, tracker.to_move(), hand);
+        }
+        else
+        {
+            view.hand = hand;
+            view.trump = trump;
+        }
+        return remove(learned_play(model, view));
+    }
+
+    // REQUIRES Player has at least one card
+    // EFFECTS  Plays one Card from Player's hand according to their strategy.
+    Card play_card(const Card &led_card, Suit trump) override
+    {
+        PlayView view;
+        if (is_tracking(trump) && tracker.get_num_played() % 4 != 0 &&
+            tracker.get_led_card() == led_card)
+        {
+            view = learned_view(tracker, tracker.to_move(), hand);
+        }
+        else
+        {
+            view.hand = hand;
+            view.trump = trump;
+            view.position = 1;
+            view.led = view.high = Card_to_index(led_card);
+            view.seen = bit(led_card);
+        }
+        return remove(learned_play(model, view));
+    }
+
+    void observe(const PlayerEvent &event) override
+    {
+        tracker.observe(event);
+    }
+
+private:
+    std::string name;
+    uint32_t hand; // one bit per Card_to_index
+    const LearnedModel &model;
+    CardTracker tracker;
+
+    static uint32_t bit(const Card &c)
+    {
+        return uint32_t(1) << Card_to_index(c);
+    }
+
+    // EFFECTS returns true if the tracker is following this hand
+    bool is_tracking(Suit trump) const
+    {
+        return tracker.is_trump_made() && tracker.get_trump() == trump &&
+               tracker.get_num_played() < 4 * MAX_HAND_SIZE;
+    }
+
+    // EFFECTS removes card index from the hand and returns its Card
+    Card remove(int index)
+    {
+        hand &= ~(uint32_t(1) << index);
+        return Card_from_index(index);
+    }
+};
+
+// EFFECTS: returns a new LearnedPlayer called name
+static Player * make_learned_player(const std::string &name)
+{
+    return new LearnedPlayer(name);
+}
+
+static const bool registered = Player_register("Learned", make_learned_player, false);
@@ -0,0 +1,148 @@
+#include "Learned.hpp"
+#include "Game.hpp"
+#include "Player.hpp"
+#include "unit_test_framework.hpp"
+
+#include <memory>
+#include <sstream>
+
+using namespace std;
+
+static uint32_t bit(const Card &c) {
+    return uint32_t(1) << Card_to_index(c);
+}
+
+static uint32_t mask(const vector<Card> &cards) {
+    uint32_t result = 0;
+    for (const Card &c : cards) {
+        result |= bit(c);
+    }
+    return result;
+}
+
+TEST(test_default_model_round_trip) {
+    const LearnedModel &model = learned_default_model();
+    ostringstream out;
+    write_learned_model(out, model);
+    istringstream in(out.str());
+    LearnedModel copy;
+    ASSERT_TRUE(read_learned_model(in, copy));
+    ASSERT_EQUAL(copy.bid.get_inputs(), LEARNED_INPUTS);
+    for (int i = 0; i < LEARNED_INPUTS; i++) {
+        ASSERT_EQUAL(copy.bid.weight(i), model.bid.weight(i));
+        ASSERT_EQUAL(copy.play.weight(i), model.play.weight(i));
+    }
+    ASSERT_EQUAL(copy.play.bias(), model.play.bias());
+}
+
+TEST(test_read_rejects_wrong_inputs) {
+    ostringstream out;
+    out << "learned 1\n";
+    Network(LEARNED_INPUTS).write(out);
+    Network(LEARNED_INPUTS - 1).write(out);
+    istringstream in(out.str());
+    LearnedModel model;
+    ASSERT_FALSE(read_learned_model(in, model));
+}
+
+TEST(test_bid_inputs) {
+    // right and left bower, ace of spades, ace of hearts, nine of clubs
+    const uint32_t hand = mask({Card(JACK, SPADES), Card(JACK, CLUBS), Card(ACE, SPADES),
+                                Card(ACE, HEARTS), Card(NINE, CLUBS)});
+    float row[LEARNED_INPUTS];
+    learned_bid_inputs(hand, Card_to_index(Card(KING, SPADES)), 1, 1, SPADES, row);
+    ASSERT_EQUAL(row[0], 3.0f);     // trumps
+    ASSERT_EQUAL(row[1], 1.0f);     // right bower
+    ASSERT_EQUAL(row[2], 1.0f);     // left bower
+    ASSERT_EQUAL(row[4], 1.0f);     // off aces
+    ASSERT_EQUAL(row[5], 1.0f);     // void in diamonds
+    ASSERT_EQUAL(row[6], 2.0f);     // hearts and the nine of clubs
+    ASSERT_TRUE(row[8] > 0.0f);     // upcard goes to partner
+    ASSERT_EQUAL(row[9], 0.0f);
+    ASSERT_EQUAL(row[12], 0.0f);
+    ASSERT_EQUAL(row[13], 1.0f);
+}
+
+TEST(test_orders_up_strong_hand) {
+    const LearnedModel &model = learned_default_model();
+    const uint32_t strong = mask({Card(JACK, HEARTS), Card(JACK, DIAMONDS), Card(ACE, HEARTS),
+                                  Card(KING, HEARTS), Card(ACE, SPADES)});
+    const uint32_t weak = mask({Card(NINE, SPADES), Card(TEN, CLUBS), Card(NINE, DIAMONDS),
+                                Card(TEN, DIAMONDS), Card(QUEEN, CLUBS)});
+    const int upcard = Card_to_index(Card(QUEEN, HEARTS));
+    Suit trump = SPADES;
+    ASSERT_TRUE(learned_orders_up(model, strong, upcard, 0, 1, trump));
+    ASSERT_EQUAL(trump, HEARTS);
+    trump = SPADES;
+    ASSERT_FALSE(learned_orders_up(model, weak, upcard, 0, 1, trump));
+    ASSERT_EQUAL(trump, SPADES);
+    // the dealer always names a suit in round two, never the upcard's
+    ASSERT_TRUE(learned_orders_up(model, weak, upcard, 3, 2, trump));
+    ASSERT_NOT_EQUAL(trump, HEARTS);
+}
+
+TEST(test_discard_keeps_trump) {
+    const uint32_t hand = mask({Card(JACK, HEARTS), Card(ACE, HEARTS), Card(KING, HEARTS),
+                                Card(ACE, SPADES), Card(NINE, CLUBS)});
+    const int upcard = Card_to_index(Card(QUEEN, HEARTS));
+    const int discard = learned_discard(learned_default_model(), hand, upcard, HEARTS);
+    ASSERT_EQUAL(discard, Card_to_index(Card(NINE, CLUBS)));
+}
+
+TEST(test_play_follows_suit) {
+    PlayView view;
+    view.hand = mask({Card(ACE, SPADES), Card(NINE, HEARTS), Card(TEN, HEARTS),
+                      Card(JACK, DIAMONDS)});
+    view.trump = HEARTS;
+    view.position = 1;
+    view.led = view.high = Card_to_index(Card(KING, HEARTS));
+    const LearnedModel &model = learned_default_model();
+    // three hearts, counting the left bower, then the ace of spades
+    for (int i = 0; i < 3; i++) {
+        const Card played = Card_from_index(learned_play(model, view));
+        ASSERT_EQUAL(played.get_suit(HEARTS), HEARTS);
+        view.hand &= ~bit(played);
+    }
+    ASSERT_EQUAL(Card_from_index(learned_play(model, view)), Card(ACE, SPADES));
+}
+
+TEST(test_play_wins_with_last_card) {
+    PlayView view;
+    view.hand = mask({Card(NINE, CLUBS), Card(ACE, CLUBS), Card(TEN, SPADES)});
+    view.trump = SPADES;
+    view.position = 3;
+    view.led = Card_to_index(Card(QUEEN, CLUBS));
+    view.high = Card_to_index(Card(KING, CLUBS));
+    const int played = learned_play(learned_default_model(), view);
+    ASSERT_EQUAL(played, Card_to_index(Card(ACE, CLUBS)));
+}
+
+TEST(test_factory_makes_learned_player) {
+    unique_ptr<Player> player(Player_factory("Ada", "Learned"));
+    ASSERT_EQUAL(player->get_name(), "Ada");
+    for (int i = 0; i < Player::MAX_HAND_SIZE; i++) {
+        player->add_card(Card_from_index(i));
+    }
+    const Card led = player->lead_card(HEARTS);
+    ASSERT_TRUE(Card_to_index(led) < Player::MAX_HAND_SIZE);
+}
+
+TEST(test_learned_beats_simple) {
+    const array<string, Game::num_players> names = {"A", "B", "C", "D"};
+    const array<string, Game::num_players> strategies = {"Learned", "Simple", "Learned",
+                                                         "Simple"};
+    istringstream pack_input;
+    ostringstream output;
+    int wins = 0;
+    const int games = 40;
+    for (int i = 0; i < games; i++) {
+        Game game(pack_input, true, 10, names, strategies, output);
+        game.use_random_shuffle(uint64_t(i));
+        if (game.play() == TEAM_ZERO_AND_TWO) {
+            wins++;
+        }
+    }
+    ASSERT_TRUE(wins > games * 3 / 4);
+}
+
+TEST_MAIN()
@@ -0,0 +1,287 @@
+#include "Network.hpp"
+#include <cassert>
+#include <cmath>
+#include <string>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define NETWORK_HAVE_X86 1
+#endif
+
+using namespace std;
+
+namespace
+{
+    int round_up(int n)
+    {
+        return (n + Network::LANES - 1) / Network::LANES * Network::LANES;
+    }
+
+    // EFFECTS: adds the eight lanes in the order the AVX2 reduction does:
+    //          halves, then pairs, then the last two
+    float reduce(const float lanes[Network::LANES])
+    {
+        float quarter[4];
+        for (int i = 0; i < 4; i++)
+        {
+            quarter[i] = lanes[i] + lanes[i + 4];
+        }
+        return (quarter[0] + quarter[2]) + (quarter[1] + quarter[3]);
+    }
+
+    // EFFECTS: returns the lane-wise dot product of a and b, n a multiple
+    //          of LANES, reduced as the AVX2 kernel does
+    float dot(const float *a, const float *b, int n)
+    {
+        float lanes[Network::LANES] = {};
+        for (int j = 0; j < n; j += Network::LANES)
+        {
+            for (int lane = 0; lane < Network::LANES; lane++)
+            {
+                lanes[lane] = std::fma(a[j + lane], b[j + lane], lanes[lane]);
+            }
+        }
+        return reduce(lanes);
+    }
+}
+
+Network::Network(int inputs, int hidden)
+    : inputs(inputs), hidden(hidden), stride(round_up(inputs)),
+      hidden_stride(round_up(hidden)),
+      input_weights(size_t(stride) * (hidden ? hidden_stride : 1), 0.0f),
+      biases(hidden ? hidden_stride : 1, 0.0f), output_weights(hidden_stride, 0.0f),
+      out_bias(0.0f)
+{
+    assert(inputs > 0 && hidden >= 0);
+}
+
+int Network::get_inputs() const
+{
+    return inputs;
+}
+
+int Network::get_hidden() const
+{
+    return hidden;
+}
+
+int Network::get_stride() const
+{
+    return stride;
+}
+
+float & Network::weight(int input, int unit)
+{
+    assert(0 <= input && input < inputs && 0 <= unit && unit < max(1, hidden));
+    if (!hidden)
+    {
+        return input_weights[input];
+    }
+    return input_weights[size_t(input) * hidden_stride + unit];
+}
+
+float Network::weight(int input, int unit) const
+{
+    return const_cast<Network *>(this)->weight(input, unit);
+}
+
+float & Network::bias(int unit)
+{
+    assert(0 <= unit && unit < max(1, hidden));
+    return biases[unit];
+}
+
+float Network::bias(int unit) const
+{
+    return biases[unit];
+}
+
+float & Network::output_weight(int unit)
+{
+    assert(hidden > 0 && 0 <= unit && unit < hidden);
+    return output_weights[unit];
+}
+
+float Network::output_weight(int unit) const
+{
+    return output_weights[unit];
+}
+
+float & Network::output_bias()
+{
+    assert(hidden > 0);
+    return out_bias;
+}
+
+float Network::output_bias() const
+{
+    return out_bias;
+}
+
+float Network::evaluate(const float *row) const
+{
+    float score;
+    evaluate(row, 1, &score);
+    return score;
+}
+
+void Network::evaluate_scalar(const float *rows, size_t count, float *scores) const
+{
+    std::vector<float> units(hidden_stride);
+    for (size_t r = 0; r < count; r++)
+    {
+        const float *row = rows + r * stride;
+        if (!hidden)
+        {
+            scores[r] = dot(row, input_weights.data(), stride) + biases[0];
+            continue;
+        }
+        units.assign(biases.begin(), biases.end());
+        for (int i = 0; i < inputs; i++)
+        {
+            const float *column = &input_weights[size_t(i) * hidden_stride];
+            for (int unit = 0; unit < hidden_stride; unit++)
+            {
+                units[unit] = std::fma(row[i], column[unit], units[unit]);
+            }
+        }
+        for (float &unit : units)
+        {
+            unit = max(unit, 0.0f);
+        }
+        scores[r] = dot(units.data(), output_weights.data(), hidden_stride) + out_bias;
+    }
+}
+
+#ifdef NETWORK_HAVE_X86
+namespace
+{
+    __attribute__((target("avx2,fma")))
+    float reduce_avx2(__m256 lanes)
+    {
+        const __m128 quarter = _mm_add_ps(_mm256_castps256_ps128(lanes),
+                                          _mm256_extractf128_ps(lanes, 1));
+        const __m128 pairs = _mm_add_ps(quarter, _mm_movehl_ps(quarter, quarter));
+        return _mm_cvtss_f32(_mm_add_ss(pairs, _mm_shuffle_ps(pairs, pairs, 1)));
+    }
+
+    __attribute__((target("avx2,fma")))
+    float dot_avx2(const float *a, const float *b, int n)
+    {
+        __m256 lanes = _mm256_setzero_ps();
+        for (int j = 0; j < n; j += Network::LANES)
+        {
+            lanes = _mm256_fmadd_ps(_mm256_loadu_ps(a + j), _mm256_loadu_ps(b + j),
+                                    lanes);
+        }
+        return reduce_avx2(lanes);
+    }
+
+    // REQUIRES: hidden_stride <= MAX_HIDDEN
+    __attribute__((target("avx2,fma")))
+    void evaluate_avx2(const float *rows, size_t count, float *scores, int inputs,
+                       int stride, int hidden, int hidden_stride,
+                       const float *input_weights, const float *biases,
+                       const float *output_weights, float out_bias)
+    {
+        const int MAX_HIDDEN = 256;
+        alignas(32) float units[MAX_HIDDEN];
+        for (size_t r = 0; r < count; r++)
+        {
+            const float *row = rows + r * stride;
+            if (!hidden)
+            {
+                scores[r] = dot_avx2(row, input_weights, stride) + biases[0];
+                continue;
+            }
+            for (int unit = 0; unit < hidden_stride; unit += Network::LANES)
+            {
+                __m256 sum = _mm256_loadu_ps(biases + unit);
+                for (int i = 0; i < inputs; i++)
+                {
+                    const float *column = input_weights + size_t(i) * hidden_stride;
+                    sum = _mm256_fmadd_ps(_mm256_set1_ps(row[i]),
+                                          _mm256_loadu_ps(column + unit), sum);
+                }
+                _mm256_store_ps(units + unit, _mm256_max_ps(sum, _mm256_setzero_ps()));
+            }
+            scores[r] = dot_avx2(units, output_weights, hidden_stride) + out_bias;
+        }
+    }
+}
+#endif
+
+void Network::evaluate(const float *rows, size_t count, float *scores) const
+{
+#ifdef NETWORK_HAVE_X86
+    static const bool has_avx2 =
+        __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+    if (has_avx2 && hidden_stride <= 256)
+    {
+        evaluate_avx2(rows, count, scores, inputs, stride, hidden, hidden_stride,
+                      input_weights.data(), biases.data(), output_weights.data(),
+                      out_bias);
+        return;
+    }
+#endif
+    evaluate_scalar(rows, count, scores);
+}
+
+void Network::write(std::ostream &os) const
+{
+    os.precision(9);
+    os << "network " << inputs << " " << hidden << "\n";
+    for (int unit = 0; unit < max(1, hidden); unit++)
+    {
+        os << biases[unit];
+        for (int i = 0; i < inputs; i++)
+        {
+            os << " " << weight(i, unit);
+        }
+        os << "\n";
+    }
+    if (hidden)
+    {
+        os << out_bias;
+        for (int unit = 0; unit < hidden; unit++)
+        {
+            os << " " << output_weights[unit];
+        }
+        os << "\n";
+    }
+}
+
+bool Network::read(std::istream &is)
+{
+    string tag;
+    int new_inputs = 0;
+    int new_hidden = -1;
+    if (!(is >> tag >> new_inputs >> new_hidden) || tag != "network" || new_inputs <= 0 ||
+        new_hidden < 0)
+    {
+        return false;
+    }
+    Network result(new_inputs, new_hidden);
+    for (int unit = 0; unit < max(1, new_hidden); unit++)
+    {
+        is >> result.bias(unit);
+        for (int i = 0; i < new_inputs; i++)
+        {
+            is >> result.weight(i, unit);
+        }
+    }
+    if (new_hidden)
+    {
+        is >> result.output_bias();
+        for (int unit = 0; unit < new_hidden; unit++)
+        {
+            is >> result.output_weight(unit);
+        }
+    }
+    if (!is)
+    {
+        return false;
+    }
+    *this = result;
+    return true;
+}
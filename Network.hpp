@@ -0,0 +1,93 @@
+#ifndef NETWORK_HPP
+#define NETWORK_HPP
+/* Network.hpp
+ *
+ * A scoring model small enough to run inside a player's every decision:
+ * either a linear function of its inputs or a multilayer perceptron with
+ * one ReLU hidden layer, always with a single output.  Inputs are rows of
+ * floats padded to a multiple of eight, so the AVX2 kernels work on whole
+ * registers; processors without AVX2 get a scalar loop with the same
+ * summation order, so both give bit-identical scores.
+ *
+ * Weights are read from and written to a plain text format:
+ *   network INPUTS HIDDEN
+ * then, for a linear model (HIDDEN 0), the bias and INPUTS weights; for
+ * an MLP, for each hidden unit its bias and INPUTS weights, then the
+ * output bias and HIDDEN output weights.
+ */
+
+#include <cstddef>
+#include <iostream>
+#include <vector>
+
+class Network
+{
+public:
+    static const int LANES = 8;
+
+    // REQUIRES: inputs > 0, hidden >= 0
+    // EFFECTS: Creates a model with all weights zero, linear if hidden is 0
+    Network(int inputs = LANES, int hidden = 0);
+
+    int get_inputs() const;
+    int get_hidden() const;
+
+    // EFFECTS: returns the length of one input row: inputs rounded up to a
+    //          multiple of LANES.  Padding must be zero.
+    int get_stride() const;
+
+    // REQUIRES: 0 <= input < get_inputs(), 0 <= unit < max(1, get_hidden())
+    // EFFECTS: returns the weight from input to hidden unit, or to the
+    //          output of a linear model (unit 0)
+    float & weight(int input, int unit = 0);
+    float weight(int input, int unit = 0) const;
+
+    // REQUIRES: 0 <= unit < max(1, get_hidden())
+    // EFFECTS: returns the bias of a hidden unit, or of a linear output
+    float & bias(int unit = 0);
+    float bias(int unit = 0) const;
+
+    // REQUIRES: get_hidden() > 0, 0 <= unit < get_hidden()
+    // EFFECTS: returns the weight from hidden unit to the output
+    float & output_weight(int unit);
+    float output_weight(int unit) const;
+
+    // REQUIRES: get_hidden() > 0
+    float & output_bias();
+    float output_bias() const;
+
+    // REQUIRES: row holds get_stride() floats
+    // EFFECTS: returns the model's score of row
+    float evaluate(const float *row) const;
+
+    // REQUIRES: rows holds count rows of get_stride() floats, scores holds
+    //           count floats
+    // MODIFIES: scores
+    // EFFECTS: scores every row, with AVX2 when the processor has it
+    void evaluate(const float *rows, size_t count, float *scores) const;
+
+    // EFFECTS: as evaluate, without SIMD
+    void evaluate_scalar(const float *rows, size_t count, float *scores) const;
+
+    // EFFECTS: Writes the model in the text format
+    void write(std::ostream &os) const;
+
+    // MODIFIES: this, is
+    // EFFECTS: Reads a model in the text format.  Returns false and leaves
+    //          this unchanged if the input is malformed.
+    bool read(std::istream &is);
+
+private:
+    int inputs;
+    int hidden;
+    int stride;
+    int hidden_stride;              // hidden rounded up to LANES
+    // linear: [stride] weights.  MLP: [stride][hidden_stride], the hidden
+    // units of each input side by side so a row is a sum of scaled columns
+    std::vector<float> input_weights;
+    std::vector<float> biases;      // [hidden_stride], or [1] for linear
+    std::vector<float> output_weights;  // [hidden_stride]
+    float out_bias;
+};
+
+#endif // NETWORK_HPP
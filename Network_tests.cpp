@@ -0,0 +1,112 @@
+#include "Network.hpp"
+#include "Random.hpp"
+#include "unit_test_framework.hpp"
+
+#include <sstream>
+#include <vector>
+
+using namespace std;
+
+// EFFECTS: returns a model with weights drawn from seed
+static Network random_network(int inputs, int hidden, uint64_t seed) {
+    Random random(seed);
+    Network network(inputs, hidden);
+    for (int unit = 0; unit < max(1, hidden); unit++) {
+        network.bias(unit) = float(random.uniform() - 0.5);
+        for (int i = 0; i < inputs; i++) {
+            network.weight(i, unit) = float(random.uniform() - 0.5);
+        }
+    }
+    if (hidden) {
+        network.output_bias() = float(random.uniform() - 0.5);
+        for (int unit = 0; unit < hidden; unit++) {
+            network.output_weight(unit) = float(random.uniform() - 0.5);
+        }
+    }
+    return network;
+}
+
+// EFFECTS: returns count zero-padded rows for network drawn from seed
+static vector<float> random_rows(const Network &network, size_t count, uint64_t seed) {
+    Random random(seed);
+    vector<float> rows(count * network.get_stride(), 0.0f);
+    for (size_t r = 0; r < count; r++) {
+        for (int i = 0; i < network.get_inputs(); i++) {
+            rows[r * network.get_stride() + i] = float(4 * random.uniform() - 2);
+        }
+    }
+    return rows;
+}
+
+TEST(test_linear_score) {
+    Network network(3);
+    ASSERT_EQUAL(network.get_stride(), 8);
+    network.bias() = 0.5f;
+    network.weight(0) = 1.0f;
+    network.weight(1) = -2.0f;
+    network.weight(2) = 0.25f;
+    const float row[8] = {3.0f, 1.0f, 4.0f};
+    ASSERT_EQUAL(network.evaluate(row), 0.5f + 3.0f - 2.0f + 1.0f);
+}
+
+TEST(test_mlp_score) {
+    // hidden units 2x - y and y - 2x; only one is positive for any row
+    Network network(2, 2);
+    network.weight(0, 0) = 2.0f;
+    network.weight(1, 0) = -1.0f;
+    network.weight(0, 1) = -2.0f;
+    network.weight(1, 1) = 1.0f;
+    network.output_weight(0) = 1.0f;
+    network.output_weight(1) = 3.0f;
+    network.output_bias() = -1.0f;
+    const float first[8] = {2.0f, 1.0f};
+    const float second[8] = {1.0f, 4.0f};
+    ASSERT_EQUAL(network.evaluate(first), 3.0f - 1.0f);
+    ASSERT_EQUAL(network.evaluate(second), 3 * 2.0f - 1.0f);
+}
+
+TEST(test_simd_matches_scalar) {
+    const int shapes[][2] = {{16, 0}, {13, 0}, {16, 24}, {30, 5}, {8, 64}};
+    for (const auto &shape : shapes) {
+        const Network network = random_network(shape[0], shape[1], uint64_t(shape[1]) + 3);
+        const size_t count = 100;
+        const vector<float> rows = random_rows(network, count, 11);
+        vector<float> fast(count);
+        vector<float> slow(count);
+        network.evaluate(rows.data(), count, fast.data());
+        network.evaluate_scalar(rows.data(), count, slow.data());
+        for (size_t r = 0; r < count; r++) {
+            // bit for bit, so batched and single decisions agree
+            ASSERT_EQUAL(fast[r], slow[r]);
+            ASSERT_EQUAL(network.evaluate(&rows[r * network.get_stride()]), fast[r]);
+        }
+    }
+}
+
+TEST(test_write_and_read) {
+    const Network network = random_network(10, 6, 5);
+    ostringstream out;
+    network.write(out);
+    istringstream in(out.str());
+    Network copy;
+    ASSERT_TRUE(copy.read(in));
+    ASSERT_EQUAL(copy.get_inputs(), 10);
+    ASSERT_EQUAL(copy.get_hidden(), 6);
+    const vector<float> rows = random_rows(network, 20, 2);
+    for (size_t r = 0; r < 20; r++) {
+        ASSERT_EQUAL(copy.evaluate(&rows[r * 16]), network.evaluate(&rows[r * 16]));
+    }
+}
+
+TEST(test_read_rejects_malformed) {
+    Network network(4);
+    network.bias() = 1.5f;
+    istringstream truncated("network 4 0\n1 2 3");
+    ASSERT_FALSE(network.read(truncated));
+    istringstream wrong_tag("layer 4 0\n1 2 3 4 5");
+    ASSERT_FALSE(network.read(wrong_tag));
+    ASSERT_EQUAL(network.get_inputs(), 4);
+    ASSERT_EQUAL(network.bias(), 1.5f);
+}
+
+TEST_MAIN()
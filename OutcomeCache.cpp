@@ -0,0 +1,220 @@
+#include "OutcomeCache.hpp"
+#include "Random.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+
+using namespace std;
+
+// File layout, all integers little endian:
+//   magic "EUOC", u32 version, u32 strategy version, u64 count, then count
+//   entries of u64 deal, u64 strategies, u8 dealer, u8 tricks[2], i8 points[2]
+static const char CACHE_MAGIC[4] = {'E', 'U', 'O', 'C'};
+static const uint32_t CACHE_VERSION = 2;
+static const size_t HEADER_SIZE = 4 + 4 + 4 + 8;
+static const size_t ENTRY_SIZE = 8 + 8 + 1 + 2 + 2;
+
+static void put_u64(string &out, uint64_t value, int bytes = 8)
+{
+    for (int i = 0; i < bytes; i++)
+    {
+        out.push_back(char((value >> (8 * i)) & 0xff));
+    }
+}
+
+static uint64_t get_u64(const unsigned char *in, int bytes = 8)
+{
+    uint64_t value = 0;
+    for (int i = 0; i < bytes; i++)
+    {
+        value |= uint64_t(in[i]) << (8 * i);
+    }
+    return value;
+}
+
+uint64_t strategy_set_hash(const std::array<std::string, 4> &strategies)
+{
+    // FNV-1a over the names, each ended by a zero byte
+    uint64_t hash = 0xcbf29ce484222325ull;
+    for (const string &strategy : strategies)
+    {
+        for (size_t i = 0; i <= strategy.size(); i++)
+        {
+            hash = (hash ^ (i < strategy.size() ? uint8_t(strategy[i]) : 0)) *
+                   0x100000001b3ull;
+        }
+    }
+    return mix64(hash);
+}
+
+size_t OutcomeCache::KeyHash::operator()(const OutcomeKey &key) const
+{
+    return size_t(mix64(key.deal ^ mix64(key.strategies + key.dealer)));
+}
+
+OutcomeCache::OutcomeCache(size_t capacity, int num_shards)
+    : shard_capacity(std::max<size_t>(1, capacity / size_t(num_shards)))
+{
+    assert(capacity >= 1 && num_shards >= 1);
+    for (int i = 0; i < num_shards; i++)
+    {
+        shards.emplace_back(new Shard);
+    }
+}
+
+OutcomeCache::Shard & OutcomeCache::shard_of(const OutcomeKey &key) const
+{
+    // use the high bits, the map inside the shard uses the low ones
+    return *shards[(KeyHash()(key) >> 40) % shards.size()];
+}
+
+bool OutcomeCache::lookup(const OutcomeKey &key, HandOutcome &outcome)
+{
+    Shard &shard = shard_of(key);
+    lock_guard<mutex> lock(shard.mutex);
+    const auto found = shard.entries.find(key);
+    if (found == shard.entries.end())
+    {
+        shard.misses++;
+        return false;
+    }
+    shard.hits++;
+    outcome = found->second;
+    return true;
+}
+
+void OutcomeCache::insert(const OutcomeKey &key, const HandOutcome &outcome)
+{
+    Shard &shard = shard_of(key);
+    lock_guard<mutex> lock(shard.mutex);
+    if (!shard.entries.emplace(key, outcome).second)
+    {
+        return; // another worker got here first with the same outcome
+    }
+    shard.order.push_back(key);
+    if (shard.order.size() > shard_capacity)
+    {
+        shard.entries.erase(shard.order.front());
+        shard.order.pop_front();
+        shard.evictions++;
+    }
+}
+
+size_t OutcomeCache::size() const
+{
+    size_t total = 0;
+    for (const auto &shard : shards)
+    {
+        lock_guard<mutex> lock(shard->mutex);
+        total += shard->entries.size();
+    }
+    return total;
+}
+
+long OutcomeCache::hits() const
+{
+    long total = 0;
+    for (const auto &shard : shards)
+    {
+        lock_guard<mutex> lock(shard->mutex);
+        total += shard->hits;
+    }
+    return total;
+}
+
+long OutcomeCache::misses() const
+{
+    long total = 0;
+    for (const auto &shard : shards)
+    {
+        lock_guard<mutex> lock(shard->mutex);
+        total += shard->misses;
+    }
+    return total;
+}
+
+long OutcomeCache::evictions() const
+{
+    long total = 0;
+    for (const auto &shard : shards)
+    {
+        lock_guard<mutex> lock(shard->mutex);
+        total += shard->evictions;
+    }
+    return total;
+}
+
+bool OutcomeCache::save(const std::string &path) const
+{
+    string entries;
+    uint64_t count = 0;
+    for (const auto &shard : shards)
+    {
+        lock_guard<mutex> lock(shard->mutex);
+        for (const OutcomeKey &key : shard->order)
+        {
+            const HandOutcome &outcome = shard->entries.at(key);
+            put_u64(entries, key.deal);
+            put_u64(entries, key.strategies);
+            entries.push_back(char(key.dealer));
+            entries.push_back(char(outcome.tricks[0]));
+            entries.push_back(char(outcome.tricks[1]));
+            entries.push_back(char(outcome.points[0]));
+            entries.push_back(char(outcome.points[1]));
+            count++;
+        }
+    }
+    string out(CACHE_MAGIC, sizeof(CACHE_MAGIC));
+    put_u64(out, CACHE_VERSION, 4);
+    put_u64(out, OUTCOME_STRATEGY_VERSION, 4);
+    put_u64(out, count);
+    out += entries;
+
+    // write the whole file under a temporary name, then atomically replace
+    const string tmp_path = path + ".tmp";
+    {
+        ofstream file(tmp_path, ios::binary | ios::trunc);
+        if (!file.write(out.data(), out.size()) || !file.flush())
+        {
+            return false;
+        }
+    }
+    return rename(tmp_path.c_str(), path.c_str()) == 0;
+}
+
+bool OutcomeCache::load(const std::string &path)
+{
+    ifstream file(path, ios::binary);
+    if (!file)
+    {
+        return false;
+    }
+    const string data((istreambuf_iterator<char>(file)), istreambuf_iterator<char>());
+    const unsigned char *in = reinterpret_cast<const unsigned char *>(data.data());
+    if (data.size() < HEADER_SIZE ||
+        !equal(CACHE_MAGIC, CACHE_MAGIC + 4, in) || get_u64(in + 4, 4) != CACHE_VERSION ||
+        get_u64(in + 8, 4) != OUTCOME_STRATEGY_VERSION)
+    {
+        return false;
+    }
+    const uint64_t count = get_u64(in + 12);
+    if ((data.size() - HEADER_SIZE) / ENTRY_SIZE != count ||
+        (data.size() - HEADER_SIZE) % ENTRY_SIZE != 0)
+    {
+        return false;
+    }
+    for (const unsigned char *p = in + HEADER_SIZE; p < in + data.size(); p += ENTRY_SIZE)
+    {
+        OutcomeKey key;
+        key.deal = get_u64(p);
+        key.strategies = get_u64(p + 8);
+        key.dealer = p[16];
+        HandOutcome outcome;
+        outcome.tricks = {p[17], p[18]};
+        outcome.points = {int8_t(p[19]), int8_t(p[20])};
+        insert(key, outcome);
+    }
+    return true;
+}
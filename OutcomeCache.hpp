@@ -0,0 +1,102 @@
+#ifndef OUTCOMECACHE_HPP
+#define OUTCOMECACHE_HPP
+/* OutcomeCache.hpp
+ *
+ * A bounded cache of hand outcomes shared by worker threads.  With
+ * deterministic strategies a hand's result depends only on the deal, the
+ * dealer and who sits where, so duplicate, replay and exhaustive runs can
+ * look a hand up instead of playing it again.  Entries are spread over
+ * shards with a lock each, so threads rarely wait on one another; a full
+ * shard forgets its oldest entry.  The cache can be saved between runs.
+ */
+
+#include <array>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+struct OutcomeKey
+{
+    uint64_t deal = 0;          // rank_deal() of the hands and upcard
+    uint64_t strategies = 0;    // strategy_set_hash() of the seats
+    uint8_t dealer = 0;
+
+    bool operator==(const OutcomeKey &other) const = default;
+};
+
+struct HandOutcome
+{
+    std::array<uint8_t, 2> tricks{};    // tricks taken by each team
+    std::array<int8_t, 2> points{};     // points scored by each team
+
+    bool operator==(const HandOutcome &other) const = default;
+};
+
+// EFFECTS: returns a hash of the strategies in seat order
+uint64_t strategy_set_hash(const std::array<std::string, 4> &strategies);
+
+// Keys name strategies, not how they play.  Bump this whenever a change
+// makes a deterministic strategy play some hand differently, so outcomes
+// saved before the change are not loaded after it.
+const uint32_t OUTCOME_STRATEGY_VERSION = 1;
+
+class OutcomeCache
+{
+public:
+    // REQUIRES: capacity >= 1, num_shards >= 1
+    // EFFECTS: Creates an empty cache holding about capacity outcomes
+    explicit OutcomeCache(size_t capacity, int num_shards = 16);
+
+    // MODIFIES: outcome
+    // EFFECTS: If key is cached, sets outcome and returns true; otherwise
+    //          returns false.  Counts a hit or a miss either way.
+    bool lookup(const OutcomeKey &key, HandOutcome &outcome);
+
+    // EFFECTS: Stores outcome under key, evicting the shard's oldest entry
+    //          if the shard is full
+    void insert(const OutcomeKey &key, const HandOutcome &outcome);
+
+    // EFFECTS: returns the number of cached outcomes
+    size_t size() const;
+
+    long hits() const;
+    long misses() const;
+    long evictions() const;
+
+    // EFFECTS: Writes every cached outcome to path, tagged with
+    //          OUTCOME_STRATEGY_VERSION.  Returns false if the file cannot
+    //          be written.
+    bool save(const std::string &path) const;
+
+    // EFFECTS: Adds the outcomes saved in path.  Returns false if the file
+    //          cannot be read, is not an outcome cache, or was saved under
+    //          another OUTCOME_STRATEGY_VERSION.
+    bool load(const std::string &path);
+
+private:
+    struct KeyHash
+    {
+        size_t operator()(const OutcomeKey &key) const;
+    };
+
+    struct Shard
+    {
+        mutable std::mutex mutex;
+        std::unordered_map<OutcomeKey, HandOutcome, KeyHash> entries;
+        std::deque<OutcomeKey> order;     // oldest first
+        long hits = 0;
+        long misses = 0;
+        long evictions = 0;
+    };
+
+    size_t shard_capacity;
+    std::vector<std::unique_ptr<Shard>> shards;
+
+    Shard & shard_of(const OutcomeKey &key) const;
+};
+
+#endif // OUTCOMECACHE_HPP
@@ -0,0 +1,121 @@
+#include "OutcomeCache.hpp"
+#include "unit_test_framework.hpp"
+
+#include <cstdio>
+#include <fstream>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+static OutcomeKey key_of(uint64_t deal) {
+    OutcomeKey key;
+    key.deal = deal;
+    key.strategies = strategy_set_hash({"Simple", "Simple", "Simple", "Simple"});
+    key.dealer = uint8_t(deal % 4);
+    return key;
+}
+
+static HandOutcome outcome_of(uint64_t deal) {
+    HandOutcome outcome;
+    outcome.tricks = {uint8_t(deal % 6), uint8_t(5 - deal % 6)};
+    outcome.points = {int8_t(deal % 3), int8_t(-(int(deal) % 2))};
+    return outcome;
+}
+
+TEST(test_lookup_and_insert) {
+    OutcomeCache cache(100, 4);
+    HandOutcome outcome;
+    ASSERT_FALSE(cache.lookup(key_of(7), outcome));
+    cache.insert(key_of(7), outcome_of(7));
+    ASSERT_TRUE(cache.lookup(key_of(7), outcome));
+    ASSERT_TRUE(outcome == outcome_of(7));
+    ASSERT_EQUAL(cache.hits(), 1);
+    ASSERT_EQUAL(cache.misses(), 1);
+
+    // a different seating of the same deal is a different hand
+    OutcomeKey swapped = key_of(7);
+    swapped.strategies = strategy_set_hash({"Simple", "Human", "Simple", "Simple"});
+    ASSERT_FALSE(cache.lookup(swapped, outcome));
+}
+
+TEST(test_strategy_hash_depends_on_seats) {
+    ASSERT_NOT_EQUAL(strategy_set_hash({"Simple", "Human", "Simple", "Simple"}),
+                     strategy_set_hash({"Human", "Simple", "Simple", "Simple"}));
+    ASSERT_NOT_EQUAL(strategy_set_hash({"ab", "c", "", ""}),
+                     strategy_set_hash({"a", "bc", "", ""}));
+}
+
+TEST(test_cache_is_bounded) {
+    OutcomeCache cache(64, 4);
+    for (uint64_t deal = 0; deal < 1000; deal++) {
+        cache.insert(key_of(deal), outcome_of(deal));
+    }
+    ASSERT_TRUE(cache.size() <= 64);
+    ASSERT_EQUAL(long(cache.size()) + cache.evictions(), 1000);
+    HandOutcome outcome;
+    ASSERT_TRUE(cache.lookup(key_of(999), outcome));
+    ASSERT_FALSE(cache.lookup(key_of(0), outcome));
+}
+
+TEST(test_save_and_load) {
+    const string path = "OutcomeCache_tests.cache";
+    OutcomeCache cache(1000);
+    for (uint64_t deal = 0; deal < 300; deal++) {
+        cache.insert(key_of(deal * 12345), outcome_of(deal));
+    }
+    ASSERT_TRUE(cache.save(path));
+
+    OutcomeCache loaded(1000);
+    ASSERT_TRUE(loaded.load(path));
+    ASSERT_EQUAL(loaded.size(), size_t(300));
+    for (uint64_t deal = 0; deal < 300; deal++) {
+        HandOutcome outcome;
+        ASSERT_TRUE(loaded.lookup(key_of(deal * 12345), outcome));
+        ASSERT_TRUE(outcome == outcome_of(deal));
+    }
+    remove(path.c_str());
+    ASSERT_FALSE(loaded.load(path));
+}
+
+TEST(test_load_rejects_another_strategy_version) {
+    const string path = "OutcomeCache_tests_version.cache";
+    OutcomeCache cache(1000);
+    cache.insert(key_of(7), outcome_of(7));
+    ASSERT_TRUE(cache.save(path));
+
+    // the strategy version follows the magic and the format version
+    fstream file(path, ios::in | ios::out | ios::binary);
+    file.seekp(8);
+    file.put(char(OUTCOME_STRATEGY_VERSION + 1));
+    file.close();
+
+    OutcomeCache loaded(1000);
+    ASSERT_FALSE(loaded.load(path));
+    ASSERT_EQUAL(loaded.size(), size_t(0));
+    remove(path.c_str());
+}
+
+TEST(test_concurrent_use) {
+    OutcomeCache cache(1 << 12);
+    vector<thread> threads;
+    for (int t = 0; t < 4; t++) {
+        threads.emplace_back([&cache]() {
+            for (uint64_t deal = 0; deal < 2000; deal++) {
+                HandOutcome outcome;
+                if (!cache.lookup(key_of(deal), outcome)) {
+                    cache.insert(key_of(deal), outcome_of(deal));
+                } else if (!(outcome == outcome_of(deal))) {
+                    cache.insert(key_of(uint64_t(-1)), outcome); // flags the error
+                }
+            }
+        });
+    }
+    for (thread &t : threads) {
+        t.join();
+    }
+    ASSERT_EQUAL(cache.size(), size_t(2000));
+    ASSERT_EQUAL(cache.hits() + cache.misses(), 8000);
+}
+
+TEST_MAIN()
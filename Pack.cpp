@@ -1,4 +1,6 @@
 #include "Pack.hpp"
+#include "Random.hpp"
+#include <utility>
 
 using namespace std;
 
@@ -18,6 +20,9 @@ Pack::Pack(std::istream& pack_input) : next(0) {
     }
 }
 
+Pack::Pack(const std::array<Card, PACK_SIZE> &cards_in, int next_in)
+    : cards(cards_in), next(next_in) {}
+
 Card Pack::deal_one() {
     next++;
     return cards[next-1];
@@ -27,20 +32,35 @@ void Pack::reset() {
     next = 0;
 }
 
-void Pack::single_in_shuffle(){
-    std::array<Card, PACK_SIZE> old_cards = cards;
-    for(int i = 0; i < PACK_SIZE/2; i++){
-        cards[2*i] = old_cards[PACK_SIZE/2 + i];
-        cards[2*i + 1] = old_cards[i];
-    }
-}
+static_assert(Permutation::SIZE == Pack::PACK_SIZE, "permutations cover the whole pack");
+
+// seven in shuffles, composed into one permutation at compile time
+static constexpr Permutation SEVEN_IN_SHUFFLES = Permutation::in_shuffle().power(7);
 
 void Pack::shuffle(){
-    for(int i = 0; i < 7; i++){
-        this->single_in_shuffle();
+    SEVEN_IN_SHUFFLES.apply(cards);
+}
+
+void Pack::permute(const Permutation &permutation){
+    permutation.apply(cards);
+}
+
+void Pack::shuffle(uint64_t seed){
+    Random random(seed);
+    for(int i = PACK_SIZE - 1; i > 0; i--){
+        std::swap(cards[i], cards[random.below(i + 1)]);
     }
+    next = 0;
 }
 
 bool Pack::empty() const {
     return next >= PACK_SIZE;
 }
+
+const std::array<Card, Pack::PACK_SIZE> & Pack::get_cards() const {
+    return cards;
+}
+
+int Pack::get_next() const {
+    return next;
+}
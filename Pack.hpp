@@ -10,11 +10,15 @@
 
 
 #include "Card.hpp"
+#include "Permutation.hpp"
 #include <array>
+#include <cstdint>
 #include <string>
 
 class Pack {
 public:
+  static const int PACK_SIZE = 24;
+
   // EFFECTS: Initializes the Pack to be in the following standard order:
   //          the cards of the lowest suit arranged from lowest rank to
   //          highest rank, followed by the cards of the next lowest suit
@@ -31,6 +35,11 @@ public:
   // NOTE: The pack is initially full, with no cards dealt.
   Pack(std::istream& pack_input);
 
+  // REQUIRES: 0 <= next_in <= PACK_SIZE
+  // EFFECTS: Initializes Pack to the given card order, with next_in cards
+  //          already dealt.
+  Pack(const std::array<Card, PACK_SIZE> &cards_in, int next_in);
+
   // REQUIRES: cards remain in the Pack
   // EFFECTS: Returns the next card in the pack and increments the next index
   Card deal_one();
@@ -43,16 +52,27 @@ public:
   //          https://en.wikipedia.org/wiki/In_shuffle.
   void shuffle();
 
+  // EFFECTS: Rearranges the Pack by permutation.  Does not change the next
+  //          index.
+  void permute(const Permutation &permutation);
+
+  // EFFECTS: Puts the Pack in a uniformly random order drawn from seed
+  //          and resets the next index.  The same seed and starting order
+  //          always give the same result.
+  void shuffle(uint64_t seed);
+
   // EFFECTS: returns true if there are no more cards left in the pack
   bool empty() const;
 
+  // EFFECTS: returns the cards in the Pack in their current order
+  const std::array<Card, PACK_SIZE> & get_cards() const;
+
+  // EFFECTS: returns the index of the next card to be dealt
+  int get_next() const;
+
 private:
-  static const int PACK_SIZE = 24;
   std::array<Card, PACK_SIZE> cards;
   int next; //index of next card to be dealt
-
-  // EFFECTS: perform single in shuffle
-  void single_in_shuffle();
 };
 
 #endif // PACK_HPP
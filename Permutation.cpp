@@ -0,0 +1,85 @@
+#include "Permutation.hpp"
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define PERMUTATION_HAVE_X86 1
+#endif
+
+static_assert(sizeof(Card) == 1, "apply() moves cards as bytes");
+
+Permutation Permutation::riffle(Random &random)
+{
+    // cut at Binomial(SIZE, 1/2)
+    const int cut = __builtin_popcountll(random.next() & ((uint64_t(1) << SIZE) - 1));
+    int top = 0;
+    int bottom = cut;
+    Permutation result;
+    for (int i = 0; i < SIZE; i++)
+    {
+        const int top_left = cut - top;
+        const int bottom_left = SIZE - bottom;
+        if (bottom_left == 0 || (top_left > 0 && int(random.below(top_left + bottom_left)) < top_left))
+        {
+            result.source[i] = uint8_t(top++);
+        }
+        else
+        {
+            result.source[i] = uint8_t(bottom++);
+        }
+    }
+    return result;
+}
+
+void Permutation::apply_scalar(std::array<Card, SIZE> &cards) const
+{
+    const std::array<Card, SIZE> old_cards = cards;
+    for (int i = 0; i < SIZE; i++)
+    {
+        cards[i] = old_cards[source[i]];
+    }
+}
+
+#ifdef PERMUTATION_HAVE_X86
+// Each 16-byte half of the result gathers from both halves of the pack:
+// pshufb zeroes a lane whose index has the high bit set, so each gather
+// masks off the indices that belong to the other half.
+__attribute__((target("ssse3")))
+static void apply_ssse3(const uint8_t *source, uint8_t *bytes)
+{
+    alignas(16) uint8_t in[32] = {};
+    alignas(16) uint8_t index[32] = {};
+    std::memcpy(in, bytes, Permutation::SIZE);
+    std::memcpy(index, source, Permutation::SIZE);
+
+    const __m128i low = _mm_load_si128(reinterpret_cast<const __m128i *>(in));
+    const __m128i high = _mm_load_si128(reinterpret_cast<const __m128i *>(in + 16));
+    const __m128i fifteen = _mm_set1_epi8(15);
+    const __m128i sixteen = _mm_set1_epi8(16);
+    alignas(16) uint8_t out[32];
+    for (int half = 0; half < 2; half++)
+    {
+        const __m128i s = _mm_load_si128(reinterpret_cast<const __m128i *>(index + 16 * half));
+        const __m128i in_high = _mm_cmpgt_epi8(s, fifteen);
+        const __m128i from_low = _mm_shuffle_epi8(low, _mm_or_si128(s, in_high));
+        // an index below 16 wraps negative, which zeroes its lane
+        const __m128i from_high = _mm_shuffle_epi8(high, _mm_sub_epi8(s, sixteen));
+        _mm_store_si128(reinterpret_cast<__m128i *>(out + 16 * half),
+                        _mm_or_si128(from_low, from_high));
+    }
+    std::memcpy(bytes, out, Permutation::SIZE);
+}
+#endif
+
+void Permutation::apply(std::array<Card, SIZE> &cards) const
+{
+#ifdef PERMUTATION_HAVE_X86
+    static const bool has_ssse3 = __builtin_cpu_supports("ssse3");
+    if (has_ssse3)
+    {
+        apply_ssse3(source.data(), reinterpret_cast<uint8_t *>(cards.data()));
+        return;
+    }
+#endif
+    apply_scalar(cards);
+}
@@ -0,0 +1,122 @@
+#ifndef PERMUTATION_HPP
+#define PERMUTATION_HPP
+/* Permutation.hpp
+ *
+ * Rearrangements of a 24-card pack.  Permutations compose at compile time,
+ * so a fixed shuffle such as seven in-shuffles becomes one table, and are
+ * applied to a pack of one-byte cards with SIMD byte shuffles where the
+ * processor has them.
+ */
+
+#include <array>
+#include <cstdint>
+#include "Card.hpp"
+#include "Random.hpp"
+
+class Permutation
+{
+public:
+    static const int SIZE = 24;
+    static const int HALF = SIZE / 2;
+
+    // EFFECTS: Creates the identity permutation
+    constexpr Permutation() : source{}
+    {
+        for (int i = 0; i < SIZE; i++)
+        {
+            source[i] = uint8_t(i);
+        }
+    }
+
+    // EFFECTS: returns the perfect shuffle that puts the bottom half's
+    //          cards first: new[2i] = old[12 + i], new[2i + 1] = old[i]
+    static constexpr Permutation in_shuffle()
+    {
+        Permutation result;
+        for (int i = 0; i < HALF; i++)
+        {
+            result.source[2 * i] = uint8_t(HALF + i);
+            result.source[2 * i + 1] = uint8_t(i);
+        }
+        return result;
+    }
+
+    // EFFECTS: returns the perfect shuffle that keeps the top card on top
+    static constexpr Permutation out_shuffle()
+    {
+        Permutation result;
+        for (int i = 0; i < HALF; i++)
+        {
+            result.source[2 * i] = uint8_t(i);
+            result.source[2 * i + 1] = uint8_t(HALF + i);
+        }
+        return result;
+    }
+
+    // REQUIRES: 0 <= k < SIZE
+    // EFFECTS: returns the cut that moves the top k cards to the bottom
+    static constexpr Permutation cut(int k)
+    {
+        Permutation result;
+        for (int i = 0; i < SIZE; i++)
+        {
+            result.source[i] = uint8_t((i + k) % SIZE);
+        }
+        return result;
+    }
+
+    // MODIFIES: random
+    // EFFECTS: returns a Gilbert-Shannon-Reeds riffle: the pack is cut
+    //          binomially and the halves are interleaved, each next card
+    //          falling from a half in proportion to its size
+    static Permutation riffle(Random &random);
+
+    // EFFECTS: returns this permutation followed by next
+    constexpr Permutation then(const Permutation &next) const
+    {
+        Permutation result;
+        for (int i = 0; i < SIZE; i++)
+        {
+            result.source[i] = source[next.source[i]];
+        }
+        return result;
+    }
+
+    // REQUIRES: k >= 0
+    // EFFECTS: returns this permutation applied k times
+    constexpr Permutation power(int k) const
+    {
+        Permutation result;
+        Permutation square = *this;
+        for (; k > 0; k /= 2)
+        {
+            if (k % 2)
+            {
+                result = result.then(square);
+            }
+            square = square.then(square);
+        }
+        return result;
+    }
+
+    // EFFECTS: returns the old position of the card that lands at i
+    constexpr int operator[](int i) const
+    {
+        return source[i];
+    }
+
+    constexpr bool operator==(const Permutation &other) const = default;
+
+    // MODIFIES: cards
+    // EFFECTS: rearranges cards, using SIMD byte shuffles when available
+    void apply(std::array<Card, SIZE> &cards) const;
+
+    // MODIFIES: cards
+    // EFFECTS: rearranges cards one at a time
+    void apply_scalar(std::array<Card, SIZE> &cards) const;
+
+private:
+    std::array<uint8_t, SIZE> source;
+};
+
+#endif // PERMUTATION_HPP
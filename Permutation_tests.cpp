@@ -0,0 +1,136 @@
+#include "Permutation.hpp"
+#include "Pack.hpp"
+#include "Random.hpp"
+#include "unit_test_framework.hpp"
+
+#include <array>
+
+using namespace std;
+
+// the shuffle Pack used to run: one in shuffle at a time
+static void reference_in_shuffle(array<Card, Permutation::SIZE> &cards)
+{
+    const array<Card, Permutation::SIZE> old_cards = cards;
+    for (int i = 0; i < Permutation::HALF; i++)
+    {
+        cards[2 * i] = old_cards[Permutation::HALF + i];
+        cards[2 * i + 1] = old_cards[i];
+    }
+}
+
+static array<Card, Permutation::SIZE> sorted_cards()
+{
+    array<Card, Permutation::SIZE> cards;
+    for (int i = 0; i < Permutation::SIZE; i++)
+    {
+        cards[i] = Card_from_index(i);
+    }
+    return cards;
+}
+
+static_assert(Permutation::in_shuffle().power(0) == Permutation(),
+              "power(0) is the identity");
+static_assert(Permutation::in_shuffle().power(2) ==
+                  Permutation::in_shuffle().then(Permutation::in_shuffle()),
+              "permutations compose at compile time");
+
+TEST(test_seven_in_shuffles_match_reference)
+{
+    array<Card, Permutation::SIZE> expected = sorted_cards();
+    for (int i = 0; i < 7; i++)
+    {
+        reference_in_shuffle(expected);
+    }
+    array<Card, Permutation::SIZE> cards = sorted_cards();
+    Permutation::in_shuffle().power(7).apply(cards);
+    ASSERT_TRUE(cards == expected);
+}
+
+TEST(test_pack_shuffle_matches_reference)
+{
+    Pack pack;
+    pack.shuffle();
+    array<Card, Permutation::SIZE> expected;
+    Pack reference;
+    for (int i = 0; i < Permutation::SIZE; i++)
+    {
+        expected[i] = reference.deal_one();
+    }
+    for (int i = 0; i < 7; i++)
+    {
+        reference_in_shuffle(expected);
+    }
+    for (int i = 0; i < Permutation::SIZE; i++)
+    {
+        ASSERT_EQUAL(expected[i], pack.deal_one());
+    }
+}
+
+TEST(test_perfect_shuffle_orders)
+{
+    // in shuffles of 24 cards return after 20, out shuffles after 22
+    ASSERT_TRUE(Permutation::in_shuffle().power(20) == Permutation());
+    ASSERT_FALSE(Permutation::in_shuffle().power(10) == Permutation());
+    ASSERT_TRUE(Permutation::out_shuffle().power(11) == Permutation());
+    ASSERT_TRUE(Permutation::out_shuffle()[0] == 0);
+}
+
+TEST(test_cut)
+{
+    const Permutation cut = Permutation::cut(5);
+    array<Card, Permutation::SIZE> cards = sorted_cards();
+    cut.apply(cards);
+    ASSERT_EQUAL(Card_from_index(5), cards[0]);
+    ASSERT_EQUAL(Card_from_index(4), cards[Permutation::SIZE - 1]);
+    ASSERT_TRUE(cut.then(Permutation::cut(Permutation::SIZE - 5)) == Permutation());
+}
+
+TEST(test_then_is_associative_and_matches_apply)
+{
+    Random random(17);
+    for (int trial = 0; trial < 100; trial++)
+    {
+        const Permutation a = Permutation::riffle(random);
+        const Permutation b = Permutation::riffle(random);
+        const Permutation c = Permutation::cut(int(random.below(Permutation::SIZE)));
+        ASSERT_TRUE(a.then(b).then(c) == a.then(b.then(c)));
+
+        array<Card, Permutation::SIZE> one_by_one = sorted_cards();
+        a.apply(one_by_one);
+        b.apply(one_by_one);
+        array<Card, Permutation::SIZE> composed = sorted_cards();
+        a.then(b).apply(composed);
+        ASSERT_TRUE(one_by_one == composed);
+    }
+}
+
+TEST(test_riffle_is_a_permutation)
+{
+    Random random(3);
+    for (int trial = 0; trial < 1000; trial++)
+    {
+        const Permutation riffle = Permutation::riffle(random);
+        uint32_t seen = 0;
+        for (int i = 0; i < Permutation::SIZE; i++)
+        {
+            seen |= uint32_t(1) << riffle[i];
+        }
+        ASSERT_EQUAL(seen, (uint32_t(1) << Permutation::SIZE) - 1);
+    }
+}
+
+TEST(test_simd_apply_matches_scalar)
+{
+    Random random(99);
+    array<Card, Permutation::SIZE> fast = sorted_cards();
+    array<Card, Permutation::SIZE> slow = sorted_cards();
+    for (int trial = 0; trial < 1000; trial++)
+    {
+        const Permutation riffle = Permutation::riffle(random);
+        riffle.apply(fast);
+        riffle.apply_scalar(slow);
+        ASSERT_TRUE(fast == slow);
+    }
+}
+
+TEST_MAIN()
@@ -304,6 +304,22 @@ private:
     }
 };
 
+// A strategy added with Player_register
+struct RegisteredStrategy
+{
+    std::string strategy;
+    Player_maker make;
+    bool is_deterministic;
+};
+
+// EFFECTS: returns the strategies added with Player_register.  Built on
+//   first use, since they register while static objects are initialized.
+static std::vector<RegisteredStrategy> &registered_strategies()
+{
+    static std::vector<RegisteredStrategy> strategies;
+    return strategies;
+}
+
 Player *Player_factory(const std::string &name, const std::string &strategy)
 {
     // We need to check the value of strategy and return
@@ -320,11 +336,64 @@ Player *Player_factory(const std::string &name, const std::string &strategy)
         return new HumanPlayer(name);
     }
 
+    for (const RegisteredStrategy &registered : registered_strategies())
+    {
+        if (registered.strategy == strategy)
+        {
+            return registered.make(name);
+        }
+    }
+
     // Invalid strategy if we get here
     assert(false);
     return nullptr;
 }
 
+// EFFECTS: returns the strategies accepted so far, in the order they were
+//   added, with the built-in ones first
+static std::vector<std::string> &strategy_names()
+{
+    static std::vector<std::string> strategies = {"Simple", "Human"};
+    return strategies;
+}
+
+bool Player_register(const std::string &strategy, Player_maker make,
+                     bool is_deterministic)
+{
+    assert(!Player_strategy_exists(strategy));
+    registered_strategies().push_back({strategy, make, is_deterministic});
+    strategy_names().push_back(strategy);
+    return true;
+}
+
+const std::vector<std::string> &Player_strategies()
+{
+    return strategy_names();
+}
+
+bool Player_strategy_exists(const std::string &strategy)
+{
+    const std::vector<std::string> &strategies = Player_strategies();
+    return std::find(strategies.begin(), strategies.end(), strategy) != strategies.end();
+}
+
+bool Player_strategy_is_interactive(const std::string &strategy)
+{
+    return strategy == "Human";
+}
+
+bool Player_strategy_is_deterministic(const std::string &strategy)
+{
+    for (const RegisteredStrategy &registered : registered_strategies())
+    {
+        if (registered.strategy == strategy)
+        {
+            return registered.is_deterministic;
+        }
+    }
+    return strategy == "Simple";
+}
+
 std::ostream &operator<<(std::ostream &os, const Player &p)
 {
     os << p.get_name();
@@ -14,6 +14,23 @@
 #include <string>
 #include <vector>
 
+// A public event in a hand, shown to every player at the table
+struct PlayerEvent {
+  enum Type {
+    HAND_STARTED, // player deals, card is the upcard
+    PASSED,       // player passes in round
+    ORDERED_UP,   // player orders up trump in round
+    CARD_PLAYED,  // player plays card
+    TRICK_WON     // player takes the trick
+  };
+
+  Type type;
+  int player = 0;
+  Card card;
+  Suit trump = SPADES;
+  int round = 0;
+};
+
 class Player {
  public:
   //EFFECTS returns player's name
@@ -46,6 +63,10 @@ class Player {
   //  The card is removed from the player's hand.
   virtual Card play_card(const Card &led_card, Suit trump) = 0;
 
+  //EFFECTS  Tells the player about a public event, including its own bids
+  //  and plays.  Players that do not track the hand ignore events.
+  virtual void observe(const PlayerEvent &event) {}
+
   // Maximum number of cards in a player's hand
   static const int MAX_HAND_SIZE = 5;
 
@@ -60,6 +81,30 @@ class Player {
 //Don't forget to call "delete" on each Player* after the game is over
 Player * Player_factory(const std::string &name, const std::string &strategy);
 
+//EFFECTS: Returns a new player with the given name
+typedef Player * (*Player_maker)(const std::string &name);
+
+//REQUIRES Player_factory does not already accept strategy
+//EFFECTS: Makes Player_factory accept strategy, creating its players with
+//  make.  Strategies built outside Player.cpp register from their own
+//  source file, so a program offers the strategies it is linked with.
+//  Returns true, so the call can initialize a static.
+bool Player_register(const std::string &strategy, Player_maker make,
+                     bool is_deterministic);
+
+//EFFECTS: Returns the names of all strategies Player_factory accepts
+const std::vector<std::string> & Player_strategies();
+
+//EFFECTS: Returns true if Player_factory accepts strategy
+bool Player_strategy_exists(const std::string &strategy);
+
+//EFFECTS: Returns true if strategy reads its decisions from std::cin
+bool Player_strategy_is_interactive(const std::string &strategy);
+
+//EFFECTS: Returns true if strategy always makes the same decisions from the
+//  same cards, so a hand's outcome depends only on the deal
+bool Player_strategy_is_deterministic(const std::string &strategy);
+
 //EFFECTS: Prints player's name to os
 std::ostream & operator<<(std::ostream &os, const Player &p);
 
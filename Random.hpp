@@ -0,0 +1,61 @@
+#ifndef RANDOM_HPP
+#define RANDOM_HPP
+/* Random.hpp
+ *
+ * Small, fast, seedable random number generation.  Streams are derived
+ * from a seed and an index, so any game or deal in a run can be
+ * regenerated without replaying the ones before it.
+ */
+
+#include <cstdint>
+
+// EFFECTS: returns a well mixed 64-bit function of x (SplitMix64 finalizer)
+inline uint64_t mix64(uint64_t x)
+{
+    x += 0x9e3779b97f4a7c15ull;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+    return x ^ (x >> 31);
+}
+
+// EFFECTS: returns the seed of stream number index derived from seed
+inline uint64_t derive_seed(uint64_t seed, uint64_t index)
+{
+    return mix64(seed ^ mix64(index));
+}
+
+// SplitMix64 generator
+class Random
+{
+public:
+    explicit Random(uint64_t seed) : state(seed) {}
+
+    // EFFECTS: returns the next 64 random bits
+    uint64_t next()
+    {
+        state += 0x9e3779b97f4a7c15ull;
+        uint64_t z = state;
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+        return z ^ (z >> 31);
+    }
+
+    // REQUIRES: bound > 0
+    // EFFECTS: returns a uniform integer in [0, bound)
+    uint32_t below(uint32_t bound)
+    {
+        // Lemire's multiply-shift; the bias is negligible for small bounds
+        return uint32_t(((next() >> 32) * bound) >> 32);
+    }
+
+    // EFFECTS: returns a uniform double in [0, 1)
+    double uniform()
+    {
+        return (next() >> 11) * (1.0 / 9007199254740992.0);
+    }
+
+private:
+    uint64_t state;
+};
+
+#endif // RANDOM_HPP
@@ -0,0 +1,269 @@
+#include "Rating.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <iomanip>
+
+using namespace std;
+
+void write_game_record(std::ostream &os, const GameRecord &record)
+{
+    char out[GAME_RECORD_SIZE];
+    for (int i = 0; i < 4; i++)
+    {
+        out[2 * i] = char(record.strategies[i] & 0xff);
+        out[2 * i + 1] = char(record.strategies[i] >> 8);
+    }
+    out[8] = char(record.points[0]);
+    out[9] = char(record.points[1]);
+    os.write(out, GAME_RECORD_SIZE);
+}
+
+bool read_game_record(std::istream &is, GameRecord &record)
+{
+    unsigned char in[GAME_RECORD_SIZE];
+    if (!is.read(reinterpret_cast<char *>(in), GAME_RECORD_SIZE))
+    {
+        return false;
+    }
+    for (int i = 0; i < 4; i++)
+    {
+        record.strategies[i] = uint16_t(in[2 * i] | (in[2 * i + 1] << 8));
+    }
+    record.points = {in[8], in[9]};
+    return true;
+}
+
+RatingDelta::RatingDelta(int num_strategies)
+    : entries(num_strategies), num_games(0) {}
+
+void RatingDelta::merge(const RatingDelta &delta)
+{
+    assert(delta.entries.size() == entries.size());
+    for (size_t i = 0; i < entries.size(); i++)
+    {
+        entries[i].elo += delta.entries[i].elo;
+        entries[i].mu += delta.entries[i].mu;
+        entries[i].variance_scale *= delta.entries[i].variance_scale;
+        entries[i].games += delta.entries[i].games;
+        entries[i].wins += delta.entries[i].wins;
+    }
+    num_games += delta.num_games;
+}
+
+uint64_t RatingDelta::size() const
+{
+    return num_games;
+}
+
+// Changes to the strategies of one game.  A strategy in more than one seat
+// has its seats' changes combined, so it is updated once per game.
+struct GameChanges
+{
+    int count = 0;                      // distinct strategies in the game
+    std::array<uint16_t, 4> ids;
+    std::array<double, 4> elo;
+    std::array<double, 4> mu;
+    std::array<double, 4> variance_scale;
+    std::array<bool, 4> won;            // every seat it held won
+};
+
+// standard normal density and distribution functions
+static double normal_pdf(double x)
+{
+    return exp(-0.5 * x * x) / sqrt(2 * M_PI);
+}
+
+static double normal_cdf(double x)
+{
+    return 0.5 * erfc(-x / sqrt(2.0));
+}
+
+// MODIFIES: changes
+// EFFECTS: Adds one seat's changes to those of strategy id
+static void add_seat(GameChanges &changes, uint16_t id, double elo, double mu,
+                     double variance_scale, bool won)
+{
+    int i = 0;
+    while (i < changes.count && changes.ids[i] != id)
+    {
+        i++;
+    }
+    if (i == changes.count)
+    {
+        changes.count++;
+        changes.ids[i] = id;
+        changes.elo[i] = changes.mu[i] = 0;
+        changes.variance_scale[i] = 1;
+        changes.won[i] = true;
+    }
+    changes.elo[i] += elo;
+    changes.mu[i] += mu;
+    changes.variance_scale[i] *= variance_scale;
+    changes.won[i] = changes.won[i] && won;
+}
+
+// EFFECTS: computes the rating changes for record from the current ratings
+static GameChanges compute_changes(const std::vector<Rating> &ratings, const GameRecord &record,
+                                   double elo_k, double beta, double tau)
+{
+    GameChanges changes;
+    const int winner = record.points[0] >= record.points[1] ? 0 : 1;
+
+    // team strength is the mean Elo of the partners and the sum of the
+    // TrueSkill means; c2 is the variance of the performance difference
+    std::array<double, 2> team_elo = {0, 0};
+    std::array<double, 2> team_mu = {0, 0};
+    std::array<double, 4> variance;
+    double c2 = 4 * beta * beta;
+    for (int seat = 0; seat < 4; seat++)
+    {
+        const Rating &rating = ratings[record.strategies[seat]];
+        team_elo[seat % 2] += rating.elo / 2;
+        team_mu[seat % 2] += rating.mu;
+        variance[seat] = rating.sigma * rating.sigma + tau * tau;
+        c2 += variance[seat];
+    }
+
+    const double c = sqrt(c2);
+    const double t = (team_mu[winner] - team_mu[1 - winner]) / c;
+    const double v = normal_pdf(t) / max(normal_cdf(t), 1e-300);
+    const double w = v * (v + t);
+
+    for (int seat = 0; seat < 4; seat++)
+    {
+        const int team = seat % 2;
+        const double expected = 1 / (1 + pow(10.0, (team_elo[1 - team] - team_elo[team]) / 400));
+        const double sign = team == winner ? 1 : -1;
+        add_seat(changes, record.strategies[seat],
+                 elo_k * ((team == winner ? 1 : 0) - expected),
+                 sign * variance[seat] / c * v,
+                 max(1 - variance[seat] / c2 * w, 1e-4), team == winner);
+    }
+    return changes;
+}
+
+RatingTable::RatingTable(double elo_k, double beta, double tau)
+    : elo_k(elo_k), beta(beta), tau(tau) {}
+
+uint16_t RatingTable::add_strategy(const std::string &name)
+{
+    auto found = find(names.begin(), names.end(), name);
+    if (found != names.end())
+    {
+        return uint16_t(found - names.begin());
+    }
+    assert(names.size() < 0xffff);
+    names.push_back(name);
+    ratings.push_back(Rating());
+    return uint16_t(names.size() - 1);
+}
+
+int RatingTable::size() const
+{
+    return int(names.size());
+}
+
+const std::string & RatingTable::get_name(uint16_t id) const
+{
+    return names[id];
+}
+
+const Rating & RatingTable::get_rating(uint16_t id) const
+{
+    return ratings[id];
+}
+
+void RatingTable::update(const GameRecord &record)
+{
+    const GameChanges changes = compute_changes(ratings, record, elo_k, beta, tau);
+    for (int i = 0; i < changes.count; i++)
+    {
+        Rating &rating = ratings[changes.ids[i]];
+        const double variance = rating.sigma * rating.sigma + tau * tau;
+        rating.elo += changes.elo[i];
+        rating.mu += changes.mu[i];
+        rating.sigma = sqrt(variance * changes.variance_scale[i]);
+        rating.games++;
+        rating.wins += changes.won[i];
+    }
+}
+
+void RatingTable::accumulate(const GameRecord &record, RatingDelta &delta) const
+{
+    const GameChanges changes = compute_changes(ratings, record, elo_k, beta, tau);
+    for (int i = 0; i < changes.count; i++)
+    {
+        RatingDelta::Entry &entry = delta.entries[changes.ids[i]];
+        entry.elo += changes.elo[i];
+        entry.mu += changes.mu[i];
+        entry.variance_scale *= changes.variance_scale[i];
+        entry.games++;
+        entry.wins += changes.won[i];
+    }
+    delta.num_games++;
+}
+
+void RatingTable::apply(RatingDelta &delta)
+{
+    assert(delta.entries.size() == ratings.size());
+    for (size_t i = 0; i < ratings.size(); i++)
+    {
+        RatingDelta::Entry &entry = delta.entries[i];
+        Rating &rating = ratings[i];
+        const double variance = rating.sigma * rating.sigma + entry.games * tau * tau;
+        rating.elo += entry.elo;
+        rating.mu += entry.mu;
+        rating.sigma = sqrt(variance * entry.variance_scale);
+        rating.games += entry.games;
+        rating.wins += entry.wins;
+        entry = RatingDelta::Entry();
+    }
+    delta.num_games = 0;
+}
+
+RatingDelta RatingTable::make_delta() const
+{
+    return RatingDelta(size());
+}
+
+uint64_t RatingTable::consume(std::istream &log)
+{
+    uint64_t count = 0;
+    GameRecord record;
+    while (read_game_record(log, record))
+    {
+        update(record);
+        count++;
+    }
+    return count;
+}
+
+void RatingTable::print(std::ostream &os) const
+{
+    std::vector<int> order(names.size());
+    for (size_t i = 0; i < order.size(); i++)
+    {
+        order[i] = int(i);
+    }
+    sort(order.begin(), order.end(), [this](int a, int b) {
+        return ratings[a].mu - 3 * ratings[a].sigma > ratings[b].mu - 3 * ratings[b].sigma;
+    });
+
+    // the table's formatting is put back for the caller when done
+    const ios::fmtflags flags = os.flags();
+    const streamsize precision = os.precision();
+    os << left << setw(16) << "strategy" << right << setw(8) << "elo"
+       << setw(8) << "mu" << setw(8) << "sigma" << setw(10) << "games"
+       << setw(8) << "win%" << std::endl;
+    for (int i : order)
+    {
+        const Rating &rating = ratings[i];
+        os << left << setw(16) << names[i] << right << fixed << setprecision(1)
+           << setw(8) << rating.elo << setw(8) << rating.mu << setw(8) << rating.sigma
+           << setw(10) << rating.games << setw(8)
+           << (rating.games ? 100.0 * rating.wins / rating.games : 0.0) << std::endl;
+    }
+    os.flags(flags);
+    os.precision(precision);
+}
@@ -0,0 +1,127 @@
+#ifndef RATING_HPP
+#define RATING_HPP
+/* Rating.hpp
+ *
+ * Incremental Elo and TrueSkill-style ratings for strategies, updated from
+ * a stream of game results.  Each seat is rated individually, so a
+ * strategy's rating reflects its play across all the partners it had.  A
+ * strategy seated more than once in a game (partnered with itself, say)
+ * has its seats' changes combined and counts the game once.
+ */
+
+#include <array>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Result of one game.  Seats 0 and 2 are partners, as are seats 1 and 3.
+struct GameRecord
+{
+    std::array<uint16_t, 4> strategies; // strategy id in each seat
+    std::array<uint8_t, 2> points;      // final points for each team
+};
+
+// Size of a GameRecord in a binary log
+const int GAME_RECORD_SIZE = 10;
+
+// EFFECTS: Appends record to os in the binary log format
+void write_game_record(std::ostream &os, const GameRecord &record);
+
+// MODIFIES: record
+// EFFECTS: Reads the next record from is.  Returns false at end of log.
+bool read_game_record(std::istream &is, GameRecord &record);
+
+struct Rating
+{
+    double elo = 1500;
+    double mu = 25;           // TrueSkill mean
+    double sigma = 25.0 / 3;  // TrueSkill standard deviation
+    uint64_t games = 0;
+    uint64_t wins = 0;
+};
+
+// Rating changes accumulated by one thread against a fixed snapshot.
+// Accumulators from several threads are combined with merge().
+class RatingDelta
+{
+public:
+    // EFFECTS: Creates an empty delta for num_strategies strategies
+    explicit RatingDelta(int num_strategies);
+
+    // EFFECTS: Adds delta to this one
+    void merge(const RatingDelta &delta);
+
+    // EFFECTS: returns the number of games accumulated
+    uint64_t size() const;
+
+private:
+    struct Entry
+    {
+        double elo = 0;
+        double mu = 0;
+        double variance_scale = 1; // product of sigma^2 update factors
+        uint64_t games = 0;
+        uint64_t wins = 0;
+    };
+    std::vector<Entry> entries;
+    uint64_t num_games;
+
+    friend class RatingTable;
+};
+
+class RatingTable
+{
+public:
+    // REQUIRES: elo_k > 0, beta > 0
+    // EFFECTS: Creates an empty table.  elo_k is the Elo K-factor, beta the
+    //          TrueSkill performance spread and tau the TrueSkill dynamics
+    //          factor added to each sigma before every game.
+    explicit RatingTable(double elo_k = 16, double beta = 25.0 / 6,
+                         double tau = 25.0 / 300);
+
+    // EFFECTS: Returns the id of strategy name, adding it if it is new
+    uint16_t add_strategy(const std::string &name);
+
+    // EFFECTS: returns the number of strategies
+    int size() const;
+
+    // REQUIRES: id < size()
+    const std::string & get_name(uint16_t id) const;
+    const Rating & get_rating(uint16_t id) const;
+
+    // REQUIRES: every strategy in record has been added
+    // EFFECTS: Updates the ratings of the strategies in record, each once
+    void update(const GameRecord &record);
+
+    // REQUIRES: every strategy in record has been added
+    // MODIFIES: delta
+    // EFFECTS: Adds the rating changes for record to delta, computed
+    //          against the current ratings without changing them.  Safe
+    //          to call from several threads while no thread calls
+    //          update() or apply().
+    void accumulate(const GameRecord &record, RatingDelta &delta) const;
+
+    // EFFECTS: Applies the changes collected in delta and clears it
+    void apply(RatingDelta &delta);
+
+    // EFFECTS: Returns an empty delta sized for this table
+    RatingDelta make_delta() const;
+
+    // EFFECTS: Updates ratings from every record in a binary log.
+    //          Returns the number of records read.
+    uint64_t consume(std::istream &log);
+
+    // EFFECTS: Prints a table of strategies ordered by TrueSkill
+    //          conservative rating (mu - 3 sigma)
+    void print(std::ostream &os) const;
+
+private:
+    std::vector<std::string> names;
+    std::vector<Rating> ratings;
+    const double elo_k;
+    const double beta;
+    const double tau;
+};
+
+#endif // RATING_HPP
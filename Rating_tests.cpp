@@ -0,0 +1,107 @@
+#include "Rating.hpp"
+#include "unit_test_framework.hpp"
+
+#include <iomanip>
+#include <sstream>
+
+using namespace std;
+
+TEST(test_rating_winners_gain) {
+    RatingTable table;
+    uint16_t a = table.add_strategy("A");
+    uint16_t b = table.add_strategy("B");
+    ASSERT_EQUAL(table.add_strategy("A"), a);
+
+    GameRecord record = {{a, b, a, b}, {10, 4}};
+    table.update(record);
+    ASSERT_TRUE(table.get_rating(a).elo > 1500);
+    ASSERT_TRUE(table.get_rating(b).elo < 1500);
+    ASSERT_TRUE(table.get_rating(a).mu > table.get_rating(b).mu);
+    ASSERT_TRUE(table.get_rating(a).sigma < 25.0 / 3);
+    // a strategy in two seats plays one game
+    ASSERT_EQUAL(table.get_rating(a).games, 1u);
+    ASSERT_EQUAL(table.get_rating(a).wins, 1u);
+}
+
+TEST(test_rating_print_keeps_stream_format) {
+    RatingTable table;
+    table.add_strategy("A");
+    ostringstream os;
+    os << setprecision(4);
+    table.print(os);
+
+    ostringstream after;
+    os.str("");
+    os << 2.0 / 3 << " " << 2.5;
+    after << setprecision(4) << 2.0 / 3 << " " << 2.5;
+    ASSERT_EQUAL(os.str(), after.str());
+}
+
+TEST(test_rating_log_round_trip) {
+    stringstream log;
+    GameRecord first = {{0, 1, 2, 3}, {10, 7}};
+    GameRecord second = {{3, 2, 1, 0}, {2, 11}};
+    write_game_record(log, first);
+    write_game_record(log, second);
+
+    RatingTable table;
+    for (const char *name : {"A", "B", "C", "D"}) {
+        table.add_strategy(name);
+    }
+    ASSERT_EQUAL(table.consume(log), 2u);
+    ASSERT_EQUAL(table.get_rating(0).wins, 2u);
+    ASSERT_EQUAL(table.get_rating(1).wins, 0u);
+    ASSERT_EQUAL(table.get_rating(0).games, 2u);
+}
+
+TEST(test_rating_merged_deltas) {
+    RatingTable table;
+    uint16_t a = table.add_strategy("A");
+    uint16_t b = table.add_strategy("B");
+
+    // two threads' worth of results against the same snapshot
+    RatingDelta first = table.make_delta();
+    RatingDelta second = table.make_delta();
+    table.accumulate({{a, b, a, b}, {10, 2}}, first);
+    table.accumulate({{b, a, b, a}, {3, 10}}, second);
+    first.merge(second);
+    ASSERT_EQUAL(first.size(), 2u);
+    table.apply(first);
+
+    ASSERT_EQUAL(first.size(), 0u);
+    ASSERT_EQUAL(table.get_rating(a).wins, 2u);
+    ASSERT_ALMOST_EQUAL(table.get_rating(a).elo + table.get_rating(b).elo, 3000.0, 1e-9);
+}
+
+TEST(test_rating_repeated_strategy) {
+    // a partnered with itself, then a on both teams
+    const vector<GameRecord> records = {{{0, 1, 0, 2}, {10, 6}},
+                                        {{0, 0, 1, 2}, {4, 10}}};
+    RatingTable updated;
+    RatingTable applied;
+    for (const char *name : {"A", "B", "C"}) {
+        updated.add_strategy(name);
+        applied.add_strategy(name);
+    }
+    for (const GameRecord &record : records) {
+        updated.update(record);
+        RatingDelta delta = applied.make_delta();
+        applied.accumulate(record, delta);
+        applied.apply(delta);
+        for (uint16_t id = 0; id < 3; id++) {
+            const Rating &one = updated.get_rating(id);
+            const Rating &other = applied.get_rating(id);
+            ASSERT_ALMOST_EQUAL(one.elo, other.elo, 1e-9);
+            ASSERT_ALMOST_EQUAL(one.mu, other.mu, 1e-9);
+            ASSERT_ALMOST_EQUAL(one.sigma, other.sigma, 1e-9);
+            ASSERT_EQUAL(one.games, other.games);
+            ASSERT_EQUAL(one.wins, other.wins);
+        }
+    }
+    const Rating &a = updated.get_rating(0);
+    ASSERT_EQUAL(a.games, 2u);
+    // the second game a won in one seat and lost in the other
+    ASSERT_EQUAL(a.wins, 1u);
+}
+
+TEST_MAIN()
@@ -0,0 +1,117 @@
+#ifndef RINGBUFFER_HPP
+#define RINGBUFFER_HPP
+/* RingBuffer.hpp
+ *
+ * A bounded lock-free queue for any number of producer and consumer
+ * threads.  Each slot carries a sequence number that says whether it is
+ * ready to be written or read on the current lap, so pushes and pops only
+ * contend on one atomic counter each and never take a lock.
+ */
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <memory>
+
+template <typename T>
+class RingBuffer
+{
+public:
+    // REQUIRES: capacity is a power of two
+    // EFFECTS: Creates an empty buffer holding up to capacity values
+    explicit RingBuffer(size_t capacity)
+        : slots(new Slot[capacity]), mask(capacity - 1), head(0), tail(0)
+    {
+        assert(capacity > 0 && (capacity & mask) == 0);
+        for (size_t i = 0; i < capacity; i++)
+        {
+            slots[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    RingBuffer(const RingBuffer &) = delete;
+    RingBuffer & operator=(const RingBuffer &) = delete;
+
+    // EFFECTS: returns the number of values the buffer can hold
+    size_t capacity() const
+    {
+        return mask + 1;
+    }
+
+    // MODIFIES: this
+    // EFFECTS: Appends value and returns true, or returns false if full
+    bool try_push(const T &value)
+    {
+        size_t position = head.load(std::memory_order_relaxed);
+        while (true)
+        {
+            Slot &slot = slots[position & mask];
+            const size_t sequence = slot.sequence.load(std::memory_order_acquire);
+            const long lag = long(sequence) - long(position);
+            if (lag == 0)
+            {
+                if (head.compare_exchange_weak(position, position + 1,
+                                               std::memory_order_relaxed))
+                {
+                    slot.value = value;
+                    slot.sequence.store(position + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (lag < 0)
+            {
+                return false; // a lap behind: the slot has not been read yet
+            }
+            else
+            {
+                position = head.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // MODIFIES: this, value
+    // EFFECTS: Removes the oldest value into value and returns true, or
+    //          returns false if empty
+    bool try_pop(T &value)
+    {
+        size_t position = tail.load(std::memory_order_relaxed);
+        while (true)
+        {
+            Slot &slot = slots[position & mask];
+            const size_t sequence = slot.sequence.load(std::memory_order_acquire);
+            const long lag = long(sequence) - long(position + 1);
+            if (lag == 0)
+            {
+                if (tail.compare_exchange_weak(position, position + 1,
+                                               std::memory_order_relaxed))
+                {
+                    value = slot.value;
+                    slot.sequence.store(position + mask + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (lag < 0)
+            {
+                return false; // nothing written to this slot yet
+            }
+            else
+            {
+                position = tail.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+private:
+    struct Slot
+    {
+        std::atomic<size_t> sequence;
+        T value;
+    };
+
+    std::unique_ptr<Slot[]> slots;
+    const size_t mask;
+    alignas(64) std::atomic<size_t> head; // next position to write
+    alignas(64) std::atomic<size_t> tail; // next position to read
+};
+
+#endif // RINGBUFFER_HPP
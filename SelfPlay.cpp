@@ -0,0 +1,327 @@
+#include "SelfPlay.hpp"
+#include "CardTracker.hpp"
+#include "Hand.hpp"
+#include "HandFeatures.hpp"
+#include <cassert>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iomanip>
+#include <limits>
+#include <memory>
+
+using namespace std;
+
+namespace
+{
+    const int NUM_PLAYERS = 4;
+    const int NUM_SUITS = 4;
+    // deals per task; each becomes one block, about 70 rows a deal
+    const int CHUNK_DEALS = 64;
+
+    uint32_t bit(int card)
+    {
+        return uint32_t(1) << card;
+    }
+
+    // One decision, kept until the hand is over and its points are known
+    struct Decision
+    {
+        int seat = 0;
+        DecisionKind kind = BID_DECISION;
+        uint32_t options = 0;       // suits for a bid, cards for a discard
+        int chosen = -1;            // suit or card, -1 for a pass
+        uint32_t hand = 0;          // bid: the hand held, discard: all six
+        int position = 0;           // bid: counted from the dealer's left
+        int round = 0;              // bid
+        PlayView view;              // lead or play
+    };
+
+    // MODIFIES: rows
+    // EFFECTS: Appends a row for each option of decision, discard being the
+    //          card the dealer threw away or -1
+    void add_rows(const Decision &decision, int number, const DealRecord &deal,
+                  int discard, int points, std::vector<DecisionRow> &rows)
+    {
+        DecisionRow row;
+        row.deal = deal.index;
+        row.decision = uint8_t(number);
+        row.seat = uint8_t(decision.seat);
+        row.kind = decision.kind;
+        row.points = int8_t(decision.seat % 2 == 0 ? points : -points);
+
+        PlayView view = decision.view;
+        uint32_t options = decision.options;
+        if (decision.kind >= LEAD_DECISION)
+        {
+            if (discard >= 0 && decision.seat == 0)
+            {
+                // the dealer's hand held the discard until now; it was never out
+                view.hand &= ~bit(discard);
+                view.trump_out |= bit(discard) & suit_masks(view.trump)[view.trump];
+            }
+            options = learned_legal(view);
+        }
+
+        for (; options; options &= options - 1)
+        {
+            const int option = __builtin_ctz(options);
+            row.option = uint8_t(option);
+            switch (decision.kind)
+            {
+            case BID_DECISION:
+            {
+                row.chosen = option == decision.chosen;
+                uint32_t hand = decision.hand;
+                if (decision.position == NUM_PLAYERS - 1 && decision.round == 1)
+                {
+                    // a dealer bids on the hand it would keep after picking up
+                    hand = (hand | bit(deal.upcard)) &
+                           ~bit(learned_discard(learned_model(), hand, deal.upcard,
+                                                Suit(option)));
+                }
+                learned_bid_inputs(hand, deal.upcard, decision.position, decision.round,
+                                   Suit(option), row.features.data());
+                break;
+            }
+            case DISCARD_DECISION:
+                row.chosen = option == discard;
+                learned_bid_inputs(decision.hand & ~bit(option), deal.upcard,
+                                   NUM_PLAYERS - 1, 1, view.trump, row.features.data());
+                break;
+            default:
+                row.chosen = option == decision.chosen;
+                learned_play_inputs(view, option, row.features.data());
+            }
+            rows.push_back(row);
+        }
+    }
+}
+
+int play_recorded_hand(const DealRecord &deal, const std::array<Player *, 4> &players,
+                       std::vector<DecisionRow> &rows)
+{
+    const int dealer = 0;
+    std::array<uint32_t, NUM_PLAYERS> hands = deal.hands;
+    CardTracker tracker;
+    Hand hand([&tracker, &players](const PlayerEvent &event) {
+        tracker.observe(event);
+        for (Player *player : players)
+        {
+            player->observe(event);
+        }
+    });
+    for (int player = 0; player < NUM_PLAYERS; player++)
+    {
+        for (uint32_t cards = hands[player]; cards; cards &= cards - 1)
+        {
+            players[player]->add_card(Card_from_index(__builtin_ctz(cards)));
+        }
+    }
+    const Card upcard = Card_from_index(deal.upcard);
+    const Suit upcard_suit = upcard.get_suit();
+    hand.start(dealer, upcard);
+
+    std::vector<Decision> decisions;
+    while (hand.get_phase() == Hand::BID)
+    {
+        assert(hand.get_round() <= 2);
+        Decision decision;
+        decision.seat = hand.to_act();
+        decision.hand = hands[decision.seat];
+        decision.position = (decision.seat + NUM_PLAYERS - 1 - dealer) % NUM_PLAYERS;
+        decision.round = hand.get_round();
+        const unsigned all_suits = (1u << NUM_SUITS) - 1;
+        decision.options = decision.round == 1 ? 1u << upcard_suit
+                                               : all_suits & ~(1u << upcard_suit);
+        Suit trump = upcard_suit;
+        const bool order_up = players[decision.seat]->make_trump(
+            upcard, decision.seat == dealer, decision.round, trump);
+        if (order_up)
+        {
+            decision.chosen = trump;
+        }
+        decisions.push_back(decision);
+        hand.bid(order_up, trump);
+    }
+    const Suit trump = hand.get_trump();
+
+    if (hand.get_phase() == Hand::DISCARD)
+    {
+        Decision decision;
+        decision.seat = dealer;
+        decision.kind = DISCARD_DECISION;
+        decision.hand = hands[dealer] | bit(deal.upcard);
+        decision.options = decision.hand;
+        decision.view.trump = trump;
+        decisions.push_back(decision);
+        players[dealer]->add_and_discard(upcard);
+        hands[dealer] = decision.hand;
+        hand.discard();
+    }
+
+    while (hand.get_phase() != Hand::OVER)
+    {
+        Decision decision;
+        decision.seat = hand.to_act();
+        const bool lead = hand.get_num_in_trick() == 0;
+        decision.kind = lead ? LEAD_DECISION : PLAY_DECISION;
+        decision.view = learned_view(tracker, decision.seat, hands[decision.seat]);
+        Player *player = players[decision.seat];
+        const Card card = lead ? player->lead_card(trump)
+                               : player->play_card(hand.get_led_card(), trump);
+        decision.chosen = Card_to_index(card);
+        hands[decision.seat] &= ~bit(decision.chosen);
+        decisions.push_back(decision);
+        hand.play(card);
+    }
+
+    // the dealer's one unplayed card is the discard
+    const int discard = tracker.is_upcard_taken() ? __builtin_ctz(hands[dealer]) : -1;
+    int team;
+    const int won = hand.get_points(team);
+    const int points = team == 0 ? won : -won;
+    for (size_t i = 0; i < decisions.size(); i++)
+    {
+        add_rows(decisions[i], int(i), deal, discard, points, rows);
+    }
+    return points;
+}
+
+bool run_self_play(const SelfPlayOptions &options, const std::string &path,
+                   ThreadPool &pool, SelfPlayStats &stats)
+{
+    std::vector<std::string> parts;
+    std::vector<std::unique_ptr<DecisionWriter>> writers;
+    bool ok = true;
+    for (int worker = 0; worker < pool.size(); worker++)
+    {
+        parts.push_back(path + ".part" + to_string(worker));
+        remove(parts.back().c_str());
+        // blocks end only at chunk ends, so they do not depend on the schedule
+        writers.emplace_back(new DecisionWriter(parts.back(),
+                                                numeric_limits<int>::max()));
+        ok = ok && writers.back()->is_open();
+    }
+
+    const int num_chunks = int((options.deals + CHUNK_DEALS - 1) / CHUNK_DEALS);
+    std::vector<long> decisions(num_chunks);
+    if (ok)
+    {
+        pool.parallel_for(num_chunks, [&](int worker, int c) {
+            const long first = long(c) * CHUNK_DEALS;
+            const int n = int(std::min<long>(CHUNK_DEALS, options.deals - first));
+            std::vector<DealRecord> deals(n);
+            generate_deals(options.seed, first, n, deals.data());
+            std::array<std::unique_ptr<Player>, NUM_PLAYERS> owned;
+            std::array<Player *, NUM_PLAYERS> players;
+            for (int player = 0; player < NUM_PLAYERS; player++)
+            {
+                owned[player].reset(Player_factory("Player " + to_string(player),
+                                                   options.strategies[player]));
+                players[player] = owned[player].get();
+            }
+            std::vector<DecisionRow> rows;
+            for (const DealRecord &deal : deals)
+            {
+                rows.clear();
+                play_recorded_hand(deal, players, rows);
+                decisions[c] += rows.back().decision + 1;
+                for (const DecisionRow &row : rows)
+                {
+                    writers[worker]->add(row);
+                }
+            }
+            writers[worker]->flush();
+        });
+    }
+
+    stats = SelfPlayStats();
+    stats.deals = options.deals;
+    for (long count : decisions)
+    {
+        stats.decisions += count;
+    }
+    for (const auto &writer : writers)
+    {
+        ok = ok && writer->is_open();
+        stats.rows += writer->get_rows();
+        stats.bytes += writer->get_bytes();
+    }
+    writers.clear();
+    ok = ok && merge_decision_logs(parts, path);
+    for (const std::string &part : parts)
+    {
+        remove(part.c_str());
+    }
+    return ok;
+}
+
+static void print_self_play_usage()
+{
+    cout << "Usage: euchre.exe --self-play FILE DEALS THREADS [--strategies S1 S2 S3 S4] "
+         << "[--seed N]" << endl;
+}
+
+int self_play_main(int argc, char **argv)
+{
+    if (argc < 5)
+    {
+        print_self_play_usage();
+        return 1;
+    }
+    const string path = argv[2];
+    SelfPlayOptions options;
+    options.deals = atol(argv[3]);
+    const int threads = atoi(argv[4]);
+    for (int i = 5; i < argc; i++)
+    {
+        const string option = argv[i];
+        if (option == "--strategies" && i + NUM_PLAYERS < argc)
+        {
+            for (string &strategy : options.strategies)
+            {
+                strategy = argv[++i];
+            }
+        }
+        else if (option == "--seed" && i + 1 < argc)
+        {
+            options.seed = strtoull(argv[++i], nullptr, 10);
+        }
+        else
+        {
+            print_self_play_usage();
+            return 1;
+        }
+    }
+    if (options.deals < 1 || threads < 0)
+    {
+        print_self_play_usage();
+        return 2;
+    }
+    for (const string &strategy : options.strategies)
+    {
+        if (!Player_strategy_exists(strategy) || Player_strategy_is_interactive(strategy))
+        {
+            cout << "Unknown or interactive strategy " << strategy << endl;
+            return 3;
+        }
+    }
+
+    ThreadPool pool(threads == 0 ? default_thread_count() : threads);
+    SelfPlayStats stats;
+    const auto start = chrono::steady_clock::now();
+    if (!run_self_play(options, path, pool, stats))
+    {
+        cout << "Error writing " << path << endl;
+        return 4;
+    }
+    const chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+    cout << "Recorded " << stats.decisions << " decisions as " << stats.rows
+         << " rows from " << stats.deals << " deals" << endl;
+    cout << fixed << setprecision(1) << "Wrote " << stats.bytes / 1e6 << " MB, "
+         << double(stats.bytes) / stats.rows << " bytes/row" << endl;
+    cout << setprecision(0) << stats.decisions / elapsed.count() << " decisions/s, "
+         << stats.rows / elapsed.count() << " rows/s" << endl;
+    return 0;
+}
@@ -0,0 +1,64 @@
+#ifndef SELFPLAY_HPP
+#define SELFPLAY_HPP
+/* SelfPlay.hpp
+ *
+ * Training data from self-play.  Seeded deals are played out by any
+ * registered strategies, and every decision they make (each make_trump,
+ * add_and_discard, lead_card and play_card call) becomes a row per
+ * option in a DecisionLog: the Learned features of the option, whether
+ * it was chosen, and the points the hand was worth to the player's team.
+ *
+ * Workers each append to a part file of their own, one block per chunk
+ * of deals, and the parts are merged in deal order at the end, so the
+ * output does not depend on the number of threads.
+ */
+
+#include <array>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "DealPipeline.hpp"
+#include "DecisionLog.hpp"
+#include "Player.hpp"
+#include "ThreadPool.hpp"
+
+// REQUIRES: players hold no cards, and one of them names trump in round
+//           two if all pass in round one
+// MODIFIES: players, rows
+// EFFECTS: Plays deal with players seated by player number, player 0
+//          dealing, and appends a row for each option of each decision.
+//          Returns the points won by players 0 and 2, or minus the points
+//          won by players 1 and 3.
+int play_recorded_hand(const DealRecord &deal, const std::array<Player *, 4> &players,
+                       std::vector<DecisionRow> &rows);
+
+struct SelfPlayOptions
+{
+    std::array<std::string, 4> strategies = {"Learned", "Learned", "Learned", "Learned"};
+    long deals = 100000;
+    uint64_t seed = 0;
+};
+
+struct SelfPlayStats
+{
+    long deals = 0;
+    long decisions = 0;
+    long rows = 0;
+    long bytes = 0;             // compressed, as appended to the file
+};
+
+// REQUIRES: every strategy is non-interactive
+// MODIFIES: stats
+// EFFECTS: Plays options.deals deals on pool and appends their rows to the
+//          decision log at path, through part files path.partN that are
+//          removed once merged.  Returns false if a file cannot be written.
+bool run_self_play(const SelfPlayOptions &options, const std::string &path,
+                   ThreadPool &pool, SelfPlayStats &stats);
+
+// EFFECTS: Runs self-play from command line arguments FILE DEALS THREADS
+//          [--strategies S1 S2 S3 S4] [--seed N] and prints the amount of
+//          data written and the rates.  Returns the process exit status.
+int self_play_main(int argc, char **argv);
+
+#endif // SELFPLAY_HPP
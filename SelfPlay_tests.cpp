@@ -0,0 +1,125 @@
+#include "SelfPlay.hpp"
+#include "unit_test_framework.hpp"
+
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <memory>
+
+using namespace std;
+
+static string read_file(const string &path) {
+    ifstream file(path, ios::binary);
+    return string((istreambuf_iterator<char>(file)), istreambuf_iterator<char>());
+}
+
+// EFFECTS: plays deal index with strategies and returns its rows
+static vector<DecisionRow> record(const array<string, 4> &strategies, uint64_t index,
+                                  int &points) {
+    array<unique_ptr<Player>, 4> owned;
+    array<Player *, 4> players;
+    for (int i = 0; i < 4; i++) {
+        owned[i].reset(Player_factory("Player " + to_string(i), strategies[i]));
+        players[i] = owned[i].get();
+    }
+    vector<DecisionRow> rows;
+    points = play_recorded_hand(make_deal(7, index), players, rows);
+    return rows;
+}
+
+TEST(test_rows_describe_the_hand) {
+    const array<string, 4> simple = {"Simple", "Simple", "Simple", "Simple"};
+    for (uint64_t index = 0; index < 200; index++) {
+        int points = 0;
+        const vector<DecisionRow> rows = record(simple, index, points);
+        ASSERT_TRUE(points == 1 || points == 2 || points == -1 || points == -2);
+
+        // decisions are numbered in order; bids come first, then an
+        // optional discard, then 20 cards with exactly one chosen each
+        int played = 0;
+        int ordered = 0;
+        int discards = 0;
+        for (size_t r = 0; r < rows.size(); r++) {
+            const DecisionRow &row = rows[r];
+            ASSERT_EQUAL(row.deal, index);
+            ASSERT_EQUAL(row.points, int8_t(row.seat % 2 == 0 ? points : -points));
+            if (r > 0) {
+                ASSERT_TRUE(row.decision == rows[r - 1].decision ||
+                            row.decision == rows[r - 1].decision + 1);
+            }
+            played += row.chosen && row.kind >= LEAD_DECISION;
+            ordered += row.chosen && row.kind == BID_DECISION;
+            discards += row.chosen && row.kind == DISCARD_DECISION;
+        }
+        ASSERT_EQUAL(played, 20);
+        ASSERT_EQUAL(ordered, 1);
+        ASSERT_TRUE(discards <= 1);
+    }
+}
+
+TEST(test_learned_choices_score_best) {
+    // the features recorded are the ones a Learned player scored, so its
+    // choice is the best-scoring option of every card and discard decision
+    const array<string, 4> learned = {"Learned", "Learned", "Learned", "Learned"};
+    const LearnedModel &model = learned_model();
+    int discards = 0;
+    for (uint64_t index = 0; index < 200; index++) {
+        int points = 0;
+        const vector<DecisionRow> rows = record(learned, index, points);
+        for (size_t first = 0, last = 0; first < rows.size(); first = last) {
+            float best = -1e30f;
+            int chosen_score = 0;
+            for (last = first; last < rows.size() &&
+                               rows[last].decision == rows[first].decision; last++) {
+                const Network &network =
+                    rows[last].kind >= LEAD_DECISION ? model.play : model.bid;
+                const float score = network.evaluate(rows[last].features.data());
+                if (rows[last].chosen) {
+                    chosen_score = score >= best;
+                }
+                best = max(best, score);
+            }
+            if (rows[first].kind != BID_DECISION) {
+                ASSERT_EQUAL(chosen_score, 1);
+                discards += rows[first].kind == DISCARD_DECISION;
+            }
+        }
+    }
+    ASSERT_TRUE(discards > 10);
+}
+
+TEST(test_output_does_not_depend_on_threads) {
+    SelfPlayOptions options;
+    options.strategies = {"Learned", "Simple", "SimpleTable", "Simple"};
+    options.deals = 300;
+    options.seed = 3;
+    const string one = "SelfPlay_tests_one.bin";
+    const string three = "SelfPlay_tests_three.bin";
+    remove(one.c_str());
+    remove(three.c_str());
+    SelfPlayStats stats;
+    {
+        ThreadPool pool(1);
+        ASSERT_TRUE(run_self_play(options, one, pool, stats));
+    }
+    SelfPlayStats stats3;
+    {
+        ThreadPool pool(3);
+        ASSERT_TRUE(run_self_play(options, three, pool, stats3));
+    }
+    ASSERT_EQUAL(read_file(one), read_file(three));
+    ASSERT_EQUAL(stats.decisions, stats3.decisions);
+    ASSERT_FALSE(ifstream(three + ".part1").good());
+
+    vector<DecisionRow> rows;
+    ASSERT_TRUE(read_decisions(one, rows));
+    ASSERT_EQUAL(long(rows.size()), stats.rows);
+    ASSERT_EQUAL(stats.deals, 300l);
+    ASSERT_EQUAL(rows.back().deal, uint64_t(299));
+    // every deal has at least one bid and twenty cards
+    ASSERT_TRUE(stats.decisions >= 300 * 21);
+    remove(one.c_str());
+    remove(three.c_str());
+}
+
+TEST_MAIN()
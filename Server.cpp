@@ -0,0 +1,395 @@
+#include "Server.hpp"
+#include <algorithm>
+#include <arpa/inet.h>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <iostream>
+#include <netinet/in.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+using namespace std;
+
+// Longest line a client may send
+static const size_t MAX_LINE = 256;
+
+// How long to hold off accepting after running out of file descriptors,
+// unless a connection closes first
+static const std::chrono::milliseconds ACCEPT_BACKOFF(100);
+
+static bool set_nonblocking(int fd)
+{
+    int flags = fcntl(fd, F_GETFL, 0);
+    return flags >= 0 && fcntl(fd, F_SETFL, flags | O_NONBLOCK) == 0;
+}
+
+Server::Server(int points_to_win)
+    : points_to_win(points_to_win), epoll_fd(epoll_create1(0)), tables_started(0),
+      stopping(false), accepting(true) {}
+
+Server::~Server()
+{
+    for (auto &entry : connections)
+    {
+        close(entry.first);
+    }
+    for (int fd : listeners)
+    {
+        close(fd);
+    }
+    if (epoll_fd >= 0)
+    {
+        close(epoll_fd);
+    }
+}
+
+bool Server::add_listener(int fd)
+{
+    epoll_event event;
+    memset(&event, 0, sizeof(event));
+    event.events = EPOLLIN;
+    event.data.fd = fd;
+    if (listen(fd, SOMAXCONN) != 0 || !set_nonblocking(fd) ||
+        epoll_ctl(epoll_fd, EPOLL_CTL_ADD, fd, &event) != 0)
+    {
+        close(fd);
+        return false;
+    }
+    listeners.push_back(fd);
+    return true;
+}
+
+bool Server::listen_tcp(int port)
+{
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0)
+    {
+        return false;
+    }
+    int yes = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &yes, sizeof(yes));
+    sockaddr_in address;
+    memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_port = htons(uint16_t(port));
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (bind(fd, reinterpret_cast<sockaddr *>(&address), sizeof(address)) != 0)
+    {
+        close(fd);
+        return false;
+    }
+    return add_listener(fd);
+}
+
+bool Server::listen_unix(const std::string &path)
+{
+    sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(address.sun_path))
+    {
+        return false;
+    }
+    strcpy(address.sun_path, path.c_str());
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0)
+    {
+        return false;
+    }
+    unlink(path.c_str());
+    if (bind(fd, reinterpret_cast<sockaddr *>(&address), sizeof(address)) != 0)
+    {
+        close(fd);
+        return false;
+    }
+    return add_listener(fd);
+}
+
+bool Server::run()
+{
+    stopping = false;
+    while (!stopping)
+    {
+        if (!step(-1))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool Server::step(int timeout_ms)
+{
+    const int MAX_EVENTS = 256;
+    epoll_event events[MAX_EVENTS];
+    if (!accepting)
+    {
+        // wake up in time to try accepting again
+        const auto left = std::chrono::ceil<std::chrono::milliseconds>(
+            resume_accepting - std::chrono::steady_clock::now());
+        const int backoff_ms = int(std::max<long>(0, left.count()));
+        timeout_ms = timeout_ms < 0 ? backoff_ms : std::min(timeout_ms, backoff_ms);
+    }
+    int count = epoll_wait(epoll_fd, events, MAX_EVENTS, timeout_ms);
+    if (count < 0)
+    {
+        return errno == EINTR;
+    }
+    for (int i = 0; i < count; i++)
+    {
+        const int fd = events[i].data.fd;
+        if (find(listeners.begin(), listeners.end(), fd) != listeners.end())
+        {
+            accept_all(fd);
+            continue;
+        }
+        auto found = connections.find(fd);
+        if (found == connections.end())
+        {
+            continue;
+        }
+        Connection &connection = *found->second;
+        if (events[i].events & (EPOLLERR | EPOLLHUP))
+        {
+            close_connection(fd);
+            continue;
+        }
+        if (events[i].events & EPOLLIN)
+        {
+            on_readable(connection);
+        }
+        else if (events[i].events & EPOLLOUT)
+        {
+            flush(connection);
+        }
+    }
+    if (!accepting && std::chrono::steady_clock::now() >= resume_accepting)
+    {
+        watch_listeners(true);
+    }
+    return true;
+}
+
+void Server::stop()
+{
+    stopping = true;
+}
+
+int Server::num_connections() const
+{
+    return int(connections.size());
+}
+
+bool Server::is_accepting() const
+{
+    return accepting;
+}
+
+void Server::watch_listeners(bool watch)
+{
+    for (int fd : listeners)
+    {
+        epoll_event event;
+        memset(&event, 0, sizeof(event));
+        event.events = watch ? EPOLLIN : 0;
+        event.data.fd = fd;
+        epoll_ctl(epoll_fd, EPOLL_CTL_MOD, fd, &event);
+    }
+    accepting = watch;
+}
+
+void Server::accept_all(int listener)
+{
+    while (true)
+    {
+        int fd = accept(listener, nullptr, nullptr);
+        if (fd < 0)
+        {
+            if (errno == EINTR || errno == ECONNABORTED || errno == EPROTO)
+            {
+                continue;
+            }
+            if (errno == EMFILE || errno == ENFILE || errno == ENOBUFS || errno == ENOMEM)
+            {
+                // the pending connection stays queued and the listener
+                // stays readable, so stop watching it for a while rather
+                // than spin
+                std::cerr << "accept failed: " << strerror(errno) << std::endl;
+                watch_listeners(false);
+                resume_accepting = std::chrono::steady_clock::now() + ACCEPT_BACKOFF;
+            }
+            return; // EAGAIN once the backlog is empty
+        }
+        epoll_event event;
+        memset(&event, 0, sizeof(event));
+        event.events = EPOLLIN;
+        event.data.fd = fd;
+        if (!set_nonblocking(fd) || epoll_ctl(epoll_fd, EPOLL_CTL_ADD, fd, &event) != 0)
+        {
+            close(fd);
+            continue;
+        }
+        std::unique_ptr<Connection> connection(new Connection);
+        connection->fd = fd;
+        connection->out = "Welcome to euchre, please enter your name:\n";
+        Connection &added = *connection;
+        connections[fd] = std::move(connection);
+        flush(added);
+    }
+}
+
+void Server::on_readable(Connection &connection)
+{
+    char buffer[4096];
+    ssize_t n = read(connection.fd, buffer, sizeof(buffer));
+    if (n == 0 || (n < 0 && errno != EAGAIN && errno != EINTR))
+    {
+        close_connection(connection.fd);
+        return;
+    }
+    if (n < 0)
+    {
+        return;
+    }
+    connection.in.append(buffer, n);
+
+    const int fd = connection.fd;
+    size_t newline;
+    while ((newline = connection.in.find('\n')) != std::string::npos)
+    {
+        std::string line = connection.in.substr(0, newline);
+        connection.in.erase(0, newline + 1);
+        if (!line.empty() && line.back() == '\r')
+        {
+            line.pop_back();
+        }
+        on_line(connection, line);
+        if (connections.find(fd) == connections.end() || connection.closing)
+        {
+            return;
+        }
+    }
+    if (connection.in.size() > MAX_LINE)
+    {
+        close_connection(fd);
+    }
+}
+
+void Server::on_line(Connection &connection, const std::string &line)
+{
+    if (!connection.table)
+    {
+        // the first line is the human's name; the bots fill the other seats
+        const std::string name = line.empty() ? "Human" : line;
+        connection.table.reset(new Table({name, "Bot1", "Bot2", "Bot3"},
+                                         {"Human", "Simple", "Simple", "Simple"},
+                                         points_to_win, tables_started++));
+        connection.table->advance();
+    }
+    else if (connection.table->waiting_seat() != -1)
+    {
+        connection.table->input(line);
+    }
+    connection.out += connection.table->take_output();
+    connection.closing = connection.table->is_over();
+    flush(connection);
+}
+
+void Server::flush(Connection &connection)
+{
+    while (!connection.out.empty())
+    {
+        // a client that has hung up gives EPIPE here rather than SIGPIPE,
+        // which would end every table the server is hosting
+        ssize_t n = send(connection.fd, connection.out.data(), connection.out.size(),
+                         MSG_NOSIGNAL);
+        if (n < 0)
+        {
+            if (errno == EAGAIN || errno == EINTR)
+            {
+                break;
+            }
+            close_connection(connection.fd);
+            return;
+        }
+        connection.out.erase(0, n);
+    }
+
+    if (connection.out.empty() && connection.closing)
+    {
+        close_connection(connection.fd);
+        return;
+    }
+
+    // watch for writability only while output is pending
+    const bool want_write = !connection.out.empty();
+    if (want_write != connection.want_write)
+    {
+        epoll_event event;
+        memset(&event, 0, sizeof(event));
+        event.events = want_write ? EPOLLIN | EPOLLOUT : EPOLLIN;
+        event.data.fd = connection.fd;
+        epoll_ctl(epoll_fd, EPOLL_CTL_MOD, connection.fd, &event);
+        connection.want_write = want_write;
+    }
+}
+
+void Server::close_connection(int fd)
+{
+    epoll_ctl(epoll_fd, EPOLL_CTL_DEL, fd, nullptr);
+    close(fd);
+    connections.erase(fd);
+    if (!accepting)
+    {
+        // a descriptor is free again
+        watch_listeners(true);
+    }
+}
+
+int server_main(int argc, char **argv)
+{
+    const char *usage = "Usage: euchre.exe --serve POINTS_TO_WIN [--port N] [--socket PATH]";
+    if (argc < 3)
+    {
+        std::cout << usage << std::endl;
+        return 1;
+    }
+    const int points_to_win = atoi(argv[2]);
+    if (points_to_win < 1 || points_to_win > 100)
+    {
+        std::cout << usage << std::endl;
+        return 1;
+    }
+
+    Server server(points_to_win);
+    bool listening = false;
+    for (int i = 3; i + 1 < argc; i += 2)
+    {
+        const std::string option = argv[i];
+        bool ok = false;
+        if (option == "--port")
+        {
+            ok = server.listen_tcp(atoi(argv[i + 1]));
+        }
+        else if (option == "--socket")
+        {
+            ok = server.listen_unix(argv[i + 1]);
+        }
+        if (!ok)
+        {
+            std::cout << "Cannot listen with " << option << " " << argv[i + 1] << std::endl;
+            return 2;
+        }
+        listening = true;
+    }
+    if (!listening)
+    {
+        std::cout << usage << std::endl;
+        return 1;
+    }
+    return server.run() ? 0 : 3;
+}
@@ -0,0 +1,100 @@
+#ifndef SERVER_HPP
+#define SERVER_HPP
+/* Server.hpp
+ *
+ * Game server for human players over TCP or Unix sockets.  One thread
+ * runs an epoll event loop over every connection.  Each connection is a
+ * human at their own Table with three Simple bots; bot moves are computed
+ * inline as soon as the human's move arrives.
+ *
+ * Protocol: the server asks for a name, the client sends it as a line, and
+ * from then on the server sends game output and prompts exactly as
+ * HumanPlayer does, and the client answers each prompt with a line.  The
+ * connection is closed when the game ends.
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "Table.hpp"
+
+class Server
+{
+public:
+    // REQUIRES: points_to_win >= 1
+    explicit Server(int points_to_win);
+
+    ~Server();
+
+    Server(const Server &) = delete;
+    Server & operator=(const Server &) = delete;
+
+    // EFFECTS: Listens for TCP connections on 127.0.0.1:port.  Returns
+    //          false on error.
+    bool listen_tcp(int port);
+
+    // EFFECTS: Listens for connections on the Unix socket at path.
+    //          Returns false on error.
+    bool listen_unix(const std::string &path);
+
+    // EFFECTS: Serves connections until stop() is called or an error
+    //          occurs.  Returns false on error.
+    bool run();
+
+    // EFFECTS: Waits up to timeout_ms (-1 for no limit) for events and
+    //          handles them.  Returns false on error.
+    bool step(int timeout_ms);
+
+    // EFFECTS: Makes run() return after the current event
+    void stop();
+
+    // EFFECTS: returns the number of open connections
+    int num_connections() const;
+
+    // EFFECTS: returns false while new connections are held off because
+    //          the process is out of file descriptors
+    bool is_accepting() const;
+
+private:
+    struct Connection
+    {
+        int fd;
+        std::string in;
+        std::string out;
+        std::unique_ptr<Table> table;
+        bool want_write = false;
+        bool closing = false; // close once out has been sent
+    };
+
+    const int points_to_win;
+    int epoll_fd;
+    std::vector<int> listeners;
+    std::unordered_map<int, std::unique_ptr<Connection>> connections;
+    uint64_t tables_started;
+    bool stopping;
+    bool accepting;
+    std::chrono::steady_clock::time_point resume_accepting;
+
+    bool add_listener(int fd);
+    void accept_all(int listener);
+
+    // EFFECTS: starts or stops watching the listeners for connections
+    void watch_listeners(bool watch);
+    void on_readable(Connection &connection);
+    void on_line(Connection &connection, const std::string &line);
+
+    // EFFECTS: sends as much of connection.out as the socket accepts and
+    //          watches for writability if any is left
+    void flush(Connection &connection);
+    void close_connection(int fd);
+};
+
+// EFFECTS: Runs the server from command line arguments
+//          --serve POINTS_TO_WIN [--port N] [--socket PATH].
+//          Returns the exit status.
+int server_main(int argc, char **argv);
+
+#endif // SERVER_HPP
@@ -0,0 +1,116 @@
+#include "Server.hpp"
+#include "unit_test_framework.hpp"
+
+#include <fcntl.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+using namespace std;
+
+static const string PATH = "Server_tests.sock";
+
+// EFFECTS: returns a nonblocking socket connected to the server at PATH
+static int connect_client() {
+    sockaddr_un address = {};
+    address.sun_family = AF_UNIX;
+    PATH.copy(address.sun_path, PATH.size());
+    const int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    ASSERT_TRUE(fd >= 0);
+    ASSERT_EQUAL(connect(fd, reinterpret_cast<sockaddr *>(&address), sizeof(address)), 0);
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+    return fd;
+}
+
+// MODIFIES: server, received
+// EFFECTS: Steps server and reads what it sends to client until received
+//          holds text.  Returns false if it never arrives.
+static bool receive(Server &server, int client, const string &text, string &received) {
+    for (int i = 0; i < 100 && received.find(text) == string::npos; i++) {
+        ASSERT_TRUE(server.step(20));
+        char buffer[4096];
+        ssize_t n;
+        while ((n = read(client, buffer, sizeof(buffer))) > 0) {
+            received.append(buffer, n);
+        }
+    }
+    return received.find(text) != string::npos;
+}
+
+TEST(test_server_round_trip) {
+    Server server(1);
+    ASSERT_TRUE(server.listen_unix(PATH));
+    const int client = connect_client();
+    string received;
+    ASSERT_TRUE(receive(server, client, "please enter your name:\n", received));
+    ASSERT_EQUAL(server.num_connections(), 1);
+
+    // the name starts a game, which runs until the human's first turn
+    received.clear();
+    const string name = "Ada\n";
+    ASSERT_EQUAL(write(client, name.data(), name.size()), ssize_t(name.size()));
+    ASSERT_TRUE(receive(server, client, "Human player Ada, please", received));
+    ASSERT_TRUE(received.find("Bot1") != string::npos);
+
+    close(client);
+    for (int i = 0; i < 100 && server.num_connections() > 0; i++) {
+        ASSERT_TRUE(server.step(20));
+    }
+    ASSERT_EQUAL(server.num_connections(), 0);
+    unlink(PATH.c_str());
+}
+
+TEST(test_server_survives_client_that_hangs_up) {
+    Server server(1);
+    ASSERT_TRUE(server.listen_unix(PATH));
+    const int client = connect_client();
+    string received;
+    ASSERT_TRUE(receive(server, client, "please enter your name:\n", received));
+
+    // the client stops reading after sending its name, so the reply goes
+    // to a socket that has hung up
+    const string name = "Ada\n";
+    ASSERT_EQUAL(write(client, name.data(), name.size()), ssize_t(name.size()));
+    ASSERT_EQUAL(shutdown(client, SHUT_RD), 0);
+    for (int i = 0; i < 100 && server.num_connections() > 0; i++) {
+        ASSERT_TRUE(server.step(20));
+    }
+    ASSERT_EQUAL(server.num_connections(), 0);
+    close(client);
+    unlink(PATH.c_str());
+}
+
+TEST(test_server_backs_off_without_descriptors) {
+    Server server(1);
+    ASSERT_TRUE(server.listen_unix(PATH));
+
+    // leave room for exactly one more descriptor: the client's
+    rlimit saved;
+    getrlimit(RLIMIT_NOFILE, &saved);
+    const int lowest_free = dup(0);
+    close(lowest_free);
+    rlimit tight = saved;
+    tight.rlim_cur = lowest_free + 1;
+    ASSERT_EQUAL(setrlimit(RLIMIT_NOFILE, &tight), 0);
+    const int client = connect_client();
+
+    // accepting fails, and the server stops watching the listener rather
+    // than waking for it again at once
+    ASSERT_TRUE(server.step(20));
+    ASSERT_FALSE(server.is_accepting());
+    ASSERT_EQUAL(server.num_connections(), 0);
+    ASSERT_TRUE(server.step(0));
+    ASSERT_FALSE(server.is_accepting());
+
+    // once descriptors are free it takes the waiting connection
+    setrlimit(RLIMIT_NOFILE, &saved);
+    string received;
+    ASSERT_TRUE(receive(server, client, "please enter your name:\n", received));
+    ASSERT_TRUE(server.is_accepting());
+    ASSERT_EQUAL(server.num_connections(), 1);
+    close(client);
+    unlink(PATH.c_str());
+}
+
+TEST_MAIN()
@@ -0,0 +1,207 @@
+#include "SimpleTable.hpp"
+#include "HandIndex.hpp"
+#include <array>
+#include <cassert>
+#include <vector>
+
+using namespace std;
+
+namespace
+{
+    const int NUM_CARDS = 24;
+    const int NUM_SUITS = 4;
+    const int MAX_HAND = 5;
+
+    // first index of the hands of each size
+    constexpr std::array<uint32_t, MAX_HAND + 2> SIZE_OFFSETS = {
+        0, 1, 1 + 24, 1 + 24 + 276, 1 + 24 + 276 + 2024, 1 + 24 + 276 + 2024 + 10626,
+        NUM_SMALL_HANDS};
+
+    // Decisions, by hand index and then context
+    struct Tables
+    {
+        std::array<uint32_t, NUM_SUITS> good{};
+        std::array<std::array<int8_t, NUM_CARDS>, NUM_SUITS> strength{};
+        std::array<std::array<int8_t, NUM_CARDS>, NUM_SUITS> suit_of{};
+        // bit (upcard suit * 4 + (round - 1) * 2 + dealer)
+        std::vector<uint16_t> orders_up;
+        // [hand][trump]
+        std::vector<int8_t> lead;
+        std::vector<int8_t> lowest;
+        // [hand][trump][led suit]
+        std::vector<int8_t> play;
+    };
+
+    Tables build()
+    {
+        Tables tables;
+        std::array<std::array<int8_t, NUM_CARDS>, NUM_SUITS> &suit_of = tables.suit_of;
+        for (int trump = 0; trump < NUM_SUITS; trump++)
+        {
+            const Card trump_ten(TEN, Suit(trump));
+            for (int card = 0; card < NUM_CARDS; card++)
+            {
+                const Card c = Card_from_index(card);
+                int below = 0;
+                for (int other = 0; other < NUM_CARDS; other++)
+                {
+                    below += Card_less(Card_from_index(other), c, Suit(trump));
+                }
+                tables.strength[trump][card] = int8_t(below);
+                suit_of[trump][card] = int8_t(c.get_suit(Suit(trump)));
+                if (Card_less(trump_ten, c, Suit(trump)))
+                {
+                    tables.good[trump] |= uint32_t(1) << card;
+                }
+            }
+        }
+
+        tables.orders_up.assign(NUM_SMALL_HANDS, 0);
+        tables.lead.assign(size_t(NUM_SMALL_HANDS) * NUM_SUITS, -1);
+        tables.lowest.assign(size_t(NUM_SMALL_HANDS) * NUM_SUITS, -1);
+        tables.play.assign(size_t(NUM_SMALL_HANDS) * NUM_SUITS * NUM_SUITS, -1);
+        for (int size = 0; size <= MAX_HAND; size++)
+        {
+            for (uint32_t rank = 0; rank < binomial(NUM_CARDS, size); rank++)
+            {
+                const uint32_t hand = unrank_cards(rank, size);
+                const size_t index = SIZE_OFFSETS[size] + rank;
+
+                // make_trump: two good trumps in round one, one of the next
+                // suit in round two, and the dealer always names one then
+                for (int suit = 0; suit < NUM_SUITS; suit++)
+                {
+                    const int next = Suit_next(Suit(suit));
+                    const bool one = __builtin_popcount(hand & tables.good[suit]) >= 2;
+                    const bool two = __builtin_popcount(hand & tables.good[next]) >= 1;
+                    tables.orders_up[index] |= uint16_t((one << (suit * 4)) |
+                                                        (one << (suit * 4 + 1)) |
+                                                        (two << (suit * 4 + 2)) |
+                                                        (1 << (suit * 4 + 3)));
+                }
+                if (size == 0)
+                {
+                    continue;
+                }
+
+                for (int trump = 0; trump < NUM_SUITS; trump++)
+                {
+                    const std::array<int8_t, NUM_CARDS> &strength = tables.strength[trump];
+                    // highest non-trump, else highest trump; lowest of all
+                    int lead = -1;
+                    int lowest = -1;
+                    std::array<int, NUM_SUITS> highest_in_suit = {-1, -1, -1, -1};
+                    for (uint32_t cards = hand; cards; cards &= cards - 1)
+                    {
+                        const int card = __builtin_ctz(cards);
+                        const bool is_trump = suit_of[trump][card] == trump;
+                        if (lead == -1 || (suit_of[trump][lead] == trump && !is_trump) ||
+                            ((suit_of[trump][lead] == trump) == is_trump &&
+                             strength[card] > strength[lead]))
+                        {
+                            lead = card;
+                        }
+                        if (lowest == -1 || strength[card] < strength[lowest])
+                        {
+                            lowest = card;
+                        }
+                        int &highest = highest_in_suit[suit_of[trump][card]];
+                        if (highest == -1 || strength[card] > strength[highest])
+                        {
+                            highest = card;
+                        }
+                    }
+                    tables.lead[index * NUM_SUITS + trump] = int8_t(lead);
+                    tables.lowest[index * NUM_SUITS + trump] = int8_t(lowest);
+
+                    // follow with the highest card of the led suit, else
+                    // throw the lowest card
+                    for (int led = 0; led < NUM_SUITS; led++)
+                    {
+                        const int play = highest_in_suit[led] != -1 ? highest_in_suit[led] : lowest;
+                        tables.play[(index * NUM_SUITS + trump) * NUM_SUITS + led] = int8_t(play);
+                    }
+                }
+            }
+        }
+        return tables;
+    }
+
+    const Tables & tables()
+    {
+        static const Tables built = build();
+        return built;
+    }
+}
+
+uint32_t small_hand_index(uint32_t hand)
+{
+    const int size = __builtin_popcount(hand);
+    assert(size <= MAX_HAND);
+    return SIZE_OFFSETS[size] + uint32_t(rank_cards(hand));
+}
+
+uint32_t simple_good_cards(Suit trump)
+{
+    return tables().good[trump];
+}
+
+bool simple_orders_up(uint32_t hand, Suit upcard_suit, bool is_dealer, int round)
+{
+    assert(round == 1 || round == 2);
+    const int bit = upcard_suit * 4 + (round - 1) * 2 + is_dealer;
+    return (tables().orders_up[small_hand_index(hand)] >> bit) & 1;
+}
+
+int simple_lead(uint32_t hand, Suit trump)
+{
+    assert(hand);
+    return tables().lead[size_t(small_hand_index(hand)) * NUM_SUITS + trump];
+}
+
+int simple_play(uint32_t hand, Suit led_suit, Suit trump)
+{
+    assert(hand);
+    const size_t index = small_hand_index(hand);
+    return tables().play[(index * NUM_SUITS + trump) * NUM_SUITS + led_suit];
+}
+
+int simple_discard(uint32_t hand, int upcard, Suit trump)
+{
+    assert(hand && !(hand & (uint32_t(1) << upcard)));
+    const Tables &t = tables();
+    const int lowest = t.lowest[size_t(small_hand_index(hand)) * NUM_SUITS + trump];
+    return t.strength[trump][upcard] < t.strength[trump][lowest] ? upcard : lowest;
+}
+
+int simple_tricks(const std::array<uint32_t, 4> &hands, Suit trump, int leader)
+{
+    const Tables &t = tables();
+    const std::array<int8_t, NUM_CARDS> &strength = t.strength[trump];
+    const std::array<int8_t, NUM_CARDS> &suit_of = t.suit_of[trump];
+    std::array<uint32_t, 4> held = hands;
+    int tricks = 0;
+    while (held[leader])
+    {
+        int high = simple_lead(held[leader], trump);
+        held[leader] &= ~(uint32_t(1) << high);
+        const Suit led_suit = Suit(suit_of[high]);
+        int winner = leader;
+        for (int i = 1; i < 4; i++)
+        {
+            const int player = (leader + i) % 4;
+            const int card = simple_play(held[player], led_suit, trump);
+            held[player] &= ~(uint32_t(1) << card);
+            // the high card is of the led suit or trump
+            if (suit_of[card] == suit_of[high] ? strength[card] > strength[high]
+                                               : suit_of[card] == trump)
+            {
+                high = card;
+                winner = player;
+            }
+        }
+        tricks += winner % 2 == 0;
+        leader = winner;
+    }
+    return tricks;
+}
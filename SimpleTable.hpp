@@ -0,0 +1,52 @@
+#ifndef SIMPLETABLE_HPP
+#define SIMPLETABLE_HPP
+/* SimpleTable.hpp
+ *
+ * Every decision of the Simple strategy, precomputed.  Simple's choices
+ * depend only on the cards held and a little context (upcard suit, round,
+ * dealer flag, trump, led suit), so each table is indexed by the rank of
+ * the hand among all hands of at most five cards and the context packed
+ * into the low bits.  A decision is then one memory lookup.  The tables
+ * are built once, on first use, in well under a second.
+ *
+ * Hands are bitmasks of Card_to_index bits, as in GameState.
+ */
+
+#include <array>
+#include <cstdint>
+#include "Card.hpp"
+
+// Number of hands of zero to five cards from the 24-card pack
+const uint32_t NUM_SMALL_HANDS = 1 + 24 + 276 + 2024 + 10626 + 42504;
+
+// REQUIRES: hand holds at most five cards
+// EFFECTS: returns the hand's index in [0, NUM_SMALL_HANDS)
+uint32_t small_hand_index(uint32_t hand);
+
+// EFFECTS: returns the cards that beat the ten of trump: the bowers and
+//          the queen, king and ace of trump
+uint32_t simple_good_cards(Suit trump);
+
+// REQUIRES: hand holds at most five cards, round is 1 or 2
+// EFFECTS: returns true if Simple orders up holding hand; it names the
+//          upcard's suit in round one and the next suit in round two
+bool simple_orders_up(uint32_t hand, Suit upcard_suit, bool is_dealer, int round);
+
+// REQUIRES: hand holds one to five cards
+// EFFECTS: returns the card index Simple leads
+int simple_lead(uint32_t hand, Suit trump);
+
+// REQUIRES: hand holds one to five cards
+// EFFECTS: returns the card index Simple plays when led_suit is led
+int simple_play(uint32_t hand, Suit led_suit, Suit trump);
+
+// REQUIRES: hand holds one to five cards, upcard is not in hand
+// EFFECTS: returns the card index Simple discards after picking up upcard
+int simple_discard(uint32_t hand, int upcard, Suit trump);
+
+// REQUIRES: hands, by player number, hold equal numbers of cards
+// EFFECTS: returns the tricks players 0 and 2 take when all four play the
+//          hands out as Simple does, leader leading the first trick
+int simple_tricks(const std::array<uint32_t, 4> &hands, Suit trump, int leader);
+
+#endif // SIMPLETABLE_HPP
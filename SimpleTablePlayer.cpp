@@ -0,0 +1,10 @@
+#include "SimpleTablePlayer.hpp"
+
+// EFFECTS: returns a new SimpleTablePlayer called name
+static Player * make_simple_table_player(const std::string &name)
+{
+    return new SimpleTablePlayer(name);
+}
+
+static const bool registered = Player_register("SimpleTable", make_simple_table_player,
+                                               true);
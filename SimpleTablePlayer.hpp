@@ -0,0 +1,92 @@
+#ifndef SIMPLETABLEPLAYER_HPP
+#define SIMPLETABLEPLAYER_HPP
+/* SimpleTablePlayer.hpp
+ *
+ * The "SimpleTable" strategy, kept out of Player.cpp so that programs
+ * using only the built-in players do not link the decision tables.
+ * Linking SimpleTablePlayer.cpp registers it with Player_factory.
+ */
+
+#include <cstdint>
+#include <string>
+#include "Player.hpp"
+#include "SimpleTable.hpp"
+
+// Makes exactly the decisions of SimplePlayer, each one read from the
+// precomputed tables in SimpleTable.hpp
+class SimpleTablePlayer : public Player
+{
+public:
+    SimpleTablePlayer(std::string name_in) : name(name_in), hand(0) {}
+
+    // EFFECTS returns player's name
+    const std::string &get_name() const override
+    {
+        return name;
+    }
+
+    // REQUIRES player has less than MAX_HAND_SIZE cards
+    // EFFECTS  adds Card c to Player's hand
+    void add_card(const Card &c) override
+    {
+        hand |= bit(c);
+    }
+
+    // REQUIRES round is 1 or 2
+    // MODIFIES order_up_suit
+    // EFFECTS If Player wishes to order up a trump suit then return true and
+    //   change order_up_suit to desired suit.  If Player wishes to pass, then do
+    //   not modify order_up_suit and return false.
+    bool make_trump(const Card &upcard, bool is_dealer,
+                    int round, Suit &order_up_suit) const override
+    {
+        if (!simple_orders_up(hand, upcard.get_suit(), is_dealer, round))
+        {
+            return false;
+        }
+        order_up_suit = round == 1 ? upcard.get_suit() : Suit_next(upcard.get_suit());
+        return true;
+    }
+
+    // REQUIRES Player has at least one card
+    // EFFECTS  Player adds one card to hand and removes one card from hand.
+    void add_and_discard(const Card &upcard) override
+    {
+        const int upcard_index = Card_to_index(upcard);
+        hand |= bit(upcard);
+        hand &= ~(uint32_t(1) << simple_discard(hand & ~bit(upcard), upcard_index,
+                                                upcard.get_suit()));
+    }
+
+    // REQUIRES Player has at least one card
+    // EFFECTS  Leads one Card from Player's hand according to their strategy
+    Card lead_card(Suit trump) override
+    {
+        return remove(simple_lead(hand, trump));
+    }
+
+    // REQUIRES Player has at least one card
+    // EFFECTS  Plays one Card from Player's hand according to their strategy.
+    Card play_card(const Card &led_card, Suit trump) override
+    {
+        return remove(simple_play(hand, led_card.get_suit(trump), trump));
+    }
+
+protected:
+    std::string name;
+    uint32_t hand; // one bit per Card_to_index
+
+    static uint32_t bit(const Card &c)
+    {
+        return uint32_t(1) << Card_to_index(c);
+    }
+
+    // EFFECTS removes card index from the hand and returns its Card
+    Card remove(int index)
+    {
+        hand &= ~(uint32_t(1) << index);
+        return Card_from_index(index);
+    }
+};
+
+#endif // SIMPLETABLEPLAYER_HPP
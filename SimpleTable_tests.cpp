@@ -0,0 +1,154 @@
+#include "SimpleTable.hpp"
+#include "Game.hpp"
+#include "HandIndex.hpp"
+#include "Player.hpp"
+#include "Random.hpp"
+#include "unit_test_framework.hpp"
+
+#include <memory>
+#include <sstream>
+
+using namespace std;
+
+static uint32_t bit(const Card &card) {
+    return uint32_t(1) << Card_to_index(card);
+}
+
+static unique_ptr<Player> simple_player(uint32_t hand) {
+    unique_ptr<Player> player(Player_factory("Simple", "Simple"));
+    for (uint32_t cards = hand; cards; cards &= cards - 1) {
+        player->add_card(Card_from_index(__builtin_ctz(cards)));
+    }
+    return player;
+}
+
+TEST(test_small_hand_index_is_dense) {
+    ASSERT_EQUAL(small_hand_index(0), 0u);
+    ASSERT_EQUAL(small_hand_index(1), 1u);
+    ASSERT_EQUAL(small_hand_index(0xf80000), NUM_SMALL_HANDS - 1);
+}
+
+TEST(test_make_trump_matches_simple_on_every_deal) {
+    for (uint32_t rank = 0; rank < NUM_HANDS; rank++) {
+        const uint32_t hand = unrank_hand(rank);
+        const unique_ptr<Player> player = simple_player(hand);
+        for (int upcard = 0; upcard < 24; upcard++) {
+            if (hand & (uint32_t(1) << upcard)) {
+                continue;
+            }
+            const Card up = Card_from_index(upcard);
+            for (int round = 1; round <= 2; round++) {
+                for (bool dealer : {false, true}) {
+                    Suit suit = SPADES;
+                    const bool expected = player->make_trump(up, dealer, round, suit);
+                    ASSERT_EQUAL(simple_orders_up(hand, up.get_suit(), dealer, round), expected);
+                }
+            }
+        }
+    }
+}
+
+TEST(test_lead_and_play_match_simple_on_every_hand) {
+    for (int size = 1; size <= 5; size++) {
+        for (uint64_t rank = 0; rank < binomial(24, size); rank++) {
+            const uint32_t hand = unrank_cards(rank, size);
+            const unique_ptr<Player> player = simple_player(hand);
+            for (int trump = SPADES; trump <= DIAMONDS; trump++) {
+                // each card played is handed back, so the hand is unchanged
+                Card card = player->lead_card(Suit(trump));
+                ASSERT_EQUAL(simple_lead(hand, Suit(trump)), Card_to_index(card));
+                player->add_card(card);
+                for (int led = 0; led < 24; led++) {
+                    if (hand & (uint32_t(1) << led)) {
+                        continue;
+                    }
+                    const Card led_card = Card_from_index(led);
+                    card = player->play_card(led_card, Suit(trump));
+                    ASSERT_EQUAL(simple_play(hand, led_card.get_suit(Suit(trump)), Suit(trump)),
+                                 Card_to_index(card));
+                    player->add_card(card);
+                }
+            }
+        }
+    }
+}
+
+TEST(test_discard_matches_simple_on_every_pickup) {
+    for (uint32_t rank = 0; rank < NUM_HANDS; rank++) {
+        const uint32_t hand = unrank_hand(rank);
+        for (int upcard = 0; upcard < 24; upcard++) {
+            if (hand & (uint32_t(1) << upcard)) {
+                continue;
+            }
+            const Card up = Card_from_index(upcard);
+            const unique_ptr<Player> player = simple_player(hand);
+            player->add_and_discard(up);
+            // the discard is the card no longer held
+            uint32_t kept = 0;
+            for (int i = 0; i < 5; i++) {
+                kept |= bit(player->lead_card(up.get_suit()));
+            }
+            const uint32_t discarded = (hand | bit(up)) & ~kept;
+            ASSERT_EQUAL(discarded, uint32_t(1) << simple_discard(hand, upcard, up.get_suit()));
+        }
+    }
+}
+
+TEST(test_tricks_match_simple_players) {
+    Random random(9);
+    for (int deal = 0; deal < 2000; deal++) {
+        array<int, 24> cards;
+        for (int i = 0; i < 24; i++) {
+            cards[i] = i;
+            swap(cards[i], cards[random.below(i + 1)]);
+        }
+        array<uint32_t, 4> hands{};
+        for (int i = 0; i < 20; i++) {
+            hands[i / 5] |= uint32_t(1) << cards[i];
+        }
+        const Suit trump = Suit(random.below(4));
+        int leader = int(random.below(4));
+        const int expected_leader = leader;
+
+        array<unique_ptr<Player>, 4> players;
+        for (int p = 0; p < 4; p++) {
+            players[p] = simple_player(hands[p]);
+        }
+        int tricks = 0;
+        for (int trick = 0; trick < 5; trick++) {
+            const Card led = players[leader]->lead_card(trump);
+            Card high = led;
+            int winner = leader;
+            for (int i = 1; i < 4; i++) {
+                const int p = (leader + i) % 4;
+                const Card card = players[p]->play_card(led, trump);
+                if (Card_less(high, card, led, trump)) {
+                    high = card;
+                    winner = p;
+                }
+            }
+            tricks += winner % 2 == 0;
+            leader = winner;
+        }
+        ASSERT_EQUAL(simple_tricks(hands, trump, expected_leader), tricks);
+    }
+}
+
+TEST(test_table_player_plays_the_same_games) {
+    for (uint64_t seed = 1; seed <= 5; seed++) {
+        string transcripts[2];
+        for (int t = 0; t < 2; t++) {
+            const string strategy = t == 0 ? "Simple" : "SimpleTable";
+            istringstream pack_input;
+            ostringstream output;
+            Game game(pack_input, false, 10, {"A", "B", "C", "D"},
+                      {strategy, strategy, strategy, strategy}, output);
+            game.use_random_shuffle(seed);
+            game.play();
+            transcripts[t] = output.str();
+        }
+        ASSERT_EQUAL(transcripts[0], transcripts[1]);
+    }
+}
+
+TEST_MAIN()
@@ -0,0 +1,62 @@
+#include "Solver.hpp"
+#include <algorithm>
+
+Solver::Solver(const Tablebase *tablebase) : tablebase(tablebase), nodes(0) {}
+
+int Solver::solve(const GameState &state)
+{
+    GameState copy = state;
+    return search(copy, -1, GameState::num_tricks + 1);
+}
+
+long Solver::get_nodes() const
+{
+    return nodes;
+}
+
+int Solver::search(GameState &state, int alpha, int beta)
+{
+    nodes++;
+    const int taken = state.get_tricks(0);
+    if (state.is_terminal())
+    {
+        return taken;
+    }
+
+    if (tablebase && state.get_num_played() % GameState::num_players == 0)
+    {
+        const int rest = tablebase->probe(state);
+        if (rest >= 0)
+        {
+            return taken + rest;
+        }
+    }
+
+    const bool maximize = state.to_move() % 2 == 0;
+    int best = maximize ? -1 : GameState::num_tricks + 1;
+    uint32_t moves = state.legal_moves();
+    while (moves)
+    {
+        const int card = __builtin_ctz(moves);
+        moves &= moves - 1;
+        state.apply(card);
+        const int value = search(state, alpha, beta);
+        state.undo();
+
+        if (maximize)
+        {
+            best = std::max(best, value);
+            alpha = std::max(alpha, best);
+        }
+        else
+        {
+            best = std::min(best, value);
+            beta = std::min(beta, best);
+        }
+        if (alpha >= beta)
+        {
+            break;
+        }
+    }
+    return best;
+}
@@ -0,0 +1,35 @@
+#ifndef SOLVER_HPP
+#define SOLVER_HPP
+/* Solver.hpp
+ *
+ * Double-dummy solver for the card play of a hand: every hand is visible
+ * and both sides play perfectly.  Alpha-beta search over GameState, which
+ * stops at the tablebase's depth when one is given.
+ */
+
+#include "GameState.hpp"
+#include "Tablebase.hpp"
+
+class Solver
+{
+public:
+    // EFFECTS: Creates a solver that probes tablebase, if not null, once
+    //          few enough tricks are left
+    explicit Solver(const Tablebase *tablebase = nullptr);
+
+    // EFFECTS: returns the number of tricks team 0 takes in the whole
+    //          hand when play continues perfectly from state
+    int solve(const GameState &state);
+
+    // EFFECTS: returns the number of positions searched so far
+    long get_nodes() const;
+
+private:
+    const Tablebase *tablebase;
+    long nodes;
+
+    // MODIFIES: state (restored before returning)
+    int search(GameState &state, int alpha, int beta);
+};
+
+#endif // SOLVER_HPP
@@ -0,0 +1,322 @@
+#include "Table.hpp"
+#include "Random.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cstdlib>
+#include <sstream>
+
+using namespace std;
+
+// MODIFIES: suit
+// EFFECTS: Parses a suit name.  Returns false if str is not a suit.
+static bool parse_suit(const std::string &str, Suit &suit)
+{
+    for (int s = SPADES; s <= DIAMONDS; s++)
+    {
+        ostringstream name;
+        name << Suit(s);
+        if (str == name.str())
+        {
+            suit = Suit(s);
+            return true;
+        }
+    }
+    return false;
+}
+
+// MODIFIES: value
+// EFFECTS: Parses a whole line as an integer.  Returns false otherwise.
+static bool parse_int(const std::string &str, int &value)
+{
+    char *end;
+    long parsed = strtol(str.c_str(), &end, 10);
+    if (end == str.c_str() || *end != '\0')
+    {
+        return false;
+    }
+    value = int(parsed);
+    return true;
+}
+
+Table::Table(const std::array<std::string, num_players> &names_in,
+             const std::array<std::string, num_players> &strategies,
+             int points_to_win, uint64_t seed)
+    : names(names_in), points({0, 0}), points_to_win(points_to_win), seed(seed),
+      hand_number(0), dealer(0),
+      hand([this](const PlayerEvent &event) { notify(event); }), phase(DEAL),
+      prompted(false)
+{
+    for (int i = 0; i < num_players; i++)
+    {
+        if (!Player_strategy_is_interactive(strategies[i]))
+        {
+            bots[i].reset(Player_factory(names[i], strategies[i]));
+        }
+    }
+    hand.narrate(output, names);
+}
+
+void Table::advance()
+{
+    while (step())
+    {
+    }
+}
+
+int Table::waiting_seat() const
+{
+    if (phase != HAND || !is_human(hand.to_act()))
+    {
+        return -1;
+    }
+    return hand.to_act();
+}
+
+bool Table::is_over() const
+{
+    return phase == GAME_OVER;
+}
+
+std::string Table::take_output()
+{
+    std::string result = output.str();
+    output.str("");
+    return result;
+}
+
+bool Table::is_human(int seat) const
+{
+    return !bots[seat];
+}
+
+std::string Table::team_names(int team) const
+{
+    return names[team] + " and " + names[team + 2];
+}
+
+bool Table::step()
+{
+    if (phase == GAME_OVER)
+    {
+        return false;
+    }
+    if (phase == DEAL)
+    {
+        deal();
+        return true;
+    }
+    if (phase == SCORE)
+    {
+        score();
+        return true;
+    }
+
+    if (waiting_seat() != -1)
+    {
+        if (!prompted)
+        {
+            prompt();
+            prompted = true;
+        }
+        return false;
+    }
+    play_bot();
+    if (hand.get_phase() == Hand::OVER)
+    {
+        phase = SCORE;
+    }
+    return true;
+}
+
+void Table::play_bot()
+{
+    const int seat = hand.to_act();
+    Player &bot = *bots[seat];
+    const Card upcard = hand.get_upcard();
+    if (hand.get_phase() == Hand::BID)
+    {
+        Suit suit = upcard.get_suit();
+        const bool order_up = bot.make_trump(upcard, seat == dealer, hand.get_round(),
+                                             suit);
+        hand.bid(order_up, suit);
+    }
+    else if (hand.get_phase() == Hand::DISCARD)
+    {
+        bot.add_and_discard(upcard);
+        hand.discard();
+    }
+    else if (hand.get_num_in_trick() == 0)
+    {
+        hand.play(bot.lead_card(hand.get_trump()));
+    }
+    else
+    {
+        hand.play(bot.play_card(hand.get_led_card(), hand.get_trump()));
+    }
+}
+
+bool Table::input(const std::string &line)
+{
+    const int seat = waiting_seat();
+    assert(seat != -1);
+    prompted = false;
+    std::vector<Card> &hand_cards = hands[seat];
+    const Card upcard = hand.get_upcard();
+    const int round = hand.get_round();
+    int index = 0;
+    bool accepted = false;
+
+    if (hand.get_phase() == Hand::BID)
+    {
+        Suit suit = upcard.get_suit();
+        // the dealer must name a suit if everyone passes twice
+        if (line == "pass" && !(round == 2 && seat == dealer))
+        {
+            hand.bid(false, suit);
+            accepted = true;
+        }
+        else if (parse_suit(line, suit) && (suit == upcard.get_suit()) == (round == 1))
+        {
+            hand.bid(true, suit);
+            accepted = true;
+        }
+    }
+    else if (hand.get_phase() == Hand::DISCARD)
+    {
+        if (parse_int(line, index) && index >= -1 && index < int(hand_cards.size()))
+        {
+            // -1 discards the upcard instead of picking it up
+            if (index != -1)
+            {
+                remove_card(seat, index);
+                hand_cards.push_back(upcard);
+                sort(hand_cards.begin(), hand_cards.end());
+            }
+            hand.discard();
+            accepted = true;
+        }
+    }
+    else if (parse_int(line, index) && index >= 0 && index < int(hand_cards.size()))
+    {
+        // a player who can follow the led suit must do so
+        const Suit trump = hand.get_trump();
+        const bool leading = hand.get_num_in_trick() == 0;
+        bool can_follow = false;
+        for (const Card &card : hand_cards)
+        {
+            can_follow |= !leading &&
+                          card.get_suit(trump) == hand.get_led_card().get_suit(trump);
+        }
+        if (!can_follow ||
+            hand_cards[index].get_suit(trump) == hand.get_led_card().get_suit(trump))
+        {
+            hand.play(remove_card(seat, index));
+            accepted = true;
+        }
+    }
+
+    if (!accepted)
+    {
+        output << "Invalid choice\n";
+    }
+    else if (hand.get_phase() == Hand::OVER)
+    {
+        phase = SCORE;
+    }
+    advance();
+    return accepted;
+}
+
+void Table::deal()
+{
+    output << "Hand " << hand_number << "\n";
+    pack.shuffle(derive_seed(seed, hand_number));
+    Hand::Deal cards;
+    const Card upcard = Hand::deal(pack, dealer, cards);
+    for (int seat = 0; seat < num_players; seat++)
+    {
+        for (const Card &card : cards[seat])
+        {
+            if (is_human(seat))
+            {
+                hands[seat].push_back(card);
+            }
+            else
+            {
+                bots[seat]->add_card(card);
+            }
+        }
+        sort(hands[seat].begin(), hands[seat].end());
+    }
+
+    hand.start(dealer, upcard);
+    phase = HAND;
+}
+
+void Table::score()
+{
+    hand.score(points);
+    output << team_names(0) << " have " << points[0] << " points\n";
+    output << team_names(1) << " have " << points[1] << " points\n\n";
+
+    hand_number++;
+    dealer = (dealer + 1) % num_players;
+    phase = DEAL;
+    for (int team = 0; team < 2; team++)
+    {
+        if (points[team] >= points_to_win)
+        {
+            output << team_names(team) << " win!\n";
+            phase = GAME_OVER;
+        }
+    }
+}
+
+void Table::notify(const PlayerEvent &event)
+{
+    for (const std::unique_ptr<Player> &bot : bots)
+    {
+        if (bot)
+        {
+            bot->observe(event);
+        }
+    }
+}
+
+void Table::prompt()
+{
+    const int seat = waiting_seat();
+    print_hand(seat);
+    if (hand.get_phase() == Hand::BID)
+    {
+        output << "Human player " << names[seat]
+               << ", please enter a suit, or \"pass\":\n";
+    }
+    else if (hand.get_phase() == Hand::DISCARD)
+    {
+        output << "Discard upcard: [-1]\n";
+        output << "Human player " << names[seat]
+               << ", please select a card to discard:\n";
+    }
+    else
+    {
+        output << "Human player " << names[seat] << ", please select a card:\n";
+    }
+}
+
+void Table::print_hand(int seat)
+{
+    for (size_t i = 0; i < hands[seat].size(); ++i)
+    {
+        output << "Human player " << names[seat] << "'s hand: "
+               << "[" << i << "] " << hands[seat][i] << "\n";
+    }
+}
+
+Card Table::remove_card(int seat, int i)
+{
+    std::vector<Card> &hand_cards = hands[seat];
+    Card card = hand_cards[i];
+    hand_cards.erase(hand_cards.begin() + i);
+    return card;
+}
@@ -0,0 +1,102 @@
+#ifndef TABLE_HPP
+#define TABLE_HPP
+/* Table.hpp
+ *
+ * A game of euchre that runs one step at a time, so it can wait for a
+ * remote human without blocking a thread.  Bot seats are played inline by
+ * a Player; human seats are asked for decisions through prompts in the
+ * table's output and answer with lines of input.
+ */
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "Card.hpp"
+#include "Hand.hpp"
+#include "Pack.hpp"
+#include "Player.hpp"
+
+class Table
+{
+public:
+    static const int num_players = 4;
+
+    // REQUIRES: strategies are Player_factory strategies; "Human" seats
+    //           are played through input() instead of a Player
+    // EFFECTS: Creates a table.  Each hand is dealt from a random shuffle
+    //          drawn from seed.
+    Table(const std::array<std::string, num_players> &names,
+          const std::array<std::string, num_players> &strategies,
+          int points_to_win, uint64_t seed);
+
+    // EFFECTS: Plays until a human decision is needed or the game is over
+    void advance();
+
+    // EFFECTS: returns the seat whose decision is needed, or -1 if the
+    //          table is not waiting for a human
+    int waiting_seat() const;
+
+    // REQUIRES: waiting_seat() != -1
+    // EFFECTS: Applies a human decision and advances the game.  Returns
+    //          false and prompts again if line is not a legal decision.
+    bool input(const std::string &line);
+
+    // EFFECTS: returns true if a team has won
+    bool is_over() const;
+
+    // EFFECTS: returns the game output produced since the last call
+    std::string take_output();
+
+private:
+    enum Phase
+    {
+        DEAL,
+        HAND, // the hand says whose decision it is
+        SCORE,
+        GAME_OVER,
+    };
+
+    std::array<std::string, num_players> names;
+    std::array<std::unique_ptr<Player>, num_players> bots; // null for humans
+    std::array<std::vector<Card>, num_players> hands;      // humans only
+    std::array<int, 2> points;
+    int points_to_win;
+    uint64_t seed;
+    Pack pack;
+    int hand_number;
+    int dealer;
+    Hand hand;
+
+    Phase phase;
+    bool prompted; // the waiting human has been sent a prompt
+
+    std::ostringstream output;
+
+    // EFFECTS: performs one step of the game; returns false if waiting
+    //          for a human or the game is over
+    bool step();
+
+    bool is_human(int seat) const;
+    std::string team_names(int team) const;
+
+    void deal();
+    void score();
+
+    // EFFECTS: tells every bot about event, as Game does
+    void notify(const PlayerEvent &event);
+
+    // EFFECTS: asks the bot whose turn it is for the hand's next decision
+    void play_bot();
+
+    // EFFECTS: writes the prompt for the waiting human to output
+    void prompt();
+    void print_hand(int seat);
+
+    // EFFECTS: removes and returns card i of a human's hand
+    Card remove_card(int seat, int i);
+};
+
+#endif // TABLE_HPP
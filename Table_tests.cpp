@@ -0,0 +1,73 @@
+#include "Table.hpp"
+#include "Game.hpp"
+#include "unit_test_framework.hpp"
+
+#include <sstream>
+
+using namespace std;
+
+static const array<string, 4> NAMES = {"Edsger", "Fran", "Gabriel", "Herb"};
+
+TEST(test_table_bots_match_game) {
+    Table table(NAMES, {"Simple", "Simple", "Simple", "Simple"}, 10, 7);
+    table.advance();
+    ASSERT_TRUE(table.is_over());
+    ASSERT_EQUAL(table.waiting_seat(), -1);
+
+    istringstream no_pack;
+    ostringstream game_output;
+    Game game(no_pack, false, 10, NAMES, {"Simple", "Simple", "Simple", "Simple"}, game_output);
+    game.use_random_shuffle(7);
+    game.play();
+    ASSERT_EQUAL(table.take_output(), game_output.str());
+}
+
+TEST(test_table_tracking_bots_match_game) {
+    // Learned bots bid from their position and play from what they have
+    // seen, so they only decide as in a Game if the table tells them the
+    // same events
+    const array<string, 4> learned = {"Learned", "Learned", "Learned", "Learned"};
+    for (uint64_t seed : {3, 8, 21}) {
+        Table table(NAMES, learned, 10, seed);
+        table.advance();
+        ASSERT_TRUE(table.is_over());
+
+        istringstream no_pack;
+        ostringstream game_output;
+        Game game(no_pack, false, 10, NAMES, learned, game_output);
+        game.use_random_shuffle(seed);
+        game.play();
+        ASSERT_EQUAL(table.take_output(), game_output.str());
+    }
+}
+
+TEST(test_table_human_seat) {
+    Table table(NAMES, {"Human", "Simple", "Simple", "Simple"}, 3, 11);
+    table.advance();
+    int moves = 0;
+    while (!table.is_over()) {
+        ASSERT_EQUAL(table.waiting_seat(), 0);
+        string output = table.take_output();
+        ASSERT_TRUE(output.find("Human player Edsger") != string::npos);
+
+        // nonsense is rejected and the prompt repeated
+        ASSERT_FALSE(table.input("nonsense"));
+        ASSERT_TRUE(table.take_output().find("Invalid choice") != string::npos);
+
+        // pass when allowed, otherwise name a legal suit, otherwise play
+        // the first legal card
+        bool accepted = table.input("pass");
+        for (const char *choice : {"Spades", "Hearts", "Clubs", "Diamonds",
+                                   "0", "1", "2", "3", "4"}) {
+            if (accepted) {
+                break;
+            }
+            accepted = table.input(choice);
+        }
+        ASSERT_TRUE(accepted);
+        ASSERT_TRUE(++moves < 1000);
+    }
+    ASSERT_TRUE(table.take_output().find(" win!") != string::npos);
+}
+
+TEST_MAIN()
@@ -0,0 +1,571 @@
+#include "Tablebase.hpp"
+#include "ThreadPool.hpp"
+#include <cassert>
+#include <cstdlib>
+#include <fcntl.h>
+#include <fstream>
+#include <iostream>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace std;
+
+// File layout: magic "EUTB", u32 version, u32 max_tricks, u32 reserved,
+// all little endian, then the one-byte entries for 1, 2, ... tricks left
+static const char TABLEBASE_MAGIC[4] = {'E', 'U', 'T', 'B'};
+static const uint32_t TABLEBASE_VERSION = 1;
+static const size_t HEADER_SIZE = 16;
+
+namespace
+{
+    const int SUIT_SLOTS = 7;
+    const uint32_t SUIT_MASK = (1u << SUIT_SLOTS) - 1;
+    const int MAX_TRUMP = 7;
+    const int MAX_PLAIN = 6;
+    const int COMPOSITION_KEYS = (MAX_TRUMP + 1) * (MAX_PLAIN + 1) * (MAX_PLAIN + 1) *
+                                 (MAX_PLAIN + 1);
+    const int MAX_QUOTA = Tablebase::max_supported;
+
+    int composition_key(const int counts[4])
+    {
+        return counts[0] +
+               (MAX_TRUMP + 1) * (counts[1] + (MAX_PLAIN + 1) * (counts[2] + (MAX_PLAIN + 1) *
+                                                                                 counts[3]));
+    }
+
+    // Number of owner sequences with the given cards left for each seat
+    struct Multinomials
+    {
+        uint64_t count[MAX_QUOTA + 1][MAX_QUOTA + 1][MAX_QUOTA + 1][MAX_QUOTA + 1];
+    };
+
+    constexpr Multinomials make_multinomials()
+    {
+        uint64_t factorial[4 * MAX_QUOTA + 1] = {1};
+        for (int i = 1; i <= 4 * MAX_QUOTA; i++)
+        {
+            factorial[i] = factorial[i - 1] * i;
+        }
+        Multinomials table{};
+        for (int a = 0; a <= MAX_QUOTA; a++)
+            for (int b = 0; b <= MAX_QUOTA; b++)
+                for (int c = 0; c <= MAX_QUOTA; c++)
+                    for (int d = 0; d <= MAX_QUOTA; d++)
+                    {
+                        table.count[a][b][c][d] = factorial[a + b + c + d] / factorial[a] /
+                                                  factorial[b] / factorial[c] / factorial[d];
+                    }
+        return table;
+    }
+
+    constexpr Multinomials MULTINOMIALS = make_multinomials();
+
+    uint64_t multinomial(const int quota[4])
+    {
+        return MULTINOMIALS.count[quota[0]][quota[1]][quota[2]][quota[3]];
+    }
+
+    // Canonical slot of each card (by Card_to_index) under each trump
+    struct Slots
+    {
+        int slot[4][24];
+    };
+
+    constexpr Slots make_slots()
+    {
+        Slots slots{};
+        const int jack = JACK - NINE;
+        for (int trump = 0; trump < 4; trump++)
+        {
+            const int next = (trump + 2) % 4;
+            for (int card = 0; card < 24; card++)
+            {
+                const int suit = card / 6;
+                const int rank = card % 6;
+                const int from_top = 5 - rank;
+                int slot = 0;
+                if (rank == jack && suit == trump)
+                {
+                    slot = 0;
+                }
+                else if (rank == jack && suit == next)
+                {
+                    slot = 1;
+                }
+                else if (suit == trump)
+                {
+                    // Ace, King, Queen under the bowers, then Ten and Nine
+                    slot = 2 + from_top - (rank < jack ? 1 : 0);
+                }
+                else
+                {
+                    const int plain = 1 + suit - (suit > trump ? 1 : 0);
+                    slot = plain * SUIT_SLOTS + from_top;
+                }
+                slots.slot[trump][card] = slot;
+            }
+        }
+        return slots;
+    }
+
+    constexpr Slots SLOTS = make_slots();
+
+    // EFFECTS: returns the trick winner's seat, given each seat's card
+    int trick_winner(const int played[4])
+    {
+        const int led_suit = played[0] / SUIT_SLOTS;
+        int winner = 0;
+        int best = played[0];
+        for (int seat = 1; seat < 4; seat++)
+        {
+            const int card = played[seat];
+            const int suit = card / SUIT_SLOTS;
+            // trump beats everything, otherwise only the led suit can win;
+            // within a suit the lower slot is the higher card
+            const bool best_trump = best < SUIT_SLOTS;
+            const bool beats = suit == 0 ? (!best_trump || card < best)
+                                         : (!best_trump && suit == led_suit && card < best);
+            if (beats)
+            {
+                winner = seat;
+                best = card;
+            }
+        }
+        return winner;
+    }
+}
+
+Tablebase::Tablebase() : tables{}, max_tricks(0), mapping(nullptr), mapping_size(0)
+{
+    for (int tricks = 1; tricks <= max_supported; tricks++)
+    {
+        Layout &layout = layouts[tricks];
+        layout.composition_index.assign(COMPOSITION_KEYS, -1);
+        const int quota[4] = {tricks, tricks, tricks, tricks};
+        layout.arrangements = multinomial(quota);
+
+        // trump count, then the other suits' counts in descending order
+        for (int c0 = 0; c0 <= MAX_TRUMP; c0++)
+            for (int c1 = MAX_PLAIN; c1 >= 0; c1--)
+                for (int c2 = c1; c2 >= 0; c2--)
+                {
+                    const int c3 = 4 * tricks - c0 - c1 - c2;
+                    if (c3 < 0 || c3 > c2)
+                    {
+                        continue;
+                    }
+                    const int counts[4] = {c0, c1, c2, c3};
+                    layout.composition_index[composition_key(counts)] =
+                        layout.compositions.size();
+                    layout.compositions.push_back({c0, c1, c2, c3});
+                }
+    }
+}
+
+Tablebase::~Tablebase()
+{
+    clear();
+}
+
+void Tablebase::clear()
+{
+    if (mapping)
+    {
+        munmap(mapping, mapping_size);
+        mapping = nullptr;
+        mapping_size = 0;
+    }
+    owned.clear();
+    tables.fill(nullptr);
+    max_tricks = 0;
+}
+
+uint64_t Tablebase::total_size(int max_tricks_in) const
+{
+    uint64_t total = 0;
+    for (int tricks = 1; tricks <= max_tricks_in; tricks++)
+    {
+        total += size(tricks);
+    }
+    return total;
+}
+
+void Tablebase::set_tables(const uint8_t *data, int max_tricks_in)
+{
+    max_tricks = max_tricks_in;
+    for (int tricks = 1; tricks <= max_tricks; tricks++)
+    {
+        tables[tricks] = data;
+        data += size(tricks);
+    }
+}
+
+void Tablebase::build(int max_tricks_in, ThreadPool *pool)
+{
+    assert(1 <= max_tricks_in && max_tricks_in <= max_supported);
+    clear();
+    owned.assign(total_size(max_tricks_in), 0);
+
+    uint8_t *table = owned.data();
+    for (int tricks = 1; tricks <= max_tricks_in; tricks++)
+    {
+        const int count = layouts[tricks].compositions.size();
+        if (pool)
+        {
+            pool->parallel_for(count, [&](int, int composition) {
+                solve_composition(tricks, composition, table);
+            });
+        }
+        else
+        {
+            for (int composition = 0; composition < count; composition++)
+            {
+                solve_composition(tricks, composition, table);
+            }
+        }
+        // the next trick count looks up this one
+        tables[tricks] = table;
+        max_tricks = tricks;
+        table += size(tricks);
+    }
+}
+
+bool Tablebase::write(const std::string &path) const
+{
+    ofstream file(path, ios::binary | ios::trunc);
+    if (!file)
+    {
+        return false;
+    }
+    const uint32_t header[3] = {TABLEBASE_VERSION, uint32_t(max_tricks), 0};
+    file.write(TABLEBASE_MAGIC, sizeof(TABLEBASE_MAGIC));
+    for (uint32_t value : header)
+    {
+        for (int i = 0; i < 4; i++)
+        {
+            file.put(char((value >> (8 * i)) & 0xff));
+        }
+    }
+    for (int tricks = 1; tricks <= max_tricks; tricks++)
+    {
+        file.write(reinterpret_cast<const char *>(tables[tricks]), size(tricks));
+    }
+    return bool(file.flush());
+}
+
+bool Tablebase::open(const std::string &path)
+{
+    clear();
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        return false;
+    }
+    struct stat info;
+    void *data = MAP_FAILED;
+    if (fstat(fd, &info) == 0 && size_t(info.st_size) >= HEADER_SIZE)
+    {
+        data = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    }
+    ::close(fd);
+    if (data == MAP_FAILED)
+    {
+        return false;
+    }
+    mapping = data;
+    mapping_size = info.st_size;
+
+    const unsigned char *bytes = static_cast<const unsigned char *>(data);
+    uint32_t header[3];
+    for (int field = 0; field < 3; field++)
+    {
+        header[field] = 0;
+        for (int i = 0; i < 4; i++)
+        {
+            header[field] |= uint32_t(bytes[4 + 4 * field + i]) << (8 * i);
+        }
+    }
+    const int stored_tricks = header[1];
+    if (!equal(TABLEBASE_MAGIC, TABLEBASE_MAGIC + 4, bytes) || header[0] != TABLEBASE_VERSION ||
+        stored_tricks < 1 || stored_tricks > max_supported ||
+        mapping_size != HEADER_SIZE + total_size(stored_tricks))
+    {
+        clear();
+        return false;
+    }
+    set_tables(bytes + HEADER_SIZE, stored_tricks);
+    return true;
+}
+
+int Tablebase::get_max_tricks() const
+{
+    return max_tricks;
+}
+
+size_t Tablebase::size(int tricks) const
+{
+    const Layout &layout = layouts[tricks];
+    return layout.compositions.size() * layout.arrangements;
+}
+
+int Tablebase::probe(const GameState &state) const
+{
+    assert(state.get_num_played() % GameState::num_players == 0);
+    const int tricks = GameState::num_tricks - state.get_num_played() / GameState::num_players;
+    if (tricks == 0)
+    {
+        return 0;
+    }
+    if (tricks > max_tricks)
+    {
+        return -1;
+    }
+
+    const int leader = state.get_leader();
+    const Suit trump = state.get_trump();
+    Position position;
+    for (int seat = 0; seat < GameState::num_players; seat++)
+    {
+        uint32_t hand = state.get_hand((leader + seat) % GameState::num_players);
+        uint32_t canonical = 0;
+        while (hand)
+        {
+            canonical |= 1u << SLOTS.slot[trump][__builtin_ctz(hand)];
+            hand &= hand - 1;
+        }
+        position.hands[seat] = canonical;
+    }
+    const int leader_side = tables[tricks][index(position, tricks)];
+    return leader % 2 == 0 ? leader_side : tricks - leader_side;
+}
+
+uint64_t Tablebase::index(const Position &position, int tricks) const
+{
+    // owner of each card still out, suit by suit from the top down
+    int counts[4];
+    uint32_t codes[4];
+    int owners[4][SUIT_SLOTS];
+    for (int suit = 0; suit < 4; suit++)
+    {
+        const int shift = suit * SUIT_SLOTS;
+        uint32_t used = 0;
+        for (int seat = 0; seat < 4; seat++)
+        {
+            used |= (position.hands[seat] >> shift) & SUIT_MASK;
+        }
+        counts[suit] = 0;
+        codes[suit] = 0;
+        while (used)
+        {
+            const uint32_t bit = used & -used;
+            int owner = 0;
+            while (!((position.hands[owner] >> shift) & bit))
+            {
+                owner++;
+            }
+            owners[suit][counts[suit]++] = owner;
+            codes[suit] = codes[suit] * 4 + owner;
+            used &= used - 1;
+        }
+    }
+
+    // the three plain suits are interchangeable: sort by count, then
+    // owner sequence
+    int order[4] = {0, 1, 2, 3};
+    for (int i = 2; i < 4; i++)
+    {
+        for (int j = i; j > 1; j--)
+        {
+            const int a = order[j - 1];
+            const int b = order[j];
+            if (counts[a] > counts[b] || (counts[a] == counts[b] && codes[a] <= codes[b]))
+            {
+                break;
+            }
+            swap(order[j - 1], order[j]);
+        }
+    }
+
+    const int sorted_counts[4] = {counts[order[0]], counts[order[1]], counts[order[2]],
+                                  counts[order[3]]};
+    const Layout &layout = layouts[tricks];
+    const int composition = layout.composition_index[composition_key(sorted_counts)];
+    assert(composition >= 0);
+
+    // lexicographic rank of the owner sequence among those with the
+    // same number of cards in each hand
+    uint64_t rank = 0;
+    int quota[4] = {tricks, tricks, tricks, tricks};
+    for (int i = 0; i < 4; i++)
+    {
+        const int suit = order[i];
+        for (int k = 0; k < counts[suit]; k++)
+        {
+            const int owner = owners[suit][k];
+            for (int smaller = 0; smaller < owner; smaller++)
+            {
+                if (quota[smaller] > 0)
+                {
+                    quota[smaller]--;
+                    rank += multinomial(quota);
+                    quota[smaller]++;
+                }
+            }
+            quota[owner]--;
+        }
+    }
+    return composition * layout.arrangements + rank;
+}
+
+int Tablebase::solve(const Position &position, int tricks) const
+{
+    // depth-first over the plays of one trick; seats 0 and 2 maximize
+    struct Search
+    {
+        const Tablebase &tablebase;
+        const int tricks;
+        Position position;
+        int played[4];
+
+        int run(int seat)
+        {
+            const uint32_t hand = position.hands[seat];
+            uint32_t moves = hand;
+            if (seat > 0)
+            {
+                const uint32_t follow = hand & (SUIT_MASK << (played[0] / SUIT_SLOTS * SUIT_SLOTS));
+                moves = follow ? follow : hand;
+            }
+
+            const bool maximize = seat % 2 == 0;
+            int best = maximize ? -1 : tricks + 1;
+            while (moves)
+            {
+                const int card = __builtin_ctz(moves);
+                moves &= moves - 1;
+                played[seat] = card;
+                position.hands[seat] &= ~(1u << card);
+                const int value = seat == 3 ? finish() : run(seat + 1);
+                position.hands[seat] |= 1u << card;
+
+                best = maximize ? max(best, value) : min(best, value);
+                if ((maximize && best == tricks) || (!maximize && best == 0))
+                {
+                    break;
+                }
+            }
+            return best;
+        }
+
+        // EFFECTS: returns the tricks for seat 0's side once the trick is
+        //          complete and the rest is looked up
+        int finish() const
+        {
+            const int winner = trick_winner(played);
+            int rest = 0;
+            if (tricks > 1)
+            {
+                Position next;
+                for (int seat = 0; seat < 4; seat++)
+                {
+                    next.hands[seat] = position.hands[(winner + seat) % 4];
+                }
+                rest = tablebase.tables[tricks - 1][tablebase.index(next, tricks - 1)];
+            }
+            return winner % 2 == 0 ? 1 + rest : tricks - 1 - rest;
+        }
+    };
+
+    Search search{*this, tricks, position, {0, 0, 0, 0}};
+    return search.run(0);
+}
+
+void Tablebase::solve_composition(int tricks, int composition, uint8_t *table) const
+{
+    const Layout &layout = layouts[tricks];
+    const array<int, 4> &counts = layout.compositions[composition];
+
+    // the slots of the cards in this composition, in sequence order
+    vector<int> slots;
+    for (int suit = 0; suit < 4; suit++)
+    {
+        for (int k = 0; k < counts[suit]; k++)
+        {
+            slots.push_back(suit * SUIT_SLOTS + k);
+        }
+    }
+
+    // enumerate owner sequences in lexicographic order, which is the
+    // order of their ranks
+    struct Enumerate
+    {
+        const Tablebase &tablebase;
+        const int tricks;
+        const vector<int> &slots;
+        uint8_t *out;
+        Position position;
+        int quota[4];
+
+        void run(size_t i)
+        {
+            if (i == slots.size())
+            {
+                *out++ = tablebase.solve(position, tricks);
+                return;
+            }
+            for (int owner = 0; owner < 4; owner++)
+            {
+                if (quota[owner] == 0)
+                {
+                    continue;
+                }
+                quota[owner]--;
+                position.hands[owner] |= 1u << slots[i];
+                run(i + 1);
+                position.hands[owner] &= ~(1u << slots[i]);
+                quota[owner]++;
+            }
+        }
+    };
+
+    Enumerate enumerate{*this, tricks, slots, table + composition * layout.arrangements,
+                        {{0, 0, 0, 0}}, {tricks, tricks, tricks, tricks}};
+    enumerate.run(0);
+}
+
+static void print_tablebase_usage()
+{
+    cout << "Usage: euchre.exe --tablebase FILE [TRICKS] [THREADS]" << endl;
+}
+
+int tablebase_main(int argc, char **argv)
+{
+    if (argc < 3 || argc > 5)
+    {
+        print_tablebase_usage();
+        return 1;
+    }
+    const string path = argv[2];
+    const int tricks = argc > 3 ? atoi(argv[3]) : Tablebase::max_supported;
+    const int threads = argc > 4 ? atoi(argv[4]) : 0;
+    if (tricks < 1 || tricks > Tablebase::max_supported || threads < 0)
+    {
+        print_tablebase_usage();
+        return 2;
+    }
+
+    ThreadPool pool(threads == 0 ? default_thread_count() : threads);
+    Tablebase tablebase;
+    tablebase.build(tricks, &pool);
+    if (!tablebase.write(path))
+    {
+        cout << "Error writing tablebase " << path << endl;
+        return 4;
+    }
+    for (int n = 1; n <= tricks; n++)
+    {
+        cout << n << " tricks left: " << tablebase.size(n) << " positions" << endl;
+    }
+    return 0;
+}
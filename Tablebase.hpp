@@ -0,0 +1,120 @@
+#ifndef TABLEBASE_HPP
+#define TABLEBASE_HPP
+/* Tablebase.hpp
+ *
+ * Exact double-dummy results for the last few tricks of a hand.
+ *
+ * Positions are canonicalized before lookup: trump becomes suit 0, the
+ * ranks inside each effective suit are closed up so only their order
+ * among the cards still out remains, the other three suits are sorted,
+ * and seats are rotated so the leader is seat 0.  What is left is a
+ * suit composition plus the owner of each card in rank order, which has
+ * a perfect hash: the composition's offset plus the multinomial rank of
+ * the owner sequence.  Each entry is one byte, the tricks the leader's
+ * side takes with best play.
+ *
+ * Tables are built by retrograde analysis, one trick count at a time:
+ * every position with n tricks left is solved by searching its next
+ * trick and looking up the n - 1 table.
+ */
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "GameState.hpp"
+
+class ThreadPool;
+
+class Tablebase
+{
+public:
+    static const int max_supported = 3;
+
+    // EFFECTS: Creates a tablebase that covers no positions
+    Tablebase();
+
+    ~Tablebase();
+
+    Tablebase(const Tablebase &) = delete;
+    Tablebase & operator=(const Tablebase &) = delete;
+
+    // REQUIRES: 1 <= max_tricks <= max_supported
+    // MODIFIES: *this
+    // EFFECTS: Solves every position with up to max_tricks tricks left,
+    //          using pool's workers if pool is not null
+    void build(int max_tricks, ThreadPool *pool = nullptr);
+
+    // EFFECTS: Writes the tables to path.  Returns false on failure.
+    bool write(const std::string &path) const;
+
+    // MODIFIES: *this
+    // EFFECTS: Maps the tablebase file at path into memory, replacing any
+    //          tables held before.  Returns false if the file is missing
+    //          or malformed, leaving the tablebase empty.
+    bool open(const std::string &path);
+
+    // EFFECTS: returns the most tricks left that positions are stored for,
+    //          or 0 if the tablebase is empty
+    int get_max_tricks() const;
+
+    // REQUIRES: 1 <= tricks <= max_supported
+    // EFFECTS: returns the number of entries in the table for tricks
+    //          tricks left
+    size_t size(int tricks) const;
+
+    // REQUIRES: state is between tricks
+    // EFFECTS: returns the tricks team 0 takes among the tricks left with
+    //          best play by every player, or -1 if more tricks are left
+    //          than the tablebase covers
+    int probe(const GameState &state) const;
+
+private:
+    // Cards in canonical form: suit * 7 + position from the top of the
+    // suit, with trump as suit 0.  Seat 0 leads.
+    struct Position
+    {
+        uint32_t hands[GameState::num_players];
+    };
+
+    struct Layout
+    {
+        std::vector<int> composition_index;  // by composition key, or -1
+        std::vector<std::array<int, 4>> compositions;
+        uint64_t arrangements;               // owner sequences per composition
+    };
+
+    std::array<Layout, max_supported + 1> layouts;
+    std::array<const uint8_t *, max_supported + 1> tables;
+    int max_tricks;
+    std::vector<uint8_t> owned;
+    void *mapping;
+    size_t mapping_size;
+
+    void clear();
+
+    // EFFECTS: returns the bytes taken by the tables up to max_tricks_in
+    uint64_t total_size(int max_tricks_in) const;
+
+    // EFFECTS: points tables at consecutive regions of data
+    void set_tables(const uint8_t *data, int max_tricks_in);
+
+    // REQUIRES: every hand in position holds tricks cards
+    // EFFECTS: returns the perfect hash of the canonical form of position
+    uint64_t index(const Position &position, int tricks) const;
+
+    // REQUIRES: the tables for fewer tricks are built
+    // EFFECTS: returns the tricks the side of seat 0 takes with best play
+    int solve(const Position &position, int tricks) const;
+
+    // EFFECTS: fills table with the solutions for one composition
+    void solve_composition(int tricks, int composition, uint8_t *table) const;
+};
+
+// EFFECTS: Builds a tablebase from command line arguments
+//          FILE [TRICKS] [THREADS] and writes it to FILE.  Returns the
+//          process exit status.
+int tablebase_main(int argc, char **argv);
+
+#endif // TABLEBASE_HPP
@@ -0,0 +1,84 @@
+#include "Tablebase.hpp"
+#include "Solver.hpp"
+#include "Pack.hpp"
+#include "Random.hpp"
+#include "unit_test_framework.hpp"
+
+#include <cstdio>
+
+using namespace std;
+
+// EFFECTS: returns a random hand's state after random legal play until
+//          tricks_left tricks remain
+static GameState random_position(uint64_t seed, int tricks_left) {
+    Random random(seed);
+    Pack pack;
+    pack.shuffle(seed);
+    array<vector<Card>, 4> hands;
+    for (int player = 0; player < 4; player++) {
+        for (int i = 0; i < 5; i++) {
+            hands[player].push_back(pack.deal_one());
+        }
+    }
+    GameState state(hands, Suit(random.below(4)), random.below(2), random.below(4));
+    while (state.get_num_played() < 4 * (5 - tricks_left)) {
+        vector<int> moves;
+        for (uint32_t legal = state.legal_moves(); legal; legal &= legal - 1) {
+            moves.push_back(__builtin_ctz(legal));
+        }
+        state.apply(moves[random.below(moves.size())]);
+    }
+    return state;
+}
+
+TEST(test_tablebase_matches_search) {
+    Tablebase tablebase;
+    tablebase.build(2);
+    ASSERT_EQUAL(tablebase.get_max_tricks(), 2);
+    for (uint64_t seed = 0; seed < 3000; seed++) {
+        for (int tricks_left = 1; tricks_left <= 2; tricks_left++) {
+            GameState state = random_position(seed, tricks_left);
+            Solver solver;
+            const int expected = solver.solve(state) - state.get_tricks(0);
+            ASSERT_EQUAL(tablebase.probe(state), expected);
+        }
+    }
+    ASSERT_EQUAL(tablebase.probe(random_position(1, 3)), -1);
+}
+
+TEST(test_solver_with_tablebase_searches_less) {
+    Tablebase tablebase;
+    tablebase.build(2);
+    long nodes_plain = 0;
+    long nodes_probed = 0;
+    for (uint64_t seed = 0; seed < 200; seed++) {
+        GameState state = random_position(seed, 5);
+        Solver plain;
+        Solver probed(&tablebase);
+        ASSERT_EQUAL(probed.solve(state), plain.solve(state));
+        nodes_plain += plain.get_nodes();
+        nodes_probed += probed.get_nodes();
+    }
+    ASSERT_TRUE(nodes_probed * 4 < nodes_plain);
+}
+
+TEST(test_tablebase_file_round_trip) {
+    Tablebase built;
+    built.build(2);
+    const string path = "Tablebase_tests.bin";
+    ASSERT_TRUE(built.write(path));
+
+    Tablebase mapped;
+    ASSERT_TRUE(mapped.open(path));
+    remove(path.c_str());
+    ASSERT_EQUAL(mapped.get_max_tricks(), 2);
+    for (uint64_t seed = 0; seed < 500; seed++) {
+        GameState state = random_position(seed, 2);
+        ASSERT_EQUAL(mapped.probe(state), built.probe(state));
+    }
+
+    ASSERT_FALSE(mapped.open("no_such_tablebase.bin"));
+    ASSERT_EQUAL(mapped.get_max_tricks(), 0);
+}
+
+TEST_MAIN()
@@ -0,0 +1,237 @@
+#ifndef TASK_HPP
+#define TASK_HPP
+/* Task.hpp
+ *
+ * Minimal C++20 coroutine support: a lazily started Task<T> that can be
+ * awaited by another coroutine, a Scheduler that runs suspended coroutines
+ * on one thread, and a one-shot Decision that a coroutine can wait on until
+ * someone else supplies the value.
+ */
+
+#include <cassert>
+#include <coroutine>
+#include <deque>
+#include <exception>
+#include <optional>
+#include <utility>
+
+template <typename T>
+class Task;
+
+namespace task_detail
+{
+    struct PromiseBase
+    {
+        std::coroutine_handle<> continuation;
+        std::exception_ptr error;
+
+        std::suspend_always initial_suspend() noexcept { return {}; }
+
+        // when the task finishes, resume whoever awaited it
+        struct FinalAwaiter
+        {
+            bool await_ready() noexcept { return false; }
+
+            template <typename Promise>
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) noexcept
+            {
+                std::coroutine_handle<> next = handle.promise().continuation;
+                return next ? next : std::noop_coroutine();
+            }
+
+            void await_resume() noexcept {}
+        };
+
+        FinalAwaiter final_suspend() noexcept { return {}; }
+
+        void unhandled_exception() { error = std::current_exception(); }
+
+        void rethrow()
+        {
+            if (error)
+            {
+                std::rethrow_exception(error);
+            }
+        }
+    };
+
+    template <typename T>
+    struct Promise : PromiseBase
+    {
+        std::optional<T> value;
+
+        Task<T> get_return_object();
+        void return_value(T value_in) { value = std::move(value_in); }
+
+        T take()
+        {
+            rethrow();
+            return std::move(*value);
+        }
+    };
+
+    template <>
+    struct Promise<void> : PromiseBase
+    {
+        Task<void> get_return_object();
+        void return_void() {}
+        void take() { rethrow(); }
+    };
+}
+
+// A coroutine producing a T.  It does not run until it is awaited or
+// started, and it owns its coroutine frame.
+template <typename T>
+class Task
+{
+public:
+    using promise_type = task_detail::Promise<T>;
+    using Handle = std::coroutine_handle<promise_type>;
+
+    explicit Task(Handle handle) : handle(handle) {}
+
+    Task(Task &&other) noexcept : handle(std::exchange(other.handle, {})) {}
+
+    Task & operator=(Task &&other) noexcept
+    {
+        if (this != &other)
+        {
+            destroy();
+            handle = std::exchange(other.handle, {});
+        }
+        return *this;
+    }
+
+    Task(const Task &) = delete;
+    Task & operator=(const Task &) = delete;
+
+    ~Task() { destroy(); }
+
+    // Awaiting a task runs it and resumes the awaiter when it finishes
+    bool await_ready() const noexcept { return false; }
+
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiter) noexcept
+    {
+        handle.promise().continuation = awaiter;
+        return handle;
+    }
+
+    T await_resume() { return handle.promise().take(); }
+
+    // REQUIRES: the task has not been started or awaited
+    // EFFECTS: Runs the task until it first suspends
+    void start() { handle.resume(); }
+
+    // EFFECTS: returns true if the task has finished
+    bool done() const { return handle && handle.done(); }
+
+    // REQUIRES: done()
+    // EFFECTS: returns the task's result, rethrowing any exception
+    T result() { return handle.promise().take(); }
+
+private:
+    Handle handle;
+
+    void destroy()
+    {
+        if (handle)
+        {
+            handle.destroy();
+            handle = {};
+        }
+    }
+};
+
+template <typename T>
+Task<T> task_detail::Promise<T>::get_return_object()
+{
+    return Task<T>(Task<T>::Handle::from_promise(*this));
+}
+
+inline Task<void> task_detail::Promise<void>::get_return_object()
+{
+    return Task<void>(Task<void>::Handle::from_promise(*this));
+}
+
+// Runs ready coroutines one after another on the calling thread
+class Scheduler
+{
+public:
+    // EFFECTS: Queues handle to be resumed by run()
+    void schedule(std::coroutine_handle<> handle) { ready.push_back(handle); }
+
+    // EFFECTS: Resumes queued coroutines until none are ready.  Returns
+    //          the number resumed.
+    long run()
+    {
+        long count = 0;
+        while (!ready.empty())
+        {
+            std::coroutine_handle<> handle = ready.front();
+            ready.pop_front();
+            handle.resume();
+            count++;
+        }
+        return count;
+    }
+
+    // EFFECTS: returns true if no coroutine is ready to run
+    bool idle() const { return ready.empty(); }
+
+    // Awaiter that lets other ready coroutines run before continuing
+    struct Yield
+    {
+        Scheduler &scheduler;
+
+        bool await_ready() const noexcept { return false; }
+        void await_suspend(std::coroutine_handle<> handle) { scheduler.schedule(handle); }
+        void await_resume() const noexcept {}
+    };
+
+    // EFFECTS: returns an awaiter that reschedules the caller
+    Yield yield() { return Yield{*this}; }
+
+private:
+    std::deque<std::coroutine_handle<>> ready;
+};
+
+// A value that one coroutine waits for and another party supplies later
+template <typename T>
+class Decision
+{
+public:
+    explicit Decision(Scheduler &scheduler) : scheduler(scheduler) {}
+
+    // EFFECTS: returns true if a coroutine is waiting for the value
+    bool is_waiting() const { return bool(waiter); }
+
+    // REQUIRES: no value has been supplied since the last await
+    // EFFECTS: Supplies the value and schedules the waiting coroutine, if
+    //          any, on the scheduler
+    void resolve(T value_in)
+    {
+        assert(!value);
+        value = std::move(value_in);
+        if (waiter)
+        {
+            scheduler.schedule(std::exchange(waiter, {}));
+        }
+    }
+
+    bool await_ready() const noexcept { return value.has_value(); }
+    void await_suspend(std::coroutine_handle<> handle) { waiter = handle; }
+
+    T await_resume()
+    {
+        T result = std::move(*value);
+        value.reset();
+        return result;
+    }
+
+private:
+    Scheduler &scheduler;
+    std::optional<T> value;
+    std::coroutine_handle<> waiter;
+};
+
+#endif // TASK_HPP
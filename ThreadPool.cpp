@@ -0,0 +1,89 @@
+#include "ThreadPool.hpp"
+#include <cassert>
+
+ThreadPool::ThreadPool(int num_threads) : running(0), stopping(false)
+{
+    assert(num_threads >= 1);
+    for (int i = 0; i < num_threads; i++)
+    {
+        workers.emplace_back(&ThreadPool::work, this, i);
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    task_ready.notify_all();
+    for (std::thread &worker : workers)
+    {
+        worker.join();
+    }
+}
+
+int ThreadPool::size() const
+{
+    return int(workers.size());
+}
+
+void ThreadPool::submit(Task task)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        tasks.push_back(std::move(task));
+    }
+    task_ready.notify_one();
+}
+
+void ThreadPool::wait()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    all_done.wait(lock, [this] { return tasks.empty() && running == 0; });
+}
+
+void ThreadPool::parallel_for(int count, const std::function<void(int worker, int i)> &body)
+{
+    std::atomic<int> next(0);
+    for (int i = 0; i < size(); i++)
+    {
+        submit([&next, count, &body](int worker) {
+            for (int j = next++; j < count; j = next++)
+            {
+                body(worker, j);
+            }
+        });
+    }
+    wait();
+}
+
+void ThreadPool::work(int worker)
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true)
+    {
+        task_ready.wait(lock, [this] { return stopping || !tasks.empty(); });
+        if (tasks.empty())
+        {
+            return; // stopping and nothing left to do
+        }
+        Task task = std::move(tasks.front());
+        tasks.pop_front();
+        running++;
+        lock.unlock();
+        task(worker);
+        lock.lock();
+        running--;
+        if (tasks.empty() && running == 0)
+        {
+            all_done.notify_all();
+        }
+    }
+}
+
+int default_thread_count()
+{
+    unsigned int count = std::thread::hardware_concurrency();
+    return count == 0 ? 1 : int(count);
+}
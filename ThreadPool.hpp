@@ -0,0 +1,64 @@
+#ifndef THREADPOOL_HPP
+#define THREADPOOL_HPP
+/* ThreadPool.hpp
+ *
+ * A fixed set of worker threads that run submitted tasks.  Each task is
+ * told which worker runs it, so callers can keep per-worker state (such
+ * as a Game or a results accumulator) without locking.
+ */
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class ThreadPool
+{
+public:
+    using Task = std::function<void(int worker)>;
+
+    // REQUIRES: num_threads >= 1
+    // EFFECTS: Starts num_threads worker threads
+    explicit ThreadPool(int num_threads);
+
+    // EFFECTS: Finishes queued tasks and joins the workers
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool & operator=(const ThreadPool &) = delete;
+
+    // EFFECTS: returns the number of worker threads
+    int size() const;
+
+    // EFFECTS: Queues task to run on the next free worker
+    void submit(Task task);
+
+    // EFFECTS: Blocks until every submitted task has finished
+    void wait();
+
+    // EFFECTS: Calls body(worker, i) for every i in [0, count) and waits
+    //          for all calls to finish.  Indices are handed out one at a
+    //          time as workers become free, so a few slow iterations never
+    //          leave the other workers idle while work remains.
+    void parallel_for(int count, const std::function<void(int worker, int i)> &body);
+
+private:
+    std::vector<std::thread> workers;
+    std::deque<Task> tasks;
+    std::mutex mutex;
+    std::condition_variable task_ready;
+    std::condition_variable all_done;
+    int running;
+    bool stopping;
+
+    // EFFECTS: runs tasks on worker number worker until the pool stops
+    void work(int worker);
+};
+
+// EFFECTS: returns the default number of worker threads for this machine
+int default_thread_count();
+
+#endif // THREADPOOL_HPP
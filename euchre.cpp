@@ -1,286 +1,91 @@
 #include <iostream>
 #include <fstream>
 #include <array>
-#include "Player.hpp"
-#include "Pack.hpp"
+#include <cstdlib>
+#include "Game.hpp"
+#include "League.hpp"
+#include "Daemon.hpp"
+#include "Server.hpp"
+#include "Tablebase.hpp"
+#include "Experiment.hpp"
+#include "DealPipeline.hpp"
+#include "Bidding.hpp"
+#include "SelfPlay.hpp"
+#include "CfrTrainer.hpp"
+#include "BestResponse.hpp"
 
-enum Player_Number
-{
-    PLAYER_ZERO = 0,
-    PLAYER_ONE = 1,
-    PLAYER_TWO = 2,
-    PLAYER_THREE = 3,
-};
-
-enum Team_Number
+void print_usage()
 {
-    TEAM_ZERO_AND_TWO = 0,
-    TEAM_ONE_AND_THREE = 1,
-};
+    std::cout << "Usage: euchre.exe PACK_FILENAME [shuffle|noshuffle] "
+              << "POINTS_TO_WIN NAME1 TYPE1 NAME2 TYPE2 NAME3 TYPE3 "
+              << "NAME4 TYPE4 [--checkpoint FILE [--checkpoint-every N]] "
+              << "[--resume FILE]" << std::endl;
+    std::cout << "       euchre.exe --league GAMES_PER_MATCH POINTS_TO_WIN "
+              << "THREADS STRATEGY1 STRATEGY2 ... [--sprt DELTA] [--sprt-alpha ALPHA]"
+              << std::endl;
+    std::cout << "       euchre.exe --daemon [THREADS] [--socket PATH]" << std::endl;
+    std::cout << "       euchre.exe --serve POINTS_TO_WIN [--port N] [--socket PATH]"
+              << std::endl;
+    std::cout << "       euchre.exe --tablebase FILE [TRICKS] [THREADS]" << std::endl;
+    std::cout << "       euchre.exe --experiment CANDIDATE BASELINE DEALS THREADS "
+              << "[--opponent STRATEGY] [--stratify] [--seed N] [--cache FILE]"
+              << std::endl;
+    std::cout << "       euchre.exe --deal-pipeline DEALS PRODUCERS WORKERS [--seed N]"
+              << std::endl;
+    std::cout << "       euchre.exe --bidding DEALS THREADS [--strategy S] [--seed N] [--check]"
+              << std::endl;
+    std::cout << "       euchre.exe --self-play FILE DEALS THREADS "
+              << "[--strategies S1 S2 S3 S4] [--seed N]" << std::endl;
+    std::cout << "       euchre.exe --cfr FILE DEALS THREADS [--seed N]" << std::endl;
+    std::cout << "       euchre.exe --exploitability STRATEGY DEALS THREADS "
+              << "[--worlds N] [--seed N] [--cache FILE]" << std::endl;
+}
 
-class Game
+int main(int argc, char **argv)
 {
-public:
-    static const int num_players = 4;
-    static const int num_teams = 2;
-
-    Game(const std::istream &pack_input, const bool shuffle, const int points_to_win,
-         const std::array<std::string, num_players> names, const std::array<std::string, num_players> strategies)
-        : points_to_win(points_to_win), shuffle_between_hands(shuffle), hand_number(0), dealer(PLAYER_ZERO)
+    if (argc > 1 && std::string(argv[1]) == "--league")
     {
-        points = {0};
-        for (int i = 0; i < num_players; i++)
-        {
-            players[i] = Player_factory(names[i], strategies[i]);
-        }
+        return league_main(argc, argv);
     }
-
-    ~Game()
+    if (argc > 1 && std::string(argv[1]) == "--daemon")
     {
-        for (size_t i = 0; i < players.size(); ++i)
-        {
-            delete players[i];
-        }
+        return daemon_main(argc, argv);
     }
-
-    // EFFECTS: Play hands until one team has points_to_win or more points.
-    void play()
+    if (argc > 1 && std::string(argv[1]) == "--serve")
     {
-        while (points[0] < points_to_win && points[1] < points_to_win)
-        {
-            std::cout << "Hand " << hand_number << std::endl;
-            play_hand();
-            // print scores
-            std::cout << team_names(TEAM_ZERO_AND_TWO) << " have " << points[0] << " points" << std::endl;
-            std::cout << team_names(TEAM_ONE_AND_THREE) << " have " << points[1] << " points" << std::endl;
-            std::cout << std::endl;
-
-            hand_number++;
-            dealer = pass_left(dealer);
-        }
-
-        // A team has won
-        if (points[0] >= points_to_win)
-        {
-            std::cout << team_names(TEAM_ZERO_AND_TWO) << " win!" << std::endl;
-        }
-        else
-        {
-            std::cout << team_names(TEAM_ONE_AND_THREE) << " win!" << std::endl;
-        }
+        return server_main(argc, argv);
     }
-
-private:
-    // variables through entire game
-    std::array<Player *, num_players> players; // players indexed 0,1,2,3
-    std::array<int, num_teams> points;         // points for players 0 and 2 (index 0) and for players 1 and 3 (index 1)
-    Pack pack;
-    const int points_to_win;
-    const bool shuffle_between_hands;
-    const std::array<int, 2 * num_players> dealing_pattern = {3, 2, 3, 2, 2, 3, 2, 3};
-
-    // variables each hand
-    int hand_number;
-    Player_Number dealer;
-
-    // EFFECTS move player 1 to the left
-    Player_Number pass_left(const Player_Number player)
+    if (argc > 1 && std::string(argv[1]) == "--tablebase")
     {
-        return Player_Number((player + 1) % num_players);
+        return tablebase_main(argc, argv);
     }
-
-    // EFFECTS move player 2 to the left (your teammate)
-    Player_Number pass_across(const Player_Number player)
+    if (argc > 1 && std::string(argv[1]) == "--experiment")
     {
-        return Player_Number((player + 2) % num_players);
+        return experiment_main(argc, argv);
     }
-
-    // EFFECTS get team number of a player
-    Team_Number get_team(Player_Number player)
+    if (argc > 1 && std::string(argv[1]) == "--deal-pipeline")
     {
-        return Team_Number(player % 2);
+        return deal_pipeline_main(argc, argv);
     }
-
-    // EFFECTS get the other team
-    Team_Number other_team(Team_Number team)
+    if (argc > 1 && std::string(argv[1]) == "--bidding")
     {
-        return Team_Number((team + 1) % 2);
+        return bidding_main(argc, argv);
     }
-
-    std::string team_names(Team_Number team)
+    if (argc > 1 && std::string(argv[1]) == "--self-play")
     {
-        Player_Number first_teammate = Player_Number(team);
-        Player_Number second_teammate = pass_across(first_teammate);
-        return players[first_teammate]->get_name() + " and " + players[second_teammate]->get_name();
+        return self_play_main(argc, argv);
     }
-
-    // MODIFIES sets the upcard
-    // EFFECTS deal out pack in pattern of dealing_pattern
-    void deal(Card &upcard)
+    if (argc > 1 && std::string(argv[1]) == "--cfr")
     {
-        // print who deals
-        std::cout << *players[dealer] << " deals" << std::endl;
-
-        // start with player left of dealer
-        Player_Number next_player = pass_left(dealer);
-        for (int i = 0; i < dealing_pattern.size(); i++)
-        {
-            // deal dealing_pattern[i] number of cards to next_player
-            for (int j = 0; j < dealing_pattern[i]; j++)
-            {
-                Card next_card = pack.deal_one();
-                players[next_player]->add_card(next_card);
-            }
-            // go to next player
-            next_player = pass_left(next_player);
-        }
-
-        // deal upcard
-        upcard = pack.deal_one();
-        std::cout << upcard << " turned up" << std::endl;
+        return cfr_main(argc, argv);
     }
-
-    void make_trump(const Card upcard, Suit &trump_suit, Team_Number &ordered_up_team)
+    if (argc > 1 && std::string(argv[1]) == "--exploitability")
     {
-        Player_Number next_player = pass_left(dealer);
-
-        // Rounds 1 and 2
-        for (int round = 1; round <= 2; round++)
-        {
-            for (int i = 0; i < num_players; i++)
-            {
-                bool is_dealer = (next_player == dealer);
-                if (players[next_player]->make_trump(upcard, is_dealer, round, trump_suit))
-                {
-                    // trump_suit has been set by player next_player
-                    // that team has ordered up
-                    ordered_up_team = get_team(next_player);
-
-                    // print who ordered up and the suit
-                    std::cout << *players[next_player] << " orders up " << trump_suit << std::endl;
-                    std::cout << std::endl;
-
-                    // if round 1, dealer picks up upcard and discards a card
-                    if(round == 1){
-                        players[dealer]->add_and_discard(upcard);
-                    }
-                    return;
-                }
-                else
-                {
-                    // player passes
-                    std::cout << *players[next_player] << " passes" << std::endl;
-                }
-                // otherwise, keep going around
-                next_player = pass_left(next_player);
-            }
-        }
+        return exploitability_main(argc, argv);
     }
 
-    // MODIFIES Changes leader to the winner of the trick, modifies variable tricks to keep track of current tricks per team
-    // EFFECTS Plays a trick. returns winner of the trick
-    Player_Number play_trick(const Player_Number &leader, const Suit trump_suit, std::array<int, num_teams> &tricks)
-    {
-        // Lead
-        Card led_card = players[leader]->lead_card(trump_suit);
-        std::cout << led_card << " led by " << *players[leader] << std::endl;
-
-        // Highest value card
-        Card highest_value_card = led_card;
-        Player_Number winner_of_the_trick = leader;
-
-        // Rest of the players
-        Player_Number next_player = pass_left(leader);
-        for (int i = 1; i < num_players; i++)
-        {
-
-            // play card and write output
-            Card played_card = players[next_player]->play_card(led_card, trump_suit);
-            std::cout << played_card << " played by " << *players[next_player] << std::endl;
-
-            // keep track of highest value card
-            if (Card_less(highest_value_card, played_card, led_card, trump_suit))
-            {
-                highest_value_card = played_card;
-                winner_of_the_trick = next_player;
-            }
-            next_player = pass_left(next_player);
-        }
-
-        // Scoring the Trick
-        std::cout << *players[winner_of_the_trick] << " takes the trick" << std::endl;
-        std::cout << std::endl;
-
-        Team_Number winning_team = get_team(winner_of_the_trick);
-        tricks[winning_team] += 1;
-
-        return winner_of_the_trick;
-    }
-
-    void play_hand()
-    {
-        Suit trump_suit;
-        std::array<int, num_teams> tricks = {0}; // tricks for players 0 and 2 (index 0) and for players 1 and 3 (index 1)
-        Team_Number ordered_up_team;             // team that ordered up
-        Card upcard;
-
-        // shuffle
-        if (shuffle_between_hands)
-        {
-            pack.shuffle();
-        }
-        pack.reset();
-
-        // deal
-        deal(upcard);
-
-        // make trump
-        make_trump(upcard, trump_suit, ordered_up_team);
-
-        // playing the tricks
-        Player_Number leader = pass_left(dealer);
-        for (int i = 0; i < 5; i++)
-        {
-            // winner of the trick is the next leader
-            leader = play_trick(leader, trump_suit, tricks);
-        }
-
-        // scoring the hand
-        if (tricks[ordered_up_team] >= 3)
-        {
-            // ordered up team wins
-            std::cout << team_names(ordered_up_team) << " win the hand" << std::endl;
-            if (tricks[ordered_up_team] == 5)
-            {
-                std::cout << "march!" << std::endl;
-                points[ordered_up_team] += 2;
-            }
-            else
-            {
-                points[ordered_up_team] += 1;
-            }
-        }
-        else
-        {
-            // non ordered up team wins
-            std::cout << team_names(other_team(ordered_up_team)) << " win the hand" << std::endl;
-            std::cout << "euchred!" << std::endl;
-            points[other_team(ordered_up_team)] += 2;
-        }
-    }
-};
-
-void print_usage()
-{
-    std::cout << "Usage: euchre.exe PACK_FILENAME [shuffle|noshuffle] "
-              << "POINTS_TO_WIN NAME1 TYPE1 NAME2 TYPE2 NAME3 TYPE3 "
-              << "NAME4 TYPE4" << std::endl;
-}
-
-int main(int argc, char **argv)
-{
-    // 12 arguments
-    if (argc != 12)
+    // 12 arguments, plus options
+    if (argc < 12)
     {
         print_usage();
         return 1;
@@ -328,13 +133,49 @@ int main(int argc, char **argv)
     {
         names[i] = argv[4 + 2 * i];
         strategies[i] = argv[5 + 2 * i];
-        if (strategies[i] != "Simple" && strategies[i] != "Human")
+        if (!Player_strategy_exists(strategies[i]))
         {
             print_usage();
             return 5 + i;
         }
     }
 
+    // options
+    std::string checkpoint_path;
+    std::string resume_path;
+    int checkpoint_every = 1;
+    for (int i = 12; i < argc; i += 2)
+    {
+        std::string option = argv[i];
+        if (i + 1 >= argc)
+        {
+            print_usage();
+            return 9;
+        }
+        if (option == "--checkpoint")
+        {
+            checkpoint_path = argv[i + 1];
+        }
+        else if (option == "--checkpoint-every")
+        {
+            checkpoint_every = std::atoi(argv[i + 1]);
+        }
+        else if (option == "--resume")
+        {
+            resume_path = argv[i + 1];
+        }
+        else
+        {
+            print_usage();
+            return 9;
+        }
+    }
+    if (checkpoint_every < 1)
+    {
+        print_usage();
+        return 9;
+    }
+
     // Print executable and arguments
     for (int i = 0; i < argc; i++)
     {
@@ -344,6 +185,19 @@ int main(int argc, char **argv)
 
     // Play Game
     Game game(pack_input, shuffle, points_to_win, names, strategies);
+    if (!resume_path.empty())
+    {
+        Checkpoint checkpoint;
+        if (!read_checkpoint(resume_path, checkpoint) || !game.restore(checkpoint))
+        {
+            std::cout << "Error resuming from " << resume_path << std::endl;
+            return 10;
+        }
+    }
+    if (!checkpoint_path.empty())
+    {
+        game.enable_checkpoints(checkpoint_path, checkpoint_every);
+    }
     game.play();
 }
 